@@ -0,0 +1,266 @@
+//============================================================================
+// Contended post/get throughput benchmark (POSIX port)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+// Usage: bench_crit [<pairs> [<events-per-pair>]]
+//
+// Runs <pairs> independent producer->consumer pairs. Each producer is a
+// plain thread that allocates dynamic events and posts them to its own
+// consumer AO as fast as it can. The pairs use different event pools and
+// each consumer also runs a periodic time event, so the benchmark exercises
+// the event pools, the reference counters, the AO queues and the clock tick
+// concurrently (see NOTE1).
+#include "qpcpp.hpp"        // QP/C++ real-time event framework
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using namespace QP;
+
+//----------------------------------------------------------------------------
+namespace {
+
+enum Signals : QSignal {
+    DATA_SIG = Q_USER_SIG,
+    TIMEOUT_SIG
+};
+
+// events of three sizes, so that the pairs allocate from different pools
+template<std::size_t N>
+struct DataEvt : public QEvt {
+    std::uint32_t seq;
+    std::uint8_t  payload[N];
+};
+using SmallEvt  = DataEvt<4U>;
+using MediumEvt = DataEvt<28U>;
+using LargeEvt  = DataEvt<60U>;
+
+constexpr std::uint_fast8_t MAX_PAIRS {24U};
+constexpr std::uint_fast16_t QUEUE_LEN {64U};
+constexpr std::uint_fast16_t POOL_LEN  {1024U};
+
+std::atomic<std::uint32_t> l_nRecv {0U};
+std::atomic<std::uint32_t> l_nRetry {0U};
+std::uint32_t l_nSeqErr;   // only updated by the consumers' own threads
+
+//............................................................................
+class Consumer : public QActive {
+public:
+    Consumer()
+      : QActive(Q_STATE_CAST(&Consumer::initial)),
+        m_timeEvt(this, TIMEOUT_SIG, 0U),
+        m_seq(0U)
+    {}
+
+private:
+    QTimeEvt m_timeEvt;
+    std::uint32_t m_seq;
+
+    Q_STATE_DECL(initial);
+    Q_STATE_DECL(active);
+};
+
+//............................................................................
+Q_STATE_DEF(Consumer, initial) {
+    Q_UNUSED_PAR(e);
+    m_timeEvt.armX(1U, 1U); // periodic, every clock tick
+    return tran(&active);
+}
+//............................................................................
+Q_STATE_DEF(Consumer, active) {
+    QState status_;
+    switch (e->sig) {
+        case DATA_SIG: {
+            // all DataEvt<> variants have the same layout up to 'seq'
+            std::uint32_t const seq = static_cast<SmallEvt const *>(e)->seq;
+            if (seq != m_seq + 1U) {
+                ++l_nSeqErr;
+            }
+            m_seq = seq;
+            l_nRecv.fetch_add(1U, std::memory_order_relaxed);
+            status_ = Q_RET_HANDLED;
+            break;
+        }
+        case TIMEOUT_SIG: {
+            status_ = Q_RET_HANDLED;
+            break;
+        }
+        default: {
+            status_ = super(&top);
+            break;
+        }
+    }
+    return status_;
+}
+
+Consumer l_consumer[MAX_PAIRS];
+QEvtPtr  l_consumerQSto[MAX_PAIRS][QUEUE_LEN];
+
+QF_MPOOL_EL(SmallEvt)  l_smlPoolSto[POOL_LEN];
+QF_MPOOL_EL(MediumEvt) l_medPoolSto[POOL_LEN];
+QF_MPOOL_EL(LargeEvt)  l_lrgPoolSto[POOL_LEN];
+
+//............................................................................
+template<typename E>
+void produce(Consumer * const ao, std::uint32_t const nEvts) {
+    for (std::uint32_t seq = 1U; seq <= nEvts; ) {
+        // margin 1: allocation returns nullptr instead of asserting
+        E * const e = Q_NEW_X(E, 1U, DATA_SIG);
+        if (e == nullptr) {
+            l_nRetry.fetch_add(1U, std::memory_order_relaxed);
+            std::this_thread::yield();
+            continue;
+        }
+        e->seq = seq;
+        if (ao->POST_X(e, 1U, nullptr)) {
+            ++seq;
+        }
+        else { // queue full, the event has been recycled
+            l_nRetry.fetch_add(1U, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // unnamed namespace
+
+//----------------------------------------------------------------------------
+namespace QP {
+namespace QF {
+
+void onStartup() {
+    setTickRate(1000U, 50); // 1 kHz clock tick
+}
+//............................................................................
+void onCleanup() {
+}
+//............................................................................
+void onClockTick() {
+    QTimeEvt::TICK_X(0U, nullptr);
+}
+
+} // namespace QF
+} // namespace QP
+
+//............................................................................
+extern "C" Q_NORETURN Q_onError(char const * const module, int_t const id) {
+    std::fprintf(stderr, "ERROR in %s:%d\n", module, static_cast<int>(id));
+    std::_Exit(1);
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    std::uint_fast8_t nPairs = 1U;
+    std::uint32_t nEvts = 200000U;
+    if (argc > 1) {
+        nPairs = static_cast<std::uint_fast8_t>(std::atoi(argv[1]));
+    }
+    if (argc > 2) {
+        nEvts = static_cast<std::uint32_t>(std::atol(argv[2]));
+    }
+    if ((nPairs < 1U) || (MAX_PAIRS < nPairs) || (nEvts == 0U)) {
+        std::fprintf(stderr,
+            "usage: %s [<pairs> (1..%u) [<events-per-pair>]]\n",
+            argv[0], static_cast<unsigned>(MAX_PAIRS));
+        return 2;
+    }
+
+    QF::init();
+
+    // event pools must be initialized in ascending order of event size
+    QF::poolInit(l_smlPoolSto, sizeof(l_smlPoolSto), sizeof(l_smlPoolSto[0]));
+    QF::poolInit(l_medPoolSto, sizeof(l_medPoolSto), sizeof(l_medPoolSto[0]));
+    QF::poolInit(l_lrgPoolSto, sizeof(l_lrgPoolSto), sizeof(l_lrgPoolSto[0]));
+
+    for (std::uint_fast8_t n = 0U; n < nPairs; ++n) {
+        l_consumer[n].start(n + 1U,
+            &l_consumerQSto[n][0], QUEUE_LEN,
+            nullptr, 0U);
+    }
+
+    // the producers and the measurement run outside the QF::run() thread
+    std::thread control([nPairs, nEvts]() {
+        std::thread producer[MAX_PAIRS];
+        auto const t0 = std::chrono::steady_clock::now();
+        for (std::uint_fast8_t n = 0U; n < nPairs; ++n) {
+            switch (n % 3U) {
+                case 0U:
+                    producer[n] = std::thread(&produce<SmallEvt>,
+                                              &l_consumer[n], nEvts);
+                    break;
+                case 1U:
+                    producer[n] = std::thread(&produce<MediumEvt>,
+                                              &l_consumer[n], nEvts);
+                    break;
+                default:
+                    producer[n] = std::thread(&produce<LargeEvt>,
+                                              &l_consumer[n], nEvts);
+                    break;
+            }
+        }
+        for (std::uint_fast8_t n = 0U; n < nPairs; ++n) {
+            producer[n].join();
+        }
+        std::uint32_t const nTotal = nPairs * nEvts;
+        while (l_nRecv.load() < nTotal) {
+            std::this_thread::yield();
+        }
+        auto const t1 = std::chrono::steady_clock::now();
+        double const sec = std::chrono::duration<double>(t1 - t0).count();
+
+        std::printf("%-6s pairs=%2u events=%u time=%.3fs "
+                    "throughput=%.3f Mevt/s retries=%u errors=%u\n",
+#ifdef QF_SPLIT_CRIT
+                    "split",
+#else
+                    "single",
+#endif
+                    static_cast<unsigned>(nPairs),
+                    static_cast<unsigned>(nTotal), sec,
+                    (nTotal / sec) * 1e-6,
+                    static_cast<unsigned>(l_nRetry.load()),
+                    static_cast<unsigned>(l_nSeqErr));
+        QF::stop();
+    });
+
+    int const ret = QF::run();
+    control.join();
+    return (l_nSeqErr == 0U) ? ret : 1;
+}
+
+//============================================================================
+// NOTE1:
+// Without QF_SPLIT_CRIT all of these operations serialize on the single
+// QF critical section (QF::critSectMutex_), so adding pairs adds contention
+// rather than throughput. With QF_SPLIT_CRIT each pair uses its own AO
+// queue lock and (for up to three pairs) its own event-pool lock, so the
+// throughput scales with the number of pairs up to the number of CPU cores
+// and the shared pool locks. The time events of all consumers share the
+// tick-rate lock, which is held only during the clock tick processing.
@@ -0,0 +1,46 @@
+//============================================================================
+// QP configuration for the "bench_crit" example (POSIX)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QP_CONFIG_HPP_
+#define QP_CONFIG_HPP_
+
+#define QP_API_VERSION      9999
+#define QF_MAX_ACTIVE       32U
+#define QF_MAX_EPOOL        3U
+#define QF_MAX_TICK_RATE    1U
+#define QF_EVENT_SIZ_SIZE   2U
+#define QF_TIMEEVT_CTR_SIZE 4U
+#define QF_EQUEUE_CTR_SIZE  1U
+#define QF_MPOOL_CTR_SIZE   2U
+#define QF_MPOOL_SIZ_SIZE   2U
+#define QACTIVE_CAN_STOP
+
+// QF_SPLIT_CRIT is defined on the command line by the Makefile
+// (build "split"), so that both variants are built from the same sources
+
+#endif // QP_CONFIG_HPP_
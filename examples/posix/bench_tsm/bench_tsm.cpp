@@ -0,0 +1,849 @@
+//============================================================================
+// State machine dispatch benchmark: QTHsm<> vs. QHsm vs. QMsm (POSIX)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+// Usage: bench_tsm [<rounds> [<events-per-round>]]
+//
+// Implements the same hierarchical state machine (the QHsmTst state diagram
+// from the QP documentation) three times: as a QHsm with state-handler
+// functions, as a QMsm with state and tran. tables built by the qtsm.hpp
+// helpers (QMStateDef<>, QMTran<>), and as a compile-time state machine
+// QTHsm<> from qtsm.hpp. All three are driven with the same pseudo-random
+// event sequence, and the program reports the dispatch time per event for
+// each of them (see NOTE1). The actions only update a checksum of the
+// executed action sequence, which must be identical for all variants.
+#include "qpcpp.hpp"        // QP/C++ real-time event framework
+#include "qtsm.hpp"         // compile-time state machines
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace QP;
+
+//----------------------------------------------------------------------------
+namespace {
+
+enum Signals : QSignal {
+    A_SIG = Q_USER_SIG,
+    B_SIG,
+    C_SIG,
+    D_SIG,
+    E_SIG,
+    F_SIG,
+    G_SIG,
+    H_SIG,
+    I_SIG,
+    MAX_SIG
+};
+
+// identifiers of the actions folded into the checksum
+enum Actions : std::uint32_t {
+    TOP_INIT = 1U,
+    S_ENTRY, S_EXIT, S_INIT, S_E, S_I,
+    S1_ENTRY, S1_EXIT, S1_INIT, S1_A, S1_B, S1_C, S1_D, S1_F, S1_I,
+    S11_ENTRY, S11_EXIT, S11_D, S11_G, S11_H,
+    S2_ENTRY, S2_EXIT, S2_INIT, S2_C, S2_F, S2_I,
+    S21_ENTRY, S21_EXIT, S21_INIT, S21_A, S21_B, S21_G,
+    S211_ENTRY, S211_EXIT, S211_D, S211_H
+};
+
+//............................................................................
+// state shared by all variants: the extended state variable 'foo' and
+// the checksum of the executed actions
+struct Trace {
+    std::uint32_t sum;
+    bool foo;
+
+    void act(std::uint32_t const id) noexcept {
+        sum = (sum * 31U) + id;
+    }
+};
+
+//----------------------------------------------------------------------------
+// variant 1: QHsm (state-handler functions, superstates found at run time)
+class HsmTst : public QHsm, public Trace {
+public:
+    HsmTst()
+      : QHsm(Q_STATE_CAST(&HsmTst::initial)),
+        Trace{0U, false}
+    {}
+
+#ifdef QHSM_TRAN_CACHE
+private:
+    QTranCache::Entry m_cacheSto[16];
+    QTranCache m_cache {&m_cacheSto[0], Q_DIM(m_cacheSto)};
+
+    QTranCache *tranCache() noexcept override {
+        return &m_cache;
+    }
+#endif
+
+private:
+    Q_STATE_DECL(initial);
+    Q_STATE_DECL(s);
+    Q_STATE_DECL(s1);
+    Q_STATE_DECL(s11);
+    Q_STATE_DECL(s2);
+    Q_STATE_DECL(s21);
+    Q_STATE_DECL(s211);
+};
+
+//............................................................................
+Q_STATE_DEF(HsmTst, initial) {
+    Q_UNUSED_PAR(e);
+    foo = false;
+    act(TOP_INIT);
+    return tran(&s2);
+}
+//............................................................................
+Q_STATE_DEF(HsmTst, s) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: { act(S_ENTRY); status_ = Q_RET_HANDLED; break; }
+        case Q_EXIT_SIG:  { act(S_EXIT);  status_ = Q_RET_HANDLED; break; }
+        case Q_INIT_SIG:  { act(S_INIT);  status_ = tran(&s11); break; }
+        case E_SIG: {
+            act(S_E);
+            status_ = tran(&s11);
+            break;
+        }
+        case I_SIG: {
+            if (foo) {
+                foo = false;
+                act(S_I);
+                status_ = Q_RET_HANDLED;
+            }
+            else {
+                status_ = Q_RET_UNHANDLED;
+            }
+            break;
+        }
+        default: {
+            status_ = super(&top);
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(HsmTst, s1) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: { act(S1_ENTRY); status_ = Q_RET_HANDLED; break; }
+        case Q_EXIT_SIG:  { act(S1_EXIT);  status_ = Q_RET_HANDLED; break; }
+        case Q_INIT_SIG:  { act(S1_INIT);  status_ = tran(&s11); break; }
+        case A_SIG: { act(S1_A); status_ = tran(&s1);   break; }
+        case B_SIG: { act(S1_B); status_ = tran(&s11);  break; }
+        case C_SIG: { act(S1_C); status_ = tran(&s2);   break; }
+        case D_SIG: {
+            if (!foo) {
+                foo = true;
+                act(S1_D);
+                status_ = tran(&s);
+            }
+            else {
+                status_ = Q_RET_UNHANDLED;
+            }
+            break;
+        }
+        case F_SIG: { act(S1_F); status_ = tran(&s211); break; }
+        case I_SIG: { act(S1_I); status_ = Q_RET_HANDLED; break; }
+        default: {
+            status_ = super(&s);
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(HsmTst, s11) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: { act(S11_ENTRY); status_ = Q_RET_HANDLED; break; }
+        case Q_EXIT_SIG:  { act(S11_EXIT);  status_ = Q_RET_HANDLED; break; }
+        case D_SIG: {
+            if (foo) {
+                foo = false;
+                act(S11_D);
+                status_ = tran(&s1);
+            }
+            else {
+                status_ = Q_RET_UNHANDLED;
+            }
+            break;
+        }
+        case G_SIG: { act(S11_G); status_ = tran(&s211); break; }
+        case H_SIG: { act(S11_H); status_ = tran(&s);    break; }
+        default: {
+            status_ = super(&s1);
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(HsmTst, s2) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: { act(S2_ENTRY); status_ = Q_RET_HANDLED; break; }
+        case Q_EXIT_SIG:  { act(S2_EXIT);  status_ = Q_RET_HANDLED; break; }
+        case Q_INIT_SIG:  { act(S2_INIT);  status_ = tran(&s211); break; }
+        case C_SIG: { act(S2_C); status_ = tran(&s1);  break; }
+        case F_SIG: { act(S2_F); status_ = tran(&s11); break; }
+        case I_SIG: {
+            if (!foo) {
+                foo = true;
+                act(S2_I);
+                status_ = Q_RET_HANDLED;
+            }
+            else {
+                status_ = Q_RET_UNHANDLED;
+            }
+            break;
+        }
+        default: {
+            status_ = super(&s);
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(HsmTst, s21) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: { act(S21_ENTRY); status_ = Q_RET_HANDLED; break; }
+        case Q_EXIT_SIG:  { act(S21_EXIT);  status_ = Q_RET_HANDLED; break; }
+        case Q_INIT_SIG:  { act(S21_INIT);  status_ = tran(&s211); break; }
+        case A_SIG: { act(S21_A); status_ = tran(&s21);  break; }
+        case B_SIG: { act(S21_B); status_ = tran(&s211); break; }
+        case G_SIG: { act(S21_G); status_ = tran(&s1);   break; }
+        default: {
+            status_ = super(&s2);
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(HsmTst, s211) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: { act(S211_ENTRY); status_ = Q_RET_HANDLED; break; }
+        case Q_EXIT_SIG:  { act(S211_EXIT);  status_ = Q_RET_HANDLED; break; }
+        case D_SIG: { act(S211_D); status_ = tran(&s21); break; }
+        case H_SIG: { act(S211_H); status_ = tran(&s);   break; }
+        default: {
+            status_ = super(&s21);
+            break;
+        }
+    }
+    return status_;
+}
+
+//----------------------------------------------------------------------------
+// variant 2: QMsm (state and tran.-action tables, see NOTE4 in qtsm.hpp)
+class MsmTst : public QMsm, public Trace {
+public:
+    MsmTst()
+      : QMsm(Q_STATE_CAST(&MsmTst::initial)),
+        Trace{0U, false}
+    {}
+
+private:
+    Q_STATE_DECL(initial);
+    Q_STATE_DECL(s);
+    Q_STATE_DECL(s1);
+    Q_STATE_DECL(s11);
+    Q_STATE_DECL(s2);
+    Q_STATE_DECL(s21);
+    Q_STATE_DECL(s211);
+
+    QM_ACTION_DECL(s_e);
+    QM_ACTION_DECL(s_x);
+    QM_ACTION_DECL(s_i);
+    QM_ACTION_DECL(s1_e);
+    QM_ACTION_DECL(s1_x);
+    QM_ACTION_DECL(s1_i);
+    QM_ACTION_DECL(s11_e);
+    QM_ACTION_DECL(s11_x);
+    QM_ACTION_DECL(s2_e);
+    QM_ACTION_DECL(s2_x);
+    QM_ACTION_DECL(s2_i);
+    QM_ACTION_DECL(s21_e);
+    QM_ACTION_DECL(s21_x);
+    QM_ACTION_DECL(s21_i);
+    QM_ACTION_DECL(s211_e);
+    QM_ACTION_DECL(s211_x);
+
+    using Top = QTTop<MsmTst>;
+    struct S    : QMStateDef<Top, &s,    &s_e,    &s_x,    &s_i>   {};
+    struct S1   : QMStateDef<S,   &s1,   &s1_e,   &s1_x,   &s1_i>  {};
+    struct S11  : QMStateDef<S1,  &s11,  &s11_e,  &s11_x>          {};
+    struct S2   : QMStateDef<S,   &s2,   &s2_e,   &s2_x,   &s2_i>  {};
+    struct S21  : QMStateDef<S2,  &s21,  &s21_e,  &s21_x,  &s21_i> {};
+    struct S211 : QMStateDef<S21, &s211, &s211_e, &s211_x>         {};
+};
+
+//............................................................................
+Q_STATE_DEF(MsmTst, initial) {
+    Q_UNUSED_PAR(e);
+    foo = false;
+    act(TOP_INIT);
+    return qm_tran_init(&QMTranInit<Top, S2>::tatbl);
+}
+//............................................................................
+QM_ACTION_DEF(MsmTst, s_e)    { act(S_ENTRY);    return qm_entry(&S::obj); }
+QM_ACTION_DEF(MsmTst, s_x)    { act(S_EXIT);     return qm_exit(&S::obj); }
+QM_ACTION_DEF(MsmTst, s1_e)   { act(S1_ENTRY);   return qm_entry(&S1::obj); }
+QM_ACTION_DEF(MsmTst, s1_x)   { act(S1_EXIT);    return qm_exit(&S1::obj); }
+QM_ACTION_DEF(MsmTst, s11_e)  { act(S11_ENTRY);  return qm_entry(&S11::obj); }
+QM_ACTION_DEF(MsmTst, s11_x)  { act(S11_EXIT);   return qm_exit(&S11::obj); }
+QM_ACTION_DEF(MsmTst, s2_e)   { act(S2_ENTRY);   return qm_entry(&S2::obj); }
+QM_ACTION_DEF(MsmTst, s2_x)   { act(S2_EXIT);    return qm_exit(&S2::obj); }
+QM_ACTION_DEF(MsmTst, s21_e)  { act(S21_ENTRY);  return qm_entry(&S21::obj); }
+QM_ACTION_DEF(MsmTst, s21_x)  { act(S21_EXIT);   return qm_exit(&S21::obj); }
+QM_ACTION_DEF(MsmTst, s211_e) { act(S211_ENTRY); return qm_entry(&S211::obj); }
+QM_ACTION_DEF(MsmTst, s211_x) { act(S211_EXIT);  return qm_exit(&S211::obj); }
+//............................................................................
+QM_ACTION_DEF(MsmTst, s_i) {
+    act(S_INIT);
+    return qm_tran_init(&QMTranInit<S, S11>::tatbl);
+}
+QM_ACTION_DEF(MsmTst, s1_i) {
+    act(S1_INIT);
+    return qm_tran_init(&QMTranInit<S1, S11>::tatbl);
+}
+QM_ACTION_DEF(MsmTst, s2_i) {
+    act(S2_INIT);
+    return qm_tran_init(&QMTranInit<S2, S211>::tatbl);
+}
+QM_ACTION_DEF(MsmTst, s21_i) {
+    act(S21_INIT);
+    return qm_tran_init(&QMTranInit<S21, S211>::tatbl);
+}
+//............................................................................
+Q_STATE_DEF(MsmTst, s) {
+    QState status_;
+    switch (e->sig) {
+        case E_SIG: {
+            act(S_E);
+            status_ = qm_tran(&QMTran<S, S11>::tatbl);
+            break;
+        }
+        case I_SIG: {
+            if (foo) {
+                foo = false;
+                act(S_I);
+                status_ = Q_RET_HANDLED;
+            }
+            else {
+                status_ = Q_RET_UNHANDLED;
+            }
+            break;
+        }
+        default: {
+            status_ = Q_RET_SUPER;
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(MsmTst, s1) {
+    QState status_;
+    switch (e->sig) {
+        case A_SIG: {
+            act(S1_A);
+            status_ = qm_tran(&QMTran<S1, S1>::tatbl);
+            break;
+        }
+        case B_SIG: {
+            act(S1_B);
+            status_ = qm_tran(&QMTran<S1, S11>::tatbl);
+            break;
+        }
+        case C_SIG: {
+            act(S1_C);
+            status_ = qm_tran(&QMTran<S1, S2>::tatbl);
+            break;
+        }
+        case D_SIG: {
+            if (!foo) {
+                foo = true;
+                act(S1_D);
+                status_ = qm_tran(&QMTran<S1, S>::tatbl);
+            }
+            else {
+                status_ = Q_RET_UNHANDLED;
+            }
+            break;
+        }
+        case F_SIG: {
+            act(S1_F);
+            status_ = qm_tran(&QMTran<S1, S211>::tatbl);
+            break;
+        }
+        case I_SIG: {
+            act(S1_I);
+            status_ = Q_RET_HANDLED;
+            break;
+        }
+        default: {
+            status_ = Q_RET_SUPER;
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(MsmTst, s11) {
+    QState status_;
+    switch (e->sig) {
+        case D_SIG: {
+            if (foo) {
+                foo = false;
+                act(S11_D);
+                status_ = qm_tran(&QMTran<S11, S1>::tatbl);
+            }
+            else {
+                status_ = Q_RET_UNHANDLED;
+            }
+            break;
+        }
+        case G_SIG: {
+            act(S11_G);
+            status_ = qm_tran(&QMTran<S11, S211>::tatbl);
+            break;
+        }
+        case H_SIG: {
+            act(S11_H);
+            status_ = qm_tran(&QMTran<S11, S>::tatbl);
+            break;
+        }
+        default: {
+            status_ = Q_RET_SUPER;
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(MsmTst, s2) {
+    QState status_;
+    switch (e->sig) {
+        case C_SIG: {
+            act(S2_C);
+            status_ = qm_tran(&QMTran<S2, S1>::tatbl);
+            break;
+        }
+        case F_SIG: {
+            act(S2_F);
+            status_ = qm_tran(&QMTran<S2, S11>::tatbl);
+            break;
+        }
+        case I_SIG: {
+            if (!foo) {
+                foo = true;
+                act(S2_I);
+                status_ = Q_RET_HANDLED;
+            }
+            else {
+                status_ = Q_RET_UNHANDLED;
+            }
+            break;
+        }
+        default: {
+            status_ = Q_RET_SUPER;
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(MsmTst, s21) {
+    QState status_;
+    switch (e->sig) {
+        case A_SIG: {
+            act(S21_A);
+            status_ = qm_tran(&QMTran<S21, S21>::tatbl);
+            break;
+        }
+        case B_SIG: {
+            act(S21_B);
+            status_ = qm_tran(&QMTran<S21, S211>::tatbl);
+            break;
+        }
+        case G_SIG: {
+            act(S21_G);
+            status_ = qm_tran(&QMTran<S21, S1>::tatbl);
+            break;
+        }
+        default: {
+            status_ = Q_RET_SUPER;
+            break;
+        }
+    }
+    return status_;
+}
+//............................................................................
+Q_STATE_DEF(MsmTst, s211) {
+    QState status_;
+    switch (e->sig) {
+        case D_SIG: {
+            act(S211_D);
+            status_ = qm_tran(&QMTran<S211, S21>::tatbl);
+            break;
+        }
+        case H_SIG: {
+            act(S211_H);
+            status_ = qm_tran(&QMTran<S211, S>::tatbl);
+            break;
+        }
+        default: {
+            status_ = Q_RET_SUPER;
+            break;
+        }
+    }
+    return status_;
+}
+
+//----------------------------------------------------------------------------
+// variant 3: QTHsm<> (compile-time hierarchy, see NOTE1 in qtsm.hpp)
+class TsmTst : public QTHsm<TsmTst>, public Trace {
+public:
+    TsmTst()
+      : QTHsm<TsmTst>(),
+        Trace{0U, false}
+    {}
+
+    struct s;
+    struct s1;
+    struct s11;
+    struct s2;
+    struct s21;
+    struct s211;
+
+    static QState initial(TsmTst &me, void const * const e);
+};
+
+//............................................................................
+struct TsmTst::s : QTState<TsmTst, TsmTst::s> {
+    static QState entry(TsmTst &me) { me.act(S_ENTRY); return Q_HANDLED(); }
+    static QState exit(TsmTst &me)  { me.act(S_EXIT);  return Q_HANDLED(); }
+    static QState init(TsmTst &me) {
+        me.act(S_INIT);
+        return tran_init<s11>(me);
+    }
+    template<class L_>
+    static QState handle(TsmTst &me, QEvt const * const e) {
+        QState status_;
+        switch (e->sig) {
+            case E_SIG: {
+                me.act(S_E);
+                status_ = tran<L_, s11>(me);
+                break;
+            }
+            case I_SIG: {
+                if (me.foo) {
+                    me.foo = false;
+                    me.act(S_I);
+                    status_ = Q_HANDLED();
+                }
+                else {
+                    status_ = Q_UNHANDLED();
+                }
+                break;
+            }
+            default: {
+                status_ = Q_SUPER();
+                break;
+            }
+        }
+        return status_;
+    }
+};
+//............................................................................
+struct TsmTst::s1 : QTState<TsmTst, TsmTst::s1, TsmTst::s> {
+    static QState entry(TsmTst &me) { me.act(S1_ENTRY); return Q_HANDLED(); }
+    static QState exit(TsmTst &me)  { me.act(S1_EXIT);  return Q_HANDLED(); }
+    static QState init(TsmTst &me) {
+        me.act(S1_INIT);
+        return tran_init<s11>(me);
+    }
+    template<class L_>
+    static QState handle(TsmTst &me, QEvt const * const e) {
+        QState status_;
+        switch (e->sig) {
+            case A_SIG: { me.act(S1_A); status_ = tran<L_, s1>(me);   break; }
+            case B_SIG: { me.act(S1_B); status_ = tran<L_, s11>(me);  break; }
+            case C_SIG: { me.act(S1_C); status_ = tran<L_, s2>(me);   break; }
+            case D_SIG: {
+                if (!me.foo) {
+                    me.foo = true;
+                    me.act(S1_D);
+                    status_ = tran<L_, s>(me);
+                }
+                else {
+                    status_ = Q_UNHANDLED();
+                }
+                break;
+            }
+            case F_SIG: { me.act(S1_F); status_ = tran<L_, s211>(me); break; }
+            case I_SIG: { me.act(S1_I); status_ = Q_HANDLED(); break; }
+            default: {
+                status_ = Q_SUPER();
+                break;
+            }
+        }
+        return status_;
+    }
+};
+//............................................................................
+struct TsmTst::s11 : QTState<TsmTst, TsmTst::s11, TsmTst::s1> {
+    static QState entry(TsmTst &me) { me.act(S11_ENTRY); return Q_HANDLED(); }
+    static QState exit(TsmTst &me)  { me.act(S11_EXIT);  return Q_HANDLED(); }
+    template<class L_>
+    static QState handle(TsmTst &me, QEvt const * const e) {
+        QState status_;
+        switch (e->sig) {
+            case D_SIG: {
+                if (me.foo) {
+                    me.foo = false;
+                    me.act(S11_D);
+                    status_ = tran<L_, s1>(me);
+                }
+                else {
+                    status_ = Q_UNHANDLED();
+                }
+                break;
+            }
+            case G_SIG: { me.act(S11_G); status_ = tran<L_, s211>(me); break; }
+            case H_SIG: { me.act(S11_H); status_ = tran<L_, s>(me);    break; }
+            default: {
+                status_ = Q_SUPER();
+                break;
+            }
+        }
+        return status_;
+    }
+};
+//............................................................................
+struct TsmTst::s2 : QTState<TsmTst, TsmTst::s2, TsmTst::s> {
+    static QState entry(TsmTst &me) { me.act(S2_ENTRY); return Q_HANDLED(); }
+    static QState exit(TsmTst &me)  { me.act(S2_EXIT);  return Q_HANDLED(); }
+    static QState init(TsmTst &me) {
+        me.act(S2_INIT);
+        return tran_init<s211>(me);
+    }
+    template<class L_>
+    static QState handle(TsmTst &me, QEvt const * const e) {
+        QState status_;
+        switch (e->sig) {
+            case C_SIG: { me.act(S2_C); status_ = tran<L_, s1>(me);  break; }
+            case F_SIG: { me.act(S2_F); status_ = tran<L_, s11>(me); break; }
+            case I_SIG: {
+                if (!me.foo) {
+                    me.foo = true;
+                    me.act(S2_I);
+                    status_ = Q_HANDLED();
+                }
+                else {
+                    status_ = Q_UNHANDLED();
+                }
+                break;
+            }
+            default: {
+                status_ = Q_SUPER();
+                break;
+            }
+        }
+        return status_;
+    }
+};
+//............................................................................
+struct TsmTst::s21 : QTState<TsmTst, TsmTst::s21, TsmTst::s2> {
+    static QState entry(TsmTst &me) { me.act(S21_ENTRY); return Q_HANDLED(); }
+    static QState exit(TsmTst &me)  { me.act(S21_EXIT);  return Q_HANDLED(); }
+    static QState init(TsmTst &me) {
+        me.act(S21_INIT);
+        return tran_init<s211>(me);
+    }
+    template<class L_>
+    static QState handle(TsmTst &me, QEvt const * const e) {
+        QState status_;
+        switch (e->sig) {
+            case A_SIG: { me.act(S21_A); status_ = tran<L_, s21>(me);  break; }
+            case B_SIG: { me.act(S21_B); status_ = tran<L_, s211>(me); break; }
+            case G_SIG: { me.act(S21_G); status_ = tran<L_, s1>(me);   break; }
+            default: {
+                status_ = Q_SUPER();
+                break;
+            }
+        }
+        return status_;
+    }
+};
+//............................................................................
+struct TsmTst::s211 : QTState<TsmTst, TsmTst::s211, TsmTst::s21> {
+    static QState entry(TsmTst &me) { me.act(S211_ENTRY); return Q_HANDLED(); }
+    static QState exit(TsmTst &me)  { me.act(S211_EXIT);  return Q_HANDLED(); }
+    template<class L_>
+    static QState handle(TsmTst &me, QEvt const * const e) {
+        QState status_;
+        switch (e->sig) {
+            case D_SIG: { me.act(S211_D); status_ = tran<L_, s21>(me); break; }
+            case H_SIG: { me.act(S211_H); status_ = tran<L_, s>(me);   break; }
+            default: {
+                status_ = Q_SUPER();
+                break;
+            }
+        }
+        return status_;
+    }
+};
+//............................................................................
+QState TsmTst::initial(TsmTst &me, void const * const e) {
+    Q_UNUSED_PAR(e);
+    me.foo = false;
+    me.act(TOP_INIT);
+    return tran_init<s2>(me);
+}
+
+//----------------------------------------------------------------------------
+constexpr std::uint32_t MAX_EVTS {65536U};
+
+// immutable events (one per signal) and the pseudo-random event sequence
+QEvt const l_evt[MAX_SIG - A_SIG] = {
+    QEvt(A_SIG), QEvt(B_SIG), QEvt(C_SIG), QEvt(D_SIG), QEvt(E_SIG),
+    QEvt(F_SIG), QEvt(G_SIG), QEvt(H_SIG), QEvt(I_SIG)
+};
+QEvt const *l_seq[MAX_EVTS];
+
+HsmTst l_hsm;
+MsmTst l_msm;
+TsmTst l_tsm;
+
+//............................................................................
+// dispatches the event sequence 'rounds' times through the QAsm interface,
+// just like QF dispatches events to the active objects;
+// returns the best (shortest) time per event in nanoseconds
+double measure(QAsm &sm, std::uint32_t const rounds, std::uint32_t const nEvts)
+{
+    double best = 1e9;
+    for (std::uint32_t r = 0U; r < rounds; ++r) {
+        auto const t0 = std::chrono::steady_clock::now();
+        for (std::uint32_t i = 0U; i < nEvts; ++i) {
+            sm.dispatch(l_seq[i], 0U);
+        }
+        auto const t1 = std::chrono::steady_clock::now();
+        double const ns =
+            std::chrono::duration<double, std::nano>(t1 - t0).count() / nEvts;
+        if (ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+} // unnamed namespace
+
+//----------------------------------------------------------------------------
+namespace QP {
+namespace QF {
+
+void onStartup() {
+}
+//............................................................................
+void onCleanup() {
+}
+//............................................................................
+void onClockTick() {
+}
+
+} // namespace QF
+} // namespace QP
+
+//............................................................................
+extern "C" Q_NORETURN Q_onError(char const * const module, int_t const id) {
+    std::fprintf(stderr, "ERROR in %s:%d\n", module, static_cast<int>(id));
+    std::_Exit(1);
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    std::uint32_t rounds = 50U;
+    std::uint32_t nEvts  = MAX_EVTS;
+    if (argc > 1) {
+        rounds = static_cast<std::uint32_t>(std::atol(argv[1]));
+    }
+    if (argc > 2) {
+        nEvts = static_cast<std::uint32_t>(std::atol(argv[2]));
+    }
+    if ((rounds == 0U) || (nEvts == 0U) || (MAX_EVTS < nEvts)) {
+        std::fprintf(stderr,
+            "usage: %s [<rounds> [<events-per-round> (1..%u)]]\n",
+            argv[0], static_cast<unsigned>(MAX_EVTS));
+        return 2;
+    }
+
+    // the same event sequence for all variants (fixed-seed LCG)
+    std::uint32_t rnd = 12345U;
+    for (std::uint32_t i = 0U; i < nEvts; ++i) {
+        rnd = (rnd * 1664525U) + 1013904223U;
+        l_seq[i] = &l_evt[(rnd >> 16U) % Q_DIM(l_evt)];
+    }
+
+    l_hsm.init(0U);
+    l_msm.init(0U);
+    l_tsm.init(0U);
+
+    double const nsHsm = measure(l_hsm, rounds, nEvts);
+    double const nsMsm = measure(l_msm, rounds, nEvts);
+    double const nsTsm = measure(l_tsm, rounds, nEvts);
+
+#ifdef QHSM_TRAN_CACHE
+    char const * const hsmName = "QHsm+cache";
+#else
+    char const * const hsmName = "QHsm";
+#endif
+    std::printf("%-10s %7.1f ns/evt  sum=%08x\n",
+                hsmName, nsHsm, static_cast<unsigned>(l_hsm.sum));
+    std::printf("%-10s %7.1f ns/evt  sum=%08x\n",
+                "QMsm", nsMsm, static_cast<unsigned>(l_msm.sum));
+    std::printf("%-10s %7.1f ns/evt  sum=%08x\n",
+                "QTHsm<>", nsTsm, static_cast<unsigned>(l_tsm.sum));
+
+    // all variants must have executed exactly the same actions
+    bool const same = (l_hsm.sum == l_msm.sum) && (l_hsm.sum == l_tsm.sum);
+    if (!same) {
+        std::fprintf(stderr, "ERROR: the variants executed different actions\n");
+    }
+    return same ? 0 : 1;
+}
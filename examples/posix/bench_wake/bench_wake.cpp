@@ -0,0 +1,252 @@
+//============================================================================
+// Ping-pong wake-up latency benchmark (POSIX port)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+// Usage: bench_wake [<round-trips>]
+//
+// Two AOs bounce a single static event back and forth. Each AO blocks on
+// its empty queue between the events, so every hop measures the time to
+// post an event to a sleeping AO and to wake up its thread. The program is
+// built twice from the same sources, with the condition variable (default)
+// and with the futex (QACTIVE_EQUEUE_FUTEX) blocking (see NOTE1).
+#include "qpcpp.hpp"        // QP/C++ real-time event framework
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace QP;
+
+//----------------------------------------------------------------------------
+namespace {
+
+enum Signals : QSignal {
+    PING_SIG = Q_USER_SIG,
+    PONG_SIG
+};
+
+constexpr std::uint32_t MAX_ROUNDS  {1000000U};
+constexpr std::uint32_t WARMUP      {1000U};  // round-trips not measured
+constexpr std::uint_fast16_t QUEUE_LEN {4U};
+
+using Clock = std::chrono::steady_clock;
+
+QEvt const l_pingEvt(PING_SIG);
+QEvt const l_pongEvt(PONG_SIG);
+
+std::uint32_t l_nRounds;
+std::atomic<bool> l_done {false};
+std::uint32_t l_sample[MAX_ROUNDS]; // round-trip times [ns]
+
+//............................................................................
+class Pong : public QActive {
+public:
+    Pong()
+      : QActive(Q_STATE_CAST(&Pong::initial))
+    {}
+
+private:
+    Q_STATE_DECL(initial);
+    Q_STATE_DECL(active);
+};
+
+//............................................................................
+class Ping : public QActive {
+public:
+    Ping()
+      : QActive(Q_STATE_CAST(&Ping::initial)),
+        m_n(0U)
+    {}
+
+private:
+    Clock::time_point m_t0;
+    std::uint32_t m_n;
+
+    void serve();
+
+    Q_STATE_DECL(initial);
+    Q_STATE_DECL(active);
+};
+
+Ping l_ping;
+Pong l_pong;
+
+//............................................................................
+Q_STATE_DEF(Pong, initial) {
+    Q_UNUSED_PAR(e);
+    return tran(&active);
+}
+//............................................................................
+Q_STATE_DEF(Pong, active) {
+    QState status_;
+    switch (e->sig) {
+        case PING_SIG: {
+            l_ping.POST(&l_pongEvt, this);
+            status_ = Q_RET_HANDLED;
+            break;
+        }
+        default: {
+            status_ = super(&top);
+            break;
+        }
+    }
+    return status_;
+}
+
+//............................................................................
+void Ping::serve() {
+    m_t0 = Clock::now();
+    l_pong.POST(&l_pingEvt, this);
+}
+//............................................................................
+Q_STATE_DEF(Ping, initial) {
+    Q_UNUSED_PAR(e);
+    serve(); // the first ping
+    return tran(&active);
+}
+//............................................................................
+Q_STATE_DEF(Ping, active) {
+    QState status_;
+    switch (e->sig) {
+        case PONG_SIG: {
+            auto const dt = std::chrono::duration_cast<
+                std::chrono::nanoseconds>(Clock::now() - m_t0).count();
+            if (m_n >= WARMUP) {
+                l_sample[m_n - WARMUP] = static_cast<std::uint32_t>(dt);
+            }
+            ++m_n;
+            if (m_n < (WARMUP + l_nRounds)) {
+                serve();
+            }
+            else {
+                l_done.store(true);
+            }
+            status_ = Q_RET_HANDLED;
+            break;
+        }
+        default: {
+            status_ = super(&top);
+            break;
+        }
+    }
+    return status_;
+}
+
+QEvtPtr l_pingQSto[QUEUE_LEN];
+QEvtPtr l_pongQSto[QUEUE_LEN];
+
+} // unnamed namespace
+
+//----------------------------------------------------------------------------
+namespace QP {
+namespace QF {
+
+void onStartup() {
+    setTickRate(100U, 50); // the clock tick only stops QF, see NOTE2
+}
+//............................................................................
+void onCleanup() {
+}
+//............................................................................
+void onClockTick() {
+    QTimeEvt::TICK_X(0U, nullptr);
+    if (l_done.load()) { // all round-trips done?
+        stop(); // called from the QF::run() loop, see NOTE2
+    }
+}
+
+} // namespace QF
+} // namespace QP
+
+//............................................................................
+extern "C" Q_NORETURN Q_onError(char const * const module, int_t const id) {
+    std::fprintf(stderr, "ERROR in %s:%d\n", module, static_cast<int>(id));
+    std::_Exit(1);
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    l_nRounds = 100000U;
+    if (argc > 1) {
+        l_nRounds = static_cast<std::uint32_t>(std::atol(argv[1]));
+    }
+    if ((l_nRounds == 0U) || (MAX_ROUNDS < l_nRounds)) {
+        std::fprintf(stderr, "usage: %s [<round-trips> (1..%u)]\n",
+            argv[0], static_cast<unsigned>(MAX_ROUNDS));
+        return 2;
+    }
+
+    QF::init();
+
+    l_pong.start(1U, &l_pongQSto[0], QUEUE_LEN, nullptr, 0U);
+    l_ping.start(2U, &l_pingQSto[0], QUEUE_LEN, nullptr, 0U);
+
+    int const ret = QF::run(); // returns after QF::stop(), see NOTE2
+
+    std::sort(&l_sample[0], &l_sample[l_nRounds]);
+    auto const pct = [](unsigned const p) {
+        return l_sample[(static_cast<std::uint64_t>(l_nRounds - 1U) * p)
+                        / 100U] / 1000.0;
+    };
+    std::printf("%-7s round-trips=%u round-trip [us]: "
+                "min=%.2f med=%.2f p99=%.2f max=%.2f\n",
+#ifdef QACTIVE_EQUEUE_FUTEX
+                "futex",
+#else
+                "condvar",
+#endif
+                static_cast<unsigned>(l_nRounds),
+                l_sample[0] / 1000.0, pct(50U), pct(99U),
+                l_sample[l_nRounds - 1U] / 1000.0);
+    return ret;
+}
+
+//============================================================================
+// NOTE1:
+// A round-trip consists of two wake-ups of a blocked AO thread, so half of
+// it approximates the wake-up latency of the queue blocking (see NOTE7 in
+// ports/posix/qp_port.hpp). With the condition variable the poster signals
+// pthread_cond_t under the queue lock and the woken thread must reacquire
+// that lock, while with QACTIVE_EQUEUE_FUTEX the poster issues FUTEX_WAKE
+// only when the AO is actually sleeping and after releasing the lock. On a
+// multi-core host the two AOs should be pinned to different cores (e.g.,
+// "taskset -c 0,1") to measure the cross-core wake-up; on a single core the
+// round-trip is dominated by the context switches.
+//
+// NOTE2:
+// The AO threads may run at a real-time priority (see NOTE04 in
+// ports/posix/qf_port.cpp) and finish all the round-trips before the main
+// thread gets to run again. QF::stop() called that early (e.g., from the
+// last AO or from another thread woken by it) can precede QF::run()
+// setting its running flag and would then be lost. The last AO therefore
+// only sets l_done and QF::onClockTick(), which runs inside the QF::run()
+// loop, calls QF::stop(). This adds up to one clock tick (10 ms) at the
+// end, outside the measurement, and needs no extra thread competing with
+// the AO threads for the CPU.
+//
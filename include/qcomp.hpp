@@ -0,0 +1,196 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QCOMP_HPP_
+#define QCOMP_HPP_
+
+#include <array>       // std::array<>
+#include <tuple>       // std::tuple<>, std::get<>()
+#include <type_traits> // std::conditional<>, std::enable_if<>
+#include <utility>     // std::index_sequence<>, std::forward()
+
+// NOTE: this header must be included after "qpcpp.hpp"
+
+namespace QP {
+
+//----------------------------------------------------------------------------
+// orthogonal components Comps_ (QHsm/QMsm subclasses) stored inline and
+// receiving only the subscribed signals below MaxSig_, see NOTE1
+template<QSignal MaxSig_, class... Comps_>
+class QComponents {
+public:
+    static constexpr std::size_t N {sizeof...(Comps_)};
+
+    static_assert((0U < N) && (N <= 32U),
+        "the number of components must be 1..32");
+
+    // bitmask of components (bit I_ for the component I_)
+    using Mask = typename std::conditional<(N <= 8U), std::uint8_t,
+        typename std::conditional<(N <= 16U), std::uint16_t,
+            std::uint32_t>::type>::type;
+
+private:
+    // is Args_ a single QComponents (copy/move, not the component args)?
+    template<typename... Args_>
+    struct IsSelf_ : std::false_type {};
+    template<typename Arg_>
+    struct IsSelf_<Arg_> : std::is_same<
+        typename std::decay<Arg_>::type, QComponents> {};
+
+public:
+    QComponents()
+      : m_comps(),
+        m_subs()
+    {}
+
+    // the components are constructed from the arguments (one per component)
+    // NOTE: a single QComponents argument selects the copy/move ctor instead
+    template<typename... Args_, typename = typename std::enable_if<
+        (sizeof...(Args_) == N) && (!IsSelf_<Args_...>::value)>::type>
+    explicit QComponents(Args_ &&... args)
+      : m_comps(std::forward<Args_>(args)...),
+        m_subs()
+    {}
+
+    template<std::size_t I_>
+    typename std::tuple_element<I_, std::tuple<Comps_...>>::type &
+    get() noexcept {
+        return std::get<I_>(m_comps);
+    }
+
+    // component I_ will receive the events with the signal sig
+    template<std::size_t I_>
+    void subscribe(QSignal const sig) noexcept {
+        static_assert(I_ < N, "component index out of range");
+        checkSig_(sig);
+        m_subs[sig] |= static_cast<Mask>(1U << I_);
+    }
+
+    // component I_ will no longer receive the events with the signal sig
+    template<std::size_t I_>
+    void unsubscribe(QSignal const sig) noexcept {
+        static_assert(I_ < N, "component index out of range");
+        checkSig_(sig);
+        m_subs[sig] &= static_cast<Mask>(~(1U << I_));
+    }
+
+    // components subscribed to the signal sig
+    Mask subscribers(QSignal const sig) const noexcept {
+        return (sig < MaxSig_) ? m_subs[sig] : static_cast<Mask>(0U);
+    }
+
+    // take the top-most initial tran. in all components
+    void init(
+        void const * const e,
+        std::uint_fast8_t const qsId)
+    {
+        init_(e, qsId, std::index_sequence_for<Comps_...>{});
+    }
+
+    // dispatch e to the components subscribed to e->sig (in index order)
+    void dispatch(
+        QEvt const * const e,
+        std::uint_fast8_t const qsId)
+    {
+        Mask const subs = subscribers(e->sig);
+        if (subs != 0U) { // any subscribers?
+            dispatch_(subs, e, qsId, std::index_sequence_for<Comps_...>{});
+        }
+    }
+
+private:
+    template<std::size_t... I_>
+    void init_(
+        void const * const e,
+        std::uint_fast8_t const qsId,
+        std::index_sequence<I_...>)
+    {
+        // static binding of Comps_::init(), see NOTE2
+        (std::get<I_>(m_comps).Comps_::init(e, qsId), ...);
+    }
+
+    template<std::size_t... I_>
+    void dispatch_(
+        Mask const subs,
+        QEvt const * const e,
+        std::uint_fast8_t const qsId,
+        std::index_sequence<I_...>)
+    {
+        // static binding of Comps_::dispatch(), see NOTE2
+        ((((subs & static_cast<Mask>(1U << I_)) != 0U)
+          ? std::get<I_>(m_comps).Comps_::dispatch(e, qsId)
+          : static_cast<void>(0)), ...);
+    }
+
+    static void checkSig_(QSignal const sig) noexcept {
+#ifndef Q_UNSAFE
+        if (sig >= MaxSig_) { // signal out of range?
+            QF_CRIT_EST();
+            Q_onError("qcomp", 100);
+        }
+#else
+        Q_UNUSED_PAR(sig);
+#endif
+    }
+
+    std::tuple<Comps_...> m_comps;     // the components (inline)
+    std::array<Mask, MaxSig_> m_subs;  // subscribed components by signal
+}; // class QComponents
+
+} // namespace QP
+
+//============================================================================
+// NOTE1:
+// An active object (or a QHsm) embedding orthogonal components holds them
+// in a QComponents<> member and forwards the events from its own state
+// handlers, e.g.:
+//
+//     QP::QComponents<MAX_SIG, Alarm, Clock> m_comps;
+//     ...
+//     m_comps.subscribe<0>(TICK_SIG); // Alarm
+//     m_comps.subscribe<1>(TICK_SIG); // Clock
+//     m_comps.subscribe<1>(SET_SIG);  // Clock only
+//     m_comps.init(nullptr, m_prio);
+//     ...
+//     case TICK_SIG: // fall-through
+//     case SET_SIG: {
+//         m_comps.dispatch(e, m_prio);
+//         return Q_HANDLED();
+//     }
+//
+// A single look-up of the per-signal bitmask selects the components that
+// receive the event; the other components are skipped without calling
+// them. The events with signals at or above MaxSig_ have no subscribers.
+//
+// NOTE2:
+// The calls to Comps_::init() and Comps_::dispatch() are qualified with the
+// static type of each component, so they are bound statically (without the
+// vtable) and can be inlined.
+//
+
+#endif // QCOMP_HPP_
@@ -0,0 +1,435 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QCORO_HPP_
+#define QCORO_HPP_
+
+#if !defined(__cpp_impl_coroutine) || (__cpp_impl_coroutine < 201902L)
+    #error "qcoro.hpp requires a C++20 compiler with coroutine support"
+#endif
+
+#include <coroutine>   // std::coroutine_handle<>, std::suspend_always
+#include <cstddef>     // std::max_align_t
+#include <type_traits> // std::is_invocable_r_v<>
+#include <utility>     // std::exchange()
+
+// NOTE: this header must be included after "qpcpp.hpp"
+
+namespace QP {
+
+class QCoActive; // forward declaration
+
+//----------------------------------------------------------------------------
+// coroutine of a QCoActive (the body or a sub-procedure), see NOTE1
+class QCoTask {
+public:
+    class promise_type {
+    public:
+        QCoTask get_return_object() noexcept {
+            return QCoTask(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept {
+            return {}; // started by QCoActive or by the awaiting coroutine
+        }
+        auto final_suspend() noexcept {
+            struct Final {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<promise_type> h) noexcept
+                {
+                    // continue the awaiting coroutine (if any)
+                    std::coroutine_handle<> const cont = h.promise().m_cont;
+                    return (cont != nullptr)
+                           ? cont : std::noop_coroutine();
+                }
+                void await_resume() noexcept {}
+            };
+            return Final{};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            QF_CRIT_EST();
+            Q_onError("qcoro", 100); // exceptions are not supported
+        }
+
+        // the coroutine frames are allocated from the frame pool of the
+        // QCoActive, which the coroutine (a member function) belongs to.
+        // The parameters of the coroutine bind to the Arg slots by
+        // reference and are ignored (see NOTE3).
+        struct Arg {
+            Arg() noexcept {}
+            template<typename T_>
+            Arg(T_ &&arg) noexcept { static_cast<void>(arg); }
+        };
+        static void *operator new(std::size_t const size,
+            QCoActive &act,
+            Arg = {}, Arg = {}, Arg = {}, Arg = {},
+            Arg = {}, Arg = {}, Arg = {}, Arg = {});
+        static void operator delete(void * const frame,
+            std::size_t const size) noexcept;
+        static void operator delete(void * const frame,
+            QCoActive &act,
+            Arg, Arg, Arg, Arg, Arg, Arg, Arg, Arg) noexcept;
+
+    private:
+        std::coroutine_handle<> m_cont; // the awaiting coroutine
+        friend class QCoTask;
+    }; // class promise_type
+
+    QCoTask(QCoTask &&other) noexcept
+      : m_coro(std::exchange(other.m_coro, nullptr))
+    {}
+    QCoTask &operator=(QCoTask &&other) noexcept {
+        if (this != &other) {
+            destroy_();
+            m_coro = std::exchange(other.m_coro, nullptr);
+        }
+        return *this;
+    }
+    QCoTask(QCoTask const &) = delete;
+    QCoTask &operator=(QCoTask const &) = delete;
+    ~QCoTask() noexcept {
+        destroy_();
+    }
+
+    bool isDone() const noexcept {
+        return (m_coro == nullptr) || m_coro.done();
+    }
+
+    // co_await on a sub-procedure (runs it until it returns)
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> m_coro;
+            bool await_ready() noexcept { return m_coro.done(); }
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> const cont) noexcept
+            {
+                m_coro.promise().m_cont = cont;
+                return m_coro; // start the sub-procedure
+            }
+            void await_resume() noexcept {}
+        };
+        return Awaiter{m_coro};
+    }
+
+private:
+    QCoTask() noexcept
+      : m_coro(nullptr)
+    {}
+    explicit QCoTask(std::coroutine_handle<promise_type> const coro) noexcept
+      : m_coro(coro)
+    {}
+    void destroy_() noexcept {
+        if (m_coro != nullptr) {
+            m_coro.destroy();
+            m_coro = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> m_coro;
+
+    // friends...
+    friend class QCoActive;
+}; // class QCoTask
+
+//----------------------------------------------------------------------------
+// active object with the behavior written as a coroutine, see NOTE1
+class QCoActive : public QActive {
+public:
+    // frame pool (blocks >= the largest coroutine frame + header)
+    QMPool * getFramePool() const noexcept {
+        return m_framePool;
+    }
+
+protected:
+    QCoActive(
+        QMPool * const framePool,
+        QSignal const timeoutSig,
+        std::uint_fast8_t const tickRate = 0U) noexcept
+      : QActive(Q_STATE_CAST(&initial)),
+        m_framePool(framePool),
+        m_timeEvt(this, timeoutSig, tickRate),
+        m_task(),
+        m_waiting(),
+        m_evt(nullptr),
+        m_pred(nullptr),
+        m_predObj(nullptr),
+        m_armed(false),
+        m_stale(0U)
+    {}
+
+    // the behavior of the AO (started in the top-most initial tran.)
+    virtual QCoTask run() = 0;
+
+    // awaitable of the next event satisfying the predicate pred(e)
+    // (nTicks > 0: timeout, which resumes the coroutine with nullptr)
+    template<typename Pred_>
+    class Receive {
+    public:
+        Receive(QCoActive &act, Pred_ pred,
+                std::uint32_t const nTicks) noexcept
+          : m_act(act), m_pred(pred), m_nTicks(nTicks)
+        {}
+        bool await_ready() noexcept {
+            if constexpr (std::is_same_v<Pred_, Never>) {
+                if (m_nTicks == 0U) { // delay(0) completes immediately
+                    m_act.m_evt = nullptr; // as if it timed out
+                    return true;
+                }
+            }
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<> const h) noexcept {
+            m_act.wait_(h, &test_, &m_pred, m_nTicks);
+        }
+        QEvt const *await_resume() noexcept {
+            return m_act.m_evt; // valid only until the next co_await
+        }
+    private:
+        static bool test_(void const * const pred, QEvt const * const e) {
+            return (*static_cast<Pred_ const *>(pred))(e);
+        }
+        QCoActive &m_act;
+        Pred_ m_pred;
+        std::uint32_t m_nTicks;
+    }; // class Receive
+
+    template<typename Pred_>
+        requires std::is_invocable_r_v<bool, Pred_ const &, QEvt const *>
+    Receive<Pred_> receive(Pred_ pred,
+        std::uint32_t const nTicks = 0U) noexcept
+    {
+        return Receive<Pred_>(*this, pred, nTicks);
+    }
+
+    // awaitable of the next event with the signal sig
+    struct SigIs {
+        QSignal sig;
+        bool operator()(QEvt const * const e) const noexcept {
+            return e->sig == sig;
+        }
+    };
+    Receive<SigIs> receive(QSignal const sig,
+        std::uint32_t const nTicks = 0U) noexcept
+    {
+        return Receive<SigIs>(*this, SigIs{sig}, nTicks);
+    }
+
+    // awaitable of a time delay (all events are discarded meanwhile)
+    struct Never {
+        bool operator()(QEvt const * const e) const noexcept {
+            static_cast<void>(e);
+            return false;
+        }
+    };
+    Receive<Never> delay(std::uint32_t const nTicks) noexcept {
+        return Receive<Never>(*this, Never{}, nTicks);
+    }
+
+private:
+    using Test = bool (*)(void const * const pred, QEvt const * const e);
+
+    void wait_(std::coroutine_handle<> const h, Test const test,
+               void const * const pred, std::uint32_t const nTicks) noexcept
+    {
+        m_waiting = h;
+        m_pred    = test;
+        m_predObj = pred;
+        if (nTicks != 0U) { // timeout requested?
+            m_timeEvt.armX(nTicks, 0U);
+            m_armed = true;
+        }
+    }
+
+    void resume_(QEvt const * const e) {
+        if (m_armed) { // timeout still armed?
+            if (!m_timeEvt.disarm()) { // timeout event already posted?
+                ++m_stale; // discard it when it arrives
+            }
+            m_armed = false;
+        }
+        m_evt = e;
+        std::exchange(m_waiting, nullptr).resume(); // until next co_await
+    }
+
+    Q_STATE_DECL(initial);
+    Q_STATE_DECL(active);
+
+    QMPool *m_framePool;        // pool of the coroutine frames
+    QTimeEvt m_timeEvt;         // timeouts of receive() and delay()
+    QCoTask m_task;             // the body of the AO (run())
+    std::coroutine_handle<> m_waiting; // coroutine waiting for an event
+    QEvt const *m_evt;          // the event resuming the coroutine
+    Test m_pred;                // predicate of the awaited events
+    void const *m_predObj;      // the predicate object (in the frame)
+    bool m_armed;               // is the timeout armed?
+    std::uint8_t m_stale;       // # stale timeout events still expected
+}; // class QCoActive
+
+//............................................................................
+inline QState QCoActive::initial(void * const me, QEvt const * const e) {
+    return static_cast<QCoActive *>(me)->initial_h(e);
+}
+inline QState QCoActive::initial_h(QEvt const * const e) {
+    static_cast<void>(e); // unused parameter
+    m_task = run();
+    m_task.m_coro.resume(); // run the coroutine until the first co_await
+    return tran(&active);
+}
+//............................................................................
+inline QState QCoActive::active(void * const me, QEvt const * const e) {
+    return static_cast<QCoActive *>(me)->active_h(e);
+}
+inline QState QCoActive::active_h(QEvt const * const e) {
+    QState status_;
+    if (e->sig < Q_USER_SIG) { // reserved signal?
+        status_ = super(&top);
+    }
+    else if (e->sig == m_timeEvt.sig) { // timeout?
+        if (m_stale != 0U) { // stale timeout event (disarmed too late)?
+            --m_stale;
+        }
+        else if (m_armed && (m_waiting != nullptr)) {
+            m_armed = false; // the timeout event is no longer armed
+            resume_(nullptr);
+        }
+        else {
+            // empty
+        }
+        status_ = Q_HANDLED();
+    }
+    else if ((m_waiting != nullptr) && (*m_pred)(m_predObj, e)) {
+        resume_(e);
+        status_ = Q_HANDLED();
+    }
+    else { // no coroutine waiting for this event
+        status_ = Q_HANDLED(); // discard the event, see NOTE2
+    }
+    return status_;
+}
+
+//............................................................................
+inline void *QCoTask::promise_type::operator new(std::size_t const size,
+    QCoActive &act, Arg, Arg, Arg, Arg, Arg, Arg, Arg, Arg)
+{
+    // the frame is preceded by the header holding the frame pool
+    constexpr std::size_t HDR {alignof(std::max_align_t)};
+    QMPool * const pool = act.getFramePool();
+
+#ifndef Q_UNSAFE
+    // the frame pool must be provided and must fit the coroutine frame
+    if ((pool == nullptr) || ((HDR + size) > pool->getBlockSize())) {
+        QF_CRIT_EST();
+        Q_onError("qcoro", 200);
+    }
+#else
+    Q_UNUSED_PAR(size);
+#endif
+    std::uint8_t * const block = static_cast<std::uint8_t *>(
+        pool->get(0U, act.getPrio()));
+#ifndef Q_UNSAFE
+    if (block == nullptr) { // frame pool depleted?
+        QF_CRIT_EST();
+        Q_onError("qcoro", 210);
+    }
+#endif
+    *reinterpret_cast<QMPool **>(block) = pool;
+    return &block[HDR];
+}
+//............................................................................
+inline void QCoTask::promise_type::operator delete(void * const frame,
+    std::size_t const size) noexcept
+{
+    static_cast<void>(size); // unused parameter
+    constexpr std::size_t HDR {alignof(std::max_align_t)};
+    std::uint8_t * const block = static_cast<std::uint8_t *>(frame) - HDR;
+    (*reinterpret_cast<QMPool **>(block))->put(block, 0U);
+}
+//............................................................................
+inline void QCoTask::promise_type::operator delete(void * const frame,
+    QCoActive &act, Arg, Arg, Arg, Arg, Arg, Arg, Arg, Arg) noexcept
+{
+    static_cast<void>(act); // unused parameter
+    operator delete(frame, 0U);
+}
+
+} // namespace QP
+
+//============================================================================
+// NOTE1:
+// QCoActive is an ordinary QActive (started, posted to, and scheduled by
+// any QP kernel or port), whose behavior is the coroutine run() instead of
+// a state machine, e.g.:
+//
+//     class Client : public QP::QCoActive {
+//         QP::QCoTask run() override {
+//             for (;;) {
+//                 co_await receive(REQUEST_SIG);
+//                 for (int retry = 0; retry < 3; ++retry) {
+//                     send();
+//                     QP::QEvt const *e = co_await receive(REPLY_SIG, 100U);
+//                     if (e != nullptr) { ... break; } // nullptr: timeout
+//                 }
+//             }
+//         }
+//     };
+//
+// The coroutine starts in the top-most initial transition and runs to the
+// first co_await. Every event dispatched to the AO that satisfies the
+// predicate of the pending co_await resumes the coroutine, which then runs
+// to the next co_await, so every event is still processed to completion
+// (RTC) inside QActive::dispatch(). The awaited event is valid only until
+// the next co_await (as in a state handler). The timeouts are implemented
+// with the single time event of the AO, which posts timeoutSig.
+//
+// The coroutines (run() and any sub-procedures, which are also QCoTask
+// member functions of the AO, awaited as co_await step(...)) allocate their
+// frames from the QMPool provided to QCoActive, whose block size must
+// accommodate the largest frame plus alignof(std::max_align_t) bytes. The
+// coroutine frames never come from the heap; a non-member coroutine does
+// not compile, because the allocation needs the QCoActive.
+//
+// NOTE2:
+// Events that don't satisfy the predicate of the pending co_await (and all
+// events during delay()) are discarded, just like events ignored by a state
+// machine. Events that must not be lost can be deferred explicitly with
+// QActive::defer() and recalled after the co_await.
+// delay(0) does not suspend at all.
+//
+// NOTE3:
+// The frame allocation is a non-template operator new with up to eight
+// defaulted Arg slots rather than a variadic template, because GCC 12 cannot
+// match a template operator new with the class-specific operator delete and
+// reports a false -Wmismatched-new-delete for every coroutine. The Arg slots
+// bind to the coroutine parameters by reference (no copies), so a coroutine
+// may take at most eight parameters. The placement operator delete matches
+// the operator new and is used only if the construction of the promise fails.
+//
+
+#endif // QCORO_HPP_
@@ -0,0 +1,237 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QHSMARR_HPP_
+#define QHSMARR_HPP_
+
+#include <array>       // std::array<>
+#include <type_traits> // std::conditional<>
+#include <utility>     // std::forward()
+
+// NOTE: this header must be included after "qpcpp.hpp"
+
+namespace QP {
+
+//----------------------------------------------------------------------------
+// N_ instances of the state machine class SM_ in the structure-of-arrays
+// layout (current states and extended states), see NOTE1
+template<class SM_, std::uint_fast16_t N_>
+class QHsmArray {
+public:
+    using Data = typename SM_::Data; // extended state of one instance
+
+    // the arguments are passed to the constructor of SM_
+    template<typename... Args_>
+    explicit QHsmArray(Args_ &&... args)
+      : m_sm(std::forward<Args_>(args)...),
+        m_state0(m_sm.m_state), // the top state (before init())
+        m_temp0(m_sm.m_temp),   // the top-most initial tran.
+        m_state(),
+        m_data(),
+        m_order(),
+        m_tmp()
+    {
+        for (std::uint_fast16_t i = 0U; i < N_; ++i) {
+            m_state[i] = m_state0;
+            m_order[i] = static_cast<Idx>(i);
+        }
+    }
+
+    // take the top-most initial tran. in all instances
+    void init(
+        void const * const e,
+        std::uint_fast8_t const qsId)
+    {
+        for (std::uint_fast16_t i = 0U; i < N_; ++i) {
+            init(i, e, qsId);
+        }
+    }
+
+    // take the top-most initial tran. in the instance i
+    void init(
+        std::uint_fast16_t const i,
+        void const * const e,
+        std::uint_fast8_t const qsId)
+    {
+        checkIdx_(i);
+        m_sm.m_state = m_state0;
+        m_sm.m_temp  = m_temp0;
+        m_sm.m_data  = &m_data[i];
+        m_sm.SM_::init(e, qsId); // static binding, see NOTE2
+        m_state[i] = m_sm.m_state;
+    }
+
+    // dispatch e to all instances grouped by their current states
+    void dispatch(
+        QEvt const * const e,
+        std::uint_fast8_t const qsId)
+    {
+        sort_();
+        for (std::uint_fast16_t k = 0U; k < N_; ++k) {
+            dispatch_(m_order[k], e, qsId);
+        }
+    }
+
+    // dispatch e to the instance i only
+    void dispatch(
+        std::uint_fast16_t const i,
+        QEvt const * const e,
+        std::uint_fast8_t const qsId)
+    {
+        checkIdx_(i);
+        dispatch_(i, e, qsId);
+    }
+
+    Data &data(std::uint_fast16_t const i) noexcept {
+        checkIdx_(i);
+        return m_data[i];
+    }
+    QAsmAttr state(std::uint_fast16_t const i) const noexcept {
+        checkIdx_(i);
+        return m_state[i];
+    }
+    static constexpr std::uint_fast16_t size() noexcept {
+        return N_;
+    }
+
+private:
+    using Idx = typename std::conditional<(N_ <= 0x100U),
+        std::uint8_t, std::uint16_t>::type;
+
+    void dispatch_(
+        std::uint_fast16_t const i,
+        QEvt const * const e,
+        std::uint_fast8_t const qsId)
+    {
+        m_sm.m_state = m_state[i];
+#ifndef Q_UNSAFE
+        // Duplicate Inverse Storage of m_state checked by dispatch()
+        m_sm.m_temp.uint = static_cast<std::uintptr_t>(~m_state[i].uint);
+#endif
+        m_sm.m_data = &m_data[i];
+        m_sm.SM_::dispatch(e, qsId); // static binding, see NOTE2
+        m_state[i] = m_sm.m_state;
+    }
+
+    // order the instances by the current state (LSD radix sort, that is
+    // a stable counting sort per byte of the state, see NOTE1)
+    void sort_() noexcept {
+        // find the bytes in which the current states differ at all
+        std::uintptr_t const s0 = m_state[0U].uint;
+        std::uintptr_t diff = 0U;
+        for (std::uint_fast16_t i = 1U; i < N_; ++i) {
+            diff |= (m_state[i].uint ^ s0);
+        }
+
+        for (std::uint_fast8_t shift = 0U;
+             (shift < (8U * sizeof(std::uintptr_t)))
+                 && ((diff >> shift) != 0U);
+             shift += 8U)
+        {
+            if (((diff >> shift) & 0xFFU) == 0U) { // byte same in all?
+                continue; // the pass would not change the order
+            }
+
+            // count the instances with each value of the byte...
+            std::array<std::uint_fast32_t, 0x100U + 1U> pos {};
+            for (std::uint_fast16_t k = 0U; k < N_; ++k) {
+                ++pos[((m_state[m_order[k]].uint >> shift) & 0xFFU) + 1U];
+            }
+            // ...turn the counts into the first positions of the buckets...
+            for (std::uint_fast16_t b = 1U; b < 0x100U; ++b) {
+                pos[b] += pos[b - 1U];
+            }
+            // ...and distribute the instances, keeping their order
+            for (std::uint_fast16_t k = 0U; k < N_; ++k) {
+                Idx const i = m_order[k];
+                m_tmp[pos[(m_state[i].uint >> shift) & 0xFFU]] = i;
+                ++pos[(m_state[i].uint >> shift) & 0xFFU];
+            }
+            m_order = m_tmp;
+        }
+    }
+
+    static void checkIdx_(std::uint_fast16_t const i) noexcept {
+#ifndef Q_UNSAFE
+        if (i >= N_) { // index out of range?
+            QF_CRIT_EST();
+            Q_onError("qhsmarr", 100);
+        }
+#else
+        Q_UNUSED_PAR(i);
+#endif
+    }
+
+    static_assert((0U < N_) && (N_ <= 0x10000U),
+        "the number of instances must be 1..65536");
+
+    SM_ m_sm;          // the event processor shared by all instances
+    QAsmAttr m_state0; // the current state of SM_ before init()
+    QAsmAttr m_temp0;  // the top-most initial tran. of SM_
+    std::array<QAsmAttr, N_> m_state; // current states
+    std::array<Data, N_> m_data;      // extended states
+    std::array<Idx, N_> m_order;      // instances ordered by m_state[]
+    std::array<Idx, N_> m_tmp;        // scratch for sort_()
+}; // class QHsmArray
+
+} // namespace QP
+
+//============================================================================
+// NOTE1:
+// QHsmArray<SM_, N_> stores only the current state (one pointer) and the
+// extended state SM_::Data of every instance, each kind in its own array.
+// The instances share one object of class SM_ (a QHsm or QMsm subclass),
+// whose state handlers access the extended state exclusively through the
+// public member pointer m_data (type SM_::Data *). Before every RTC step
+// QHsmArray binds the shared object to the current state and the extended
+// state of the given instance, e.g.:
+//
+//     class Session : public QP::QHsm {
+//     public:
+//         struct Data { std::uint16_t retries; ... };
+//         Data *m_data; // the extended state of the current instance
+//         ...
+//     };
+//     static QP::QHsmArray<Session, 10000U> l_sessions;
+//
+// The broadcast dispatch() processes the instances in the order of their
+// current states, so every state handler runs for a whole run of instances
+// with warm instruction and data caches and well-trained branch predictor.
+// The order is established by a radix sort of the instances by the current
+// state, in O(N_) time per byte of the state pointers. Only the bytes that
+// differ among the current states need a pass, which is typically one or
+// two, because the state handlers of one class are close together in the
+// code. When all instances are in the same state, no pass is needed.
+//
+// NOTE2:
+// The calls to SM_::init() and SM_::dispatch() are qualified, so they are
+// bound statically (without the vtable). The QS trace of all instances
+// shows the shared SM_ object.
+//
+
+#endif // QHSMARR_HPP_
@@ -29,6 +29,10 @@
 #ifndef QK_HPP_
 #define QK_HPP_
 
+#if (QF_MAX_ACTIVE > 64U)
+    #error QK kernel supports QF_MAX_ACTIVE of up to 64U
+#endif
+
 //============================================================================
 namespace QP {
 
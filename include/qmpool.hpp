@@ -86,6 +86,16 @@ public:
     void put(
         void * const block,
         std::uint_fast8_t const qsId) noexcept;
+    template<typename T_> // void or QEvt (see qf_mem.cpp)
+    std::uint_fast16_t getBatch(
+        T_ * * const blocks,
+        std::uint_fast16_t const n,
+        std::uint_fast16_t const margin,
+        std::uint_fast8_t const qsId) noexcept;
+    void putBatch(
+        void * const * const blocks,
+        std::uint_fast16_t const n,
+        std::uint_fast8_t const qsId) noexcept;
     QMPoolSize getBlockSize() const noexcept;
     std::uint16_t getUse() const noexcept;
     std::uint16_t getFree() const noexcept;
@@ -101,6 +111,13 @@ public:
 #endif // def QF_ISR_API
 
 private:
+    void * get_(
+        std::uint_fast16_t const margin,
+        std::uint_fast8_t const qsId) noexcept;
+    void put_(
+        void * const block,
+        std::uint_fast8_t const qsId) noexcept;
+
     // friends...
     friend class QS;
 }; // class QMPool
@@ -43,8 +43,12 @@
 #define QF_MAX_ACTIVE 32U
 #endif
 
-#if (QF_MAX_ACTIVE > 64U)
-#error QF_MAX_ACTIVE exceeds the maximum of 64U;
+#if (QF_MAX_ACTIVE > 1024U)
+#error QF_MAX_ACTIVE exceeds the maximum of 1024U;
+#endif
+
+#if (QF_MAX_ACTIVE > 64U) && defined(Q_SPY)
+#error QS software tracing supports QF_MAX_ACTIVE of up to 64U;
 #endif
 
 #ifndef QF_MAX_TICK_RATE
@@ -59,8 +63,12 @@
 #define QF_MAX_EPOOL 3U
 #endif
 
-#if (QF_MAX_EPOOL > 15U)
-#error QF_MAX_EPOOL exceeds the maximum of 15U;
+#if (QF_MAX_EPOOL > 255U)
+#error QF_MAX_EPOOL exceeds the maximum of 255U;
+#endif
+
+#if (QF_MAX_EPOOL > 15U) && defined(Q_SPY)
+#error QS software tracing supports QF_MAX_EPOOL of up to 15U;
 #endif
 
 #ifndef QF_TIMEEVT_CTR_SIZE
@@ -79,6 +87,32 @@
 #error QF_EVENT_SIZ_SIZE defined incorrectly, expected 1U, 2U, or 4U;
 #endif
 
+#ifdef QF_EPOOL_LUT_SIZE
+#if (QF_EPOOL_LUT_SIZE < 1U) || (QF_EPOOL_LUT_SIZE > 1024U)
+#error QF_EPOOL_LUT_SIZE defined incorrectly, expected 1U..1024U;
+#endif
+#ifndef QF_EPOOL_LUT_GRANULE
+#define QF_EPOOL_LUT_GRANULE 4U
+#endif
+#endif
+
+#ifdef QHSM_SIG_TABLES
+#if (QHSM_SIG_TABLES < 2U) || (QHSM_SIG_TABLES > 1024U)
+#error QHSM_SIG_TABLES defined incorrectly, expected 2U..1024U;
+#endif
+#endif
+
+#ifdef QF_DISPATCH_QUOTA
+#if (QF_DISPATCH_QUOTA < 1U) || (QF_DISPATCH_QUOTA > 255U)
+#error QF_DISPATCH_QUOTA defined incorrectly, expected 1U..255U;
+#endif
+#endif
+
+#ifdef QEVT_REFCTR_ATOMIC
+#include <atomic> // std::atomic<> for the event reference counter
+#endif
+#include <type_traits> // std::is_same<> for QActiveCRTP
+
 //! @endcond
 
 //----------------------------------------------------------------------------
@@ -97,16 +131,36 @@ char const *version() noexcept;
 
 using QSignal = std::uint16_t;
 
+//----------------------------------------------------------------------------
+#if !defined(QEVT_REFCTR_ATOMIC) && (QF_MAX_ACTIVE <= 64U)
+    #define QEVT_REFCTR_BITS_ 8U  // refCtr_ in the QEvt bit-field
+#else
+    // wide reference counter for events multicast to more than 255 AOs
+    using QEvtRefCtr = std::uint32_t;
+#endif
+
 //----------------------------------------------------------------------------
 class QEvt {
 public:
+#ifdef QEVT_REFCTR_BITS_
     std::uint32_t sig         : 16;
     std::uint32_t poolNum_    :  8;
     std::uint32_t refCtr_     :  8;
     std::uint32_t filler_;
+#else // separate (and possibly atomic) reference counter
+    std::uint16_t sig;
+    std::uint8_t  poolNum_;
+    std::uint8_t  filler_;
+#ifndef QEVT_REFCTR_ATOMIC
+    QEvtRefCtr    refCtr_;
+#else // lock-free reference counting (see qf_dyn.cpp)
+    std::atomic<QEvtRefCtr> refCtr_;
+#endif
+#endif // ndef QEVT_REFCTR_BITS_
 
     enum DynEvt: std::uint8_t { DYNAMIC };
 
+#ifdef QEVT_REFCTR_BITS_
     explicit constexpr QEvt(QSignal const s) noexcept
       : sig(s)            // the provided event signal
         ,poolNum_(0x00U)  // no-pool event
@@ -114,9 +168,33 @@ public:
         ,filler_ (0xE0E0E0E0U) // the "filler" ensures the same QEvt size
                                // as in SafeQP/C++
     {}
+#else
+    explicit constexpr QEvt(QSignal const s) noexcept
+      : sig(s)            // the provided event signal
+        ,poolNum_(0x00U)  // no-pool event
+        ,filler_ (0xE0U)  // the "filler" aligns the reference counter
+        ,refCtr_ (0xE0U)  // special event "marker"
+    {}
+#endif // def QEVT_REFCTR_BITS_
 
     QEvt() // disallow the default ctor
         = delete;
+#ifdef QEVT_REFCTR_ATOMIC
+    QEvt(QEvt const &other) noexcept
+      : sig(other.sig),
+        poolNum_(other.poolNum_),
+        filler_(other.filler_),
+        refCtr_(other.refCtr_.load(std::memory_order_relaxed))
+    {}
+    QEvt & operator=(QEvt const &other) noexcept {
+        sig      = other.sig;
+        poolNum_ = other.poolNum_;
+        filler_  = other.filler_;
+        refCtr_.store(other.refCtr_.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+        return *this;
+    }
+#endif // def QEVT_REFCTR_ATOMIC
     void init() const noexcept {
         // no event parameters to initialize
     }
@@ -139,6 +217,9 @@ struct QEvtPtr {
 using QState = std::uint_fast8_t;
 
 class QXThread; // forward declaration
+#ifdef QHSM_TRAN_CACHE
+class QTranCache; // forward declaration
+#endif
 
 using QStateHandler = QState (*)(void * const me, QEvt const * const e);
 using QActionHandler = QState (*)(void * const me);
@@ -157,6 +238,15 @@ struct QMTranActTable {
     std::array<QActionHandler, 1> act;
 };
 
+#ifdef QHSM_SIG_TABLES
+struct QSigTable {
+    QStateHandler state;      // the state owning the table
+    QStateHandler super;      // the superstate of 'state'
+    QStateHandler const *act; // actions indexed by signal (nullptr: none)
+    QSignal len;              // # entries in act[]
+};
+#endif // def QHSM_SIG_TABLES
+
 union QAsmAttr {
     QStateHandler   fun;
     QActionHandler  act;
@@ -166,6 +256,13 @@ union QAsmAttr {
     std::uintptr_t  uint;
 };
 
+#ifdef QASM_ACTIVE_CONFIG
+struct QActiveConfig {
+    std::array<QAsmAttr, 6U> state; // active configuration (leaf first)
+    std::uint8_t len {0U}; // # states in state[] (0 when not known)
+};
+#endif // def QASM_ACTIVE_CONFIG
+
 constexpr QSignal Q_USER_SIG {4U};
 
 //----------------------------------------------------------------------------
@@ -173,6 +270,9 @@ class QAsm {
 public:
     QAsmAttr m_state;
     QAsmAttr m_temp;
+#ifdef QHSM_SIG_TABLES
+    bool m_sigTbls; // signal tables registered for this SM? (QHsm only)
+#endif
 
     // All possible values returned from state/action handlers...
     // NOTE: The numerical order is important for algorithmic correctness.
@@ -221,6 +321,34 @@ public:
         std::uint_fast8_t const qsId) = 0;
     virtual bool isIn(QStateHandler const stateHndl) = 0;
     virtual QStateHandler getStateHandler() const noexcept = 0;
+#ifdef QHSM_TRAN_CACHE
+    virtual QTranCache * tranCache() noexcept {
+        return nullptr; // no transition-path cache (QHsm only)
+    }
+#endif
+#ifdef QASM_ACTIVE_CONFIG
+    virtual QActiveConfig * activeConfig() const noexcept {
+        return nullptr; // no cached active configuration (QHsm and QMsm)
+    }
+#endif
+#ifdef QACTIVE_SNAPSHOT
+    // serialization of the extended state (see QActive::snapshot())
+    virtual std::size_t snapshotExt(
+        std::uint8_t * const buf,
+        std::size_t const size) const noexcept
+    {
+        static_cast<void>(buf);  // unused parameter
+        static_cast<void>(size); // unused parameter
+        return 0U; // no extended state (> size when buf is too small)
+    }
+    virtual bool restoreExt(
+        std::uint8_t const * const buf,
+        std::size_t const len) noexcept
+    {
+        static_cast<void>(buf); // unused parameter
+        return len == 0U; // no extended state
+    }
+#endif
 
     QStateHandler state() const noexcept {
         return m_state.fun; // public "getter" for the state handler
@@ -314,6 +442,9 @@ public:
     QStateHandler getStateHandler() const noexcept override;
 
     QStateHandler childState(QStateHandler const parentHndl) noexcept;
+#ifdef QHSM_SIG_TABLES
+    void addSigTable(QSigTable const * const tbl) noexcept;
+#endif
 
 private:
     // maximum depth of state nesting in a QHsm (including the top level)
@@ -332,11 +463,57 @@ private:
         std::array<QStateHandler, MAX_NEST_DEPTH_> &path,
         std::size_t const depth,
         std::uint_fast8_t const qsId);
+#ifdef QASM_ACTIVE_CONFIG
+    void updateConfig_() noexcept;
+#endif
+#ifdef QHSM_SIG_TABLES
+    static QSigTable const *findSigTable_(QStateHandler const s) noexcept;
+#endif
+
+#ifdef QHSM_TRAN_CACHE
+    std::size_t tran_cached_(
+        std::array<QStateHandler, MAX_NEST_DEPTH_> &path,
+        QTranCache &cache,
+        std::uint_fast8_t const qsId);
+#endif
 
     // friends...
     friend class QS;
+#ifdef QHSM_TRAN_CACHE
+    friend class QTranCache;
+#endif
 }; // class QHsm
 
+#ifdef QHSM_TRAN_CACHE
+//----------------------------------------------------------------------------
+class QTranCache {
+public:
+    struct Entry {
+        QStateHandler src;   // tran. source (nullptr for an unused entry)
+        QStateHandler trg;   // tran. target
+        std::uint8_t nExit;  // # states to exit (from the source up)
+        std::uint8_t nEntry; // # states to enter (from the LCA down)
+        std::array<QStateHandler, QHsm::MAX_NEST_DEPTH_> exit;
+        std::array<QStateHandler, QHsm::MAX_NEST_DEPTH_> entry;
+    };
+
+    QTranCache(
+        Entry * const sto,
+        std::uint_fast16_t const len) noexcept;
+
+private:
+    Entry *slot_(
+        QStateHandler const s,
+        QStateHandler const t) const noexcept;
+
+    Entry * const m_sto;           // entries provided by the application
+    std::uint_fast16_t const m_len; // # entries (direct-mapped)
+
+    // friends...
+    friend class QHsm;
+}; // class QTranCache
+#endif // def QHSM_TRAN_CACHE
+
 //----------------------------------------------------------------------------
 class QMsm : public QP::QAsm {
 protected:
@@ -368,6 +545,9 @@ private:
     QState enterHistory_(
         QMState const * const hist,
         std::uint_fast8_t const qsId);
+#ifdef QASM_ACTIVE_CONFIG
+    void updateConfig_() noexcept;
+#endif
 
     // friends...
     friend class QS;
@@ -420,10 +600,19 @@ private:
 //============================================================================
 namespace QP {
 
-using QPrioSpec = std::uint16_t;
+#if (QF_MAX_ACTIVE <= 64U)
+    using QPrio     = std::uint8_t;  // QF priority of an AO
+    using QPrioSpec = std::uint16_t; // prio. (bits 0..7) | pthre (8..15)
+#else
+    using QPrio     = std::uint16_t; // QF priority of an AO
+    using QPrioSpec = std::uint32_t; // prio. (bits 0..15) | pthre (16..31)
+#endif
 
 class QEQueue; // forward declaration
 class QActive; // forward declaration
+#ifdef QACTIVE_SNAPSHOT
+class QTimeEvt; // forward declaration
+#endif
 
 #if (QF_TIMEEVT_CTR_SIZE == 1U)
     using QTimeEvtCtr = std::uint8_t;
@@ -441,6 +630,11 @@ class QActive; // forward declaration
     using QPSetBits = std::uint32_t;
 #endif // (16 < QF_MAX_ACTIVE)
 
+#if (QF_MAX_ACTIVE > 64U)
+    // number of 32-bit leaf bitmasks in the hierarchical QPSet
+    constexpr std::uint_fast8_t QPSET_LEAVES {(QF_MAX_ACTIVE + 31U) / 32U};
+#endif
+
 #ifndef QF_LOG2
     std::uint_fast8_t QF_LOG2(QP::QPSetBits const bitmask) noexcept;
 #endif // ndef QF_LOG2
@@ -448,26 +642,45 @@ class QActive; // forward declaration
 //----------------------------------------------------------------------------
 class QPSet {
 private:
+#if (QF_MAX_ACTIVE <= 64U)
     QPSetBits m_bits0;
 #if (QF_MAX_ACTIVE > 32U)
     QPSetBits m_bits1;
 #endif
+#else // hierarchical set (summary + leaves)
+    QPSetBits m_summary; // bit k-1 set when m_leaf[k-1] is not empty
+    std::array<QPSetBits, QPSET_LEAVES> m_leaf; // elements 32*k+1..32*k+32
+#endif
 
 public:
+#if (QF_MAX_ACTIVE <= 64U)
     constexpr QPSet()
       : m_bits0(0U)
 #if (QF_MAX_ACTIVE > 32U)
        ,m_bits1(0U)
 #endif
     {}
+#else
+    constexpr QPSet()
+      : m_summary(0U),
+        m_leaf()
+    {}
+#endif
 
     void setEmpty() noexcept;
     bool isEmpty() const noexcept;
     bool notEmpty() const noexcept;
+#if (QF_MAX_ACTIVE <= 64U)
     bool hasElement(std::uint_fast8_t const n) const noexcept;
     void insert(std::uint_fast8_t const n) noexcept;
     void remove(std::uint_fast8_t const n) noexcept;
     std::uint_fast8_t findMax() const noexcept;
+#else
+    bool hasElement(std::uint_fast16_t const n) const noexcept;
+    void insert(std::uint_fast16_t const n) noexcept;
+    void remove(std::uint_fast16_t const n) noexcept;
+    std::uint_fast16_t findMax() const noexcept;
+#endif
 
     // friends...
     friend class QS;
@@ -500,8 +713,8 @@ namespace QF {
 //----------------------------------------------------------------------------
 class QActive : public QAsm {
 private:
-    std::uint8_t m_prio;
-    std::uint8_t m_pthre;
+    QPrio m_prio;
+    QPrio m_pthre;
 
 #ifdef QACTIVE_THREAD_TYPE
     QACTIVE_THREAD_TYPE m_thread;
@@ -515,9 +728,37 @@ private:
     QACTIVE_EQUEUE_TYPE m_eQueue;
 #endif
 
+public:
+    using DispatchHandler = void (*)(QActive * const act,
+        QEvt const * const * const evts, std::uint_fast16_t const n);
+
+private:
+#ifdef QACTIVE_STATIC_DISPATCH
+    DispatchHandler m_dispatch; // see NOTE2 in qf_qact.cpp
+#endif
+
 protected:
     explicit QActive(QStateHandler const initial) noexcept;
 
+    void setDispatch_(DispatchHandler const handler) noexcept {
+#ifdef QACTIVE_STATIC_DISPATCH
+        m_dispatch = handler; // bind the AO to its dispatch handler
+#else
+        static_cast<void>(handler); // unused parameter
+#endif
+    }
+
+    // dispatch handler statically bound to AO_::dispatch() (no vtable)
+    template<class AO_>
+    static void dispatchStatic_(QActive * const act,
+        QEvt const * const * const evts, std::uint_fast16_t const n)
+    {
+        AO_ * const ao = static_cast<AO_ *>(act);
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            ao->AO_::dispatch(evts[i], act->m_prio); // can be inlined
+        }
+    }
+
 public:
     using QAsm::init;
     void init(
@@ -530,6 +771,9 @@ public:
     QStateHandler getStateHandler() const noexcept override;
 
     QStateHandler childState(QStateHandler const parentHandler) noexcept;
+#ifdef QHSM_SIG_TABLES
+    void addSigTable(QSigTable const * const tbl) noexcept;
+#endif
     void setAttr(
         std::uint32_t attr1,
         void const * attr2 = nullptr);
@@ -552,14 +796,35 @@ public:
     bool postx_(QEvt const * const e,
         std::uint_fast16_t const margin,
         void const * const sender) noexcept;
+    bool postBatchx_(QEvt const * const * const evts,
+        std::uint_fast16_t const n,
+        std::uint_fast16_t const margin,
+        void const * const sender) noexcept;
     void postLIFO(QEvt const * const e) noexcept;
     QEvt const * get_() noexcept;
+#ifdef QF_DISPATCH_QUOTA
+    std::uint_fast16_t getBatch_(
+        QEvt const ** const evts,
+        std::uint_fast16_t const max) noexcept;
+#endif
+#ifdef QACTIVE_SNAPSHOT
+    std::size_t snapshot(
+        std::uint8_t * const buf,
+        std::size_t const size,
+        QTimeEvt const * const * const te = nullptr,
+        std::uint_fast8_t const nTe = 0U) noexcept;
+    bool restore(
+        std::uint8_t const * const buf,
+        std::size_t const len,
+        QTimeEvt * const * const te = nullptr,
+        std::uint_fast8_t const nTe = 0U) noexcept;
+#endif
     static std::uint16_t getQueueUse(
-        std::uint_fast8_t const prio) noexcept;
+        QPrio const prio) noexcept;
     static std::uint16_t getQueueFree(
-        std::uint_fast8_t const prio) noexcept;
+        QPrio const prio) noexcept;
     static std::uint16_t getQueueMin(
-        std::uint_fast8_t const prio) noexcept;
+        QPrio const prio) noexcept;
     static void psInit(
         QSubscrList * const subscrSto,
         QSignal const maxSignal) noexcept;
@@ -577,11 +842,11 @@ public:
     std::uint16_t flushDeferred(
         QEQueue * const eq,
         std::uint_fast16_t const num = 0xFFFFU) const noexcept;
-    std::uint8_t getPrio() const noexcept {
+    QPrio getPrio() const noexcept {
         return m_prio; // public "getter" for the AO's prio
     }
     static void evtLoop_(QActive *act);
-    static QActive *fromRegistry(std::uint_fast8_t const prio);
+    static QActive *fromRegistry(QPrio const prio);
 
 #ifdef QACTIVE_THREAD_TYPE
     QACTIVE_THREAD_TYPE const & getThread() const & {
@@ -623,6 +888,22 @@ private:
     void postFIFO_(
         QEvt const * const e,
         void const * const sender);
+    void dispatch_(
+        QEvt const * const * const evts,
+        std::uint_fast16_t const n)
+    {
+#ifdef QACTIVE_STATIC_DISPATCH
+        (*m_dispatch)(this, evts, n); // one indirect call per batch
+#else
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            dispatch(evts[i], m_prio); // virtual call
+        }
+#endif
+    }
+#ifdef QACTIVE_STATIC_DISPATCH
+    static void dispatchVirtual_(QActive * const act,
+        QEvt const * const * const evts, std::uint_fast16_t const n);
+#endif
     static void multicast_(
         QPSet * const subscrSet,
         QEvt const * const e,
@@ -667,9 +948,34 @@ public:
     QMState const *childStateObj(QMState const * const parent) const noexcept;
 }; // class QMActive
 
+//----------------------------------------------------------------------------
+// CRTP active object AO_ (derived from Base_) dispatched without the vtable
+// NOTE: pays off only when AO_ defines its own inline dispatch() (as the
+// QTActive<> from "qtsm.hpp"). The out-of-line QHsm/QMsm::dispatch() cannot
+// be inlined, so such AOs are rejected (see NOTE2 in qf_qact.cpp).
+template<class AO_, class Base_ = QActive>
+class QActiveCRTP : public Base_ {
+protected:
+    explicit QActiveCRTP(QStateHandler const initial) noexcept
+      : Base_(initial)
+    {
+        static_assert(std::is_same<decltype(&AO_::dispatch),
+            void (AO_::*)(QEvt const * const, std::uint_fast8_t const)>::value,
+            "QActiveCRTP<AO_> requires AO_ to define its own dispatch()");
+        this->setDispatch_(&QActive::dispatchStatic_<AO_>);
+    }
+}; // class QActiveCRTP
+
 //----------------------------------------------------------------------------
 #if (QF_MAX_TICK_RATE > 0U)
 
+#ifdef QF_TIMEEVT_WHEEL
+struct QTimeWheel; // forward declaration
+#endif
+#ifdef QF_TIMEEVT_TICKLESS
+class QTickless;   // forward declaration
+#endif
+
 class QTimeEvt : public QEvt {
 private:
     QTimeEvt *m_next;
@@ -678,6 +984,15 @@ private:
     QTimeEvtCtr m_interval;
     std::uint8_t m_tickRate;
     std::uint8_t m_flags;
+#ifdef QF_TIMEEVT_WHEEL
+    QTimeEvt **m_prev;    // link pointing to this time event
+    std::uint32_t m_when; // absolute tick count of the expiration
+#endif
+#ifdef QF_TIMEEVT_TICKLESS
+    std::uint64_t m_deadline; // absolute deadline [ns]
+    std::uint64_t m_period;   // deadline period [ns] (0 for one-shot)
+    std::uint32_t m_heapIdx;  // index in the deadline heap (0 if not there)
+#endif
 
 public:
     QTimeEvt(
@@ -690,6 +1005,14 @@ public:
     bool disarm() noexcept;
     bool rearm(std::uint32_t const nTicks) noexcept;
     bool wasDisarmed() noexcept;
+#ifdef QF_TIMEEVT_TICKLESS
+    void armAt(
+        std::uint64_t const deadline,
+        std::uint64_t const period = 0U) noexcept;
+    void armIn(
+        std::uint64_t const nsec,
+        std::uint64_t const period = 0U) noexcept;
+#endif
     void const * getAct() const & {
         // ref-qualified reference (MISRA-C++:2023 Rule 6.8.4)
         return m_act;
@@ -697,9 +1020,13 @@ public:
     void const * getAct() const &&
         // ref-qualified reference (MISRA-C++:2023 Rule 6.8.4)
         = delete;
+#ifndef QF_TIMEEVT_WHEEL
     QTimeEvtCtr getCtr() const noexcept {
         return m_ctr; // public "getter" for the current time-evt count
     }
+#else
+    QTimeEvtCtr getCtr() const noexcept; // computed from the timing wheel
+#endif
     QTimeEvtCtr getInterval() const noexcept {
         return m_interval; // public "getter" for the time-evt interval
     }
@@ -735,14 +1062,22 @@ public:
     QTimeEvt() noexcept;
 
 private:
+#ifndef QF_TIMEEVT_WHEEL
     QTimeEvt *expire_(
         QTimeEvt * const prev_link,
         QActive const * const act,
         std::uint_fast8_t const tickRate) noexcept;
+#else
+    void link_(QTimeWheel &wheel) noexcept;
+    void unlink_(QTimeWheel &wheel) noexcept;
+#endif
 
     // fiends...
     friend class QXThread;
     friend class QS;
+#ifdef QF_TIMEEVT_TICKLESS
+    friend class QTickless;
+#endif
 }; // class QTimeEvt
 
 //----------------------------------------------------------------------------
@@ -782,7 +1117,7 @@ inline void publish_(QEvt const * const e,
 
 //! @deprecated
 inline std::uint_fast16_t getQueueMin(
-    std::uint_fast8_t const prio) noexcept
+    QPrio const prio) noexcept
 {
     // use QActive::getQueueMin() instead of the deprecated QF::getQueueMin()
     return QActive::getQueueMin(prio);
@@ -814,20 +1149,60 @@ QEvt * newX_(
     std::uint_fast16_t const evtSize,
     std::uint_fast16_t const margin,
     QSignal const sig) noexcept;
+#ifdef QF_EPOOL_LUT_SIZE
+constexpr std::uint_fast16_t sizeClass_(
+    std::uint_fast16_t const evtSize) noexcept
+{
+    // index of the event size in the size-class lookup table
+    return (evtSize + (QF_EPOOL_LUT_GRANULE - 1U)) / QF_EPOOL_LUT_GRANULE;
+}
+QEvt * newClassX_(
+    std::uint_fast16_t const sizeClass,
+    std::uint_fast16_t const evtSize,
+    std::uint_fast16_t const margin,
+    QSignal const sig) noexcept;
+#endif // def QF_EPOOL_LUT_SIZE
+bool newBatchX_(
+    QEvt ** const evts,
+    std::uint_fast16_t const n,
+    std::uint_fast16_t const evtSize,
+    std::uint_fast16_t const margin,
+    QSignal const sig) noexcept;
 void gc(QEvt const * const e) noexcept;
+#ifdef QF_DISPATCH_QUOTA
+void gcBatch_(
+    QEvt const * const * const evts,
+    std::uint_fast16_t const n) noexcept;
+#endif
 QEvt const * newRef_(
     QEvt const * const e,
     QEvt const * const evtRef) noexcept;
 
 void deleteRef_(QEvt const * const evtRef) noexcept;
 
+template<class evtT_>
+inline QEvt * newOf_(
+    std::uint_fast16_t const margin,
+    QSignal const sig) noexcept
+{
+#ifdef QF_EPOOL_LUT_SIZE
+    // the size class of evtT_ is resolved at compile time, so only
+    // the lookup of the pool in the size-class table remains
+    return (sizeClass_(sizeof(evtT_)) < QF_EPOOL_LUT_SIZE)
+        ? newClassX_(sizeClass_(sizeof(evtT_)), sizeof(evtT_), margin, sig)
+        : newX_(sizeof(evtT_), margin, sig);
+#else
+    return newX_(sizeof(evtT_), margin, sig);
+#endif // def QF_EPOOL_LUT_SIZE
+}
+
 #ifndef QEVT_PAR_INIT
     template<class evtT_>
     inline evtT_ * q_new(QSignal const sig) {
         // allocate a dynamic (mutable) event with NO_MARGIN
         // NOTE: the returned event ptr is guaranteed NOT to be nullptr
         return static_cast<evtT_*>(
-            QP::QF::newX_(sizeof(evtT_), QP::QF::NO_MARGIN, sig));
+            QP::QF::newOf_<evtT_>(QP::QF::NO_MARGIN, sig));
     }
     template<class evtT_>
     inline evtT_ * q_new_x(std::uint_fast16_t const margin,
@@ -835,7 +1210,7 @@ void deleteRef_(QEvt const * const evtRef) noexcept;
     {
         // allocate a dynamic (mutable) event with a provided margin
         // NOTE: the returned event ptr is MIGHT be nullptr
-        return static_cast<evtT_*>(QP::QF::newX_(sizeof(evtT_), margin, sig));
+        return static_cast<evtT_*>(QP::QF::newOf_<evtT_>(margin, sig));
     }
 #else
     template<class evtT_, typename... Args>
@@ -843,7 +1218,7 @@ void deleteRef_(QEvt const * const evtRef) noexcept;
         // allocate a dynamic (mutable) event with NO_MARGIN
         // NOTE: the returned event ptr is guaranteed NOT to be nullptr
         evtT_ *e = static_cast<evtT_*>(
-            QP::QF::newX_(sizeof(evtT_), QP::QF::NO_MARGIN, sig));
+            QP::QF::newOf_<evtT_>(QP::QF::NO_MARGIN, sig));
         e->init(args...); // immediately initialize the event (RAII)
         return e;
     }
@@ -854,7 +1229,7 @@ void deleteRef_(QEvt const * const evtRef) noexcept;
         // allocate a dynamic (mutable) event with a provided margin
         // NOTE: the event allocation is MIGHT fail
         evtT_ *e =
-            static_cast<evtT_*>(QP::QF::newX_(sizeof(evtT_), margin, sig));
+            static_cast<evtT_*>(QP::QF::newOf_<evtT_>(margin, sig));
         if (e != nullptr) { // was the allocation successfull?
             e->init(args...); // immediately initialize the event (RAII)
         }
@@ -863,6 +1238,19 @@ void deleteRef_(QEvt const * const evtRef) noexcept;
     }
 #endif // QEVT_PAR_INIT
 
+template<class evtT_>
+inline bool q_new_batch(
+    QEvt ** const evts,
+    std::uint_fast16_t const n,
+    std::uint_fast16_t const margin,
+    QSignal const sig)
+{
+    // allocate n dynamic (mutable) events of the same type at once
+    // NOTE: the allocation is all-or-nothing and with QEVT_PAR_INIT
+    // the events still need to be initialized by the caller
+    return QP::QF::newBatchX_(evts, n, sizeof(evtT_), margin, sig);
+}
+
 template<class evtT_>
 inline void q_new_ref(
     QP::QEvt const * const e,
@@ -898,8 +1286,13 @@ extern "C" void QF_onContextSw(QP::QActive * prev, QP::QActive * next);
 //----------------------------------------------------------------------------
 // QF base facilities
 
+#if (QF_MAX_ACTIVE <= 64U)
 #define Q_PRIO(prio_, pthre_) \
     (static_cast<QP::QPrioSpec>((prio_) | (pthre_) << 8U))
+#else
+#define Q_PRIO(prio_, pthre_) \
+    (static_cast<QP::QPrioSpec>((prio_) | (pthre_) << 16U))
+#endif
 
 #ifndef QEVT_PAR_INIT
     #define Q_NEW(evtT_, sig_)    (QP::QF::q_new<evtT_>((sig_)))
@@ -912,6 +1305,9 @@ extern "C" void QF_onContextSw(QP::QActive * prev, QP::QActive * next);
         (QP::QF::q_new_x<evtT_>((margin_), (sig_), __VA_ARGS__))
 #endif // QEVT_PAR_INIT
 
+#define Q_NEW_BATCH(evts_, n_, evtT_, margin_, sig_) \
+    (QP::QF::q_new_batch<evtT_>((evts_), (n_), (margin_), (sig_)))
+
 #define Q_NEW_REF(evtRef_, evtT_) (QP::QF::q_new_ref<evtT_>(e, (evtRef_)))
 #define Q_DELETE_REF(evtRef_) do { \
     QP::QF::deleteRef_((evtRef_)); \
@@ -924,12 +1320,16 @@ extern "C" void QF_onContextSw(QP::QActive * prev, QP::QActive * next);
     #define POST(e_, sender_) post_((e_), (sender_))
     #define POST_X(e_, margin_, sender_) \
         postx_((e_), (margin_), (sender_))
+    #define POST_BATCH_X(evts_, n_, margin_, sender_) \
+        postBatchx_((evts_), (n_), (margin_), (sender_))
     #define TICK_X(tickRate_, sender_) tick((tickRate_), (sender_))
     #define TRIG(sender_) trig_((sender_))
 #else
     #define PUBLISH(e_, dummy) publish_((e_), nullptr, 0U)
     #define POST(e_, dummy) post_((e_), nullptr)
     #define POST_X(e_, margin_, dummy) postx_((e_), (margin_), nullptr)
+    #define POST_BATCH_X(evts_, n_, margin_, dummy) \
+        postBatchx_((evts_), (n_), (margin_), nullptr)
     #define TICK_X(tickRate_, dummy) tick((tickRate_), nullptr)
     #define TRIG(sender_) trig_(nullptr)
 #endif // ndef Q_SPY
@@ -31,6 +31,96 @@
 
 #ifdef QP_IMPL
 
+//----------------------------------------------------------------------------
+// QF critical sections for the individual domains of the framework.
+// By default, all domains are protected by the single QF critical section,
+// but a QP port can protect them with separate locks (e.g., POSIX).
+// NOTE: all domain critical sections use the QF_CRIT_STAT status.
+
+#ifndef QF_MEM_CRIT_ENTRY_ // memory pool
+    #define QF_MEM_CRIT_ENTRY_(pool_)       QF_CRIT_ENTRY()
+    #define QF_MEM_CRIT_EXIT_(pool_)        QF_CRIT_EXIT()
+#endif
+
+#ifndef QF_MEM_LOCK_ // memory pool, already inside a crit.sect.
+    #define QF_MEM_LOCK_(pool_)             (static_cast<void>(0))
+    #define QF_MEM_UNLOCK_(pool_)           (static_cast<void>(0))
+#endif
+
+#if defined(QEVT_REFCTR_ATOMIC) && !defined(Q_SPY)
+    // atomic reference counters need no critical section (see qf_dyn.cpp)
+    #define QF_EVT_CRIT_ENTRY_(e_)          (static_cast<void>(0))
+    #define QF_EVT_CRIT_EXIT_(e_)           (static_cast<void>(0))
+#endif
+
+#ifndef QF_EVT_CRIT_ENTRY_ // reference counter of a mutable event
+    #define QF_EVT_CRIT_ENTRY_(e_)          QF_CRIT_ENTRY()
+    #define QF_EVT_CRIT_EXIT_(e_)           QF_CRIT_EXIT()
+#endif
+
+// assertions inside QF_EVT_CRIT_ENTRY_()/QF_EVT_CRIT_EXIT_(), which don't
+// establish a critical section for the atomic reference counters
+#if defined(QEVT_REFCTR_ATOMIC) && !defined(Q_SPY)
+    #define Q_ASSERT_EVT_(id_, expr_)       Q_ASSERT_LOCAL((id_), (expr_))
+#else
+    #define Q_ASSERT_EVT_(id_, expr_)       Q_ASSERT_INCRIT((id_), (expr_))
+#endif
+#define Q_REQUIRE_EVT_(id_, expr_)          Q_ASSERT_EVT_((id_), (expr_))
+
+#ifndef QF_EVT_LOCK_ // reference counter, already inside a crit.sect.
+    #define QF_EVT_LOCK_(e_)                (static_cast<void>(0))
+    #define QF_EVT_UNLOCK_(e_)              (static_cast<void>(0))
+#endif
+
+#ifndef QF_TIME_CRIT_ENTRY_ // time events of a given tick rate
+    #define QF_TIME_CRIT_ENTRY_(tickRate_)  QF_CRIT_ENTRY()
+    #define QF_TIME_CRIT_EXIT_(tickRate_)   QF_CRIT_EXIT()
+#endif
+
+#ifndef QF_PS_CRIT_ENTRY_ // publish-subscribe lists
+    #define QF_PS_CRIT_ENTRY_()             QF_CRIT_ENTRY()
+    #define QF_PS_CRIT_EXIT_()              QF_CRIT_EXIT()
+#endif
+
+#ifndef QACTIVE_EQUEUE_CRIT_ENTRY_ // event queue of a given AO
+    #define QACTIVE_EQUEUE_CRIT_ENTRY_(me_) QF_CRIT_ENTRY()
+    #define QACTIVE_EQUEUE_CRIT_EXIT_(me_)  QF_CRIT_EXIT()
+#endif
+
+#ifndef QACTIVE_EQUEUE_LOCK_ // AO event queue, already inside a crit.sect.
+    #define QACTIVE_EQUEUE_LOCK_(me_)       (static_cast<void>(0))
+    #define QACTIVE_EQUEUE_UNLOCK_(me_)     (static_cast<void>(0))
+#endif
+
+//----------------------------------------------------------------------------
+// allocation and recycling of several blocks from/to the same event pool
+// (see QF::newBatchX_() and QF::gcBatch_()). By default, the blocks are
+// handled one by one (so a batch can be obtained only partially), but a QP
+// port can handle them in a single pool operation (e.g., the all-or-nothing
+// QMPool::getBatch() and QMPool::putBatch()).
+
+#ifndef QF_EPOOL_GET_BATCH_
+    #define QF_EPOOL_GET_BATCH_(p_, blocks_, n_, m_, qsId_, nGot_) do { \
+        (nGot_) = 0U; \
+        for (; (nGot_) < (n_); ++(nGot_)) { \
+            QEvt *e_; \
+            QF_EPOOL_GET_((p_), e_, (m_), (qsId_)); \
+            if (e_ == nullptr) { \
+                break; \
+            } \
+            (blocks_)[(nGot_)] = e_; \
+        } \
+    } while (false)
+#endif
+
+#ifndef QF_EPOOL_PUT_BATCH_
+    #define QF_EPOOL_PUT_BATCH_(p_, blocks_, n_, qsId_) do { \
+        for (std::uint_fast16_t i_ = 0U; i_ < (n_); ++i_) { \
+            QF_EPOOL_PUT_((p_), (blocks_)[i_], (qsId_)); \
+        } \
+    } while (false)
+#endif
+
 namespace QP {
 
 extern std::array<QActive*, QF_MAX_ACTIVE + 1U> QActive_registry_;
@@ -38,16 +128,64 @@ extern QSubscrList *QActive_subscrList_;
 extern QSignal QActive_maxPubSignal_;
 
 #if (QF_MAX_TICK_RATE > 0U)
+#ifndef QF_TIMEEVT_WHEEL
 extern std::array<QTimeEvt, QF_MAX_TICK_RATE> QTimeEvt_head_;
+#else
+
+// hierarchical timing wheel of the time events at a given tick rate
+// (one level per byte of the QTimeEvtCtr dynamic range)
+constexpr std::uint_fast8_t  QTE_WHEEL_BITS   {8U};
+constexpr std::uint_fast16_t QTE_WHEEL_SLOTS  {1U << QTE_WHEEL_BITS};
+constexpr std::uint_fast8_t  QTE_WHEEL_LEVELS {QF_TIMEEVT_CTR_SIZE};
+
+struct QTimeWheel {
+    std::array<std::array<QTimeEvt *, QTE_WHEEL_SLOTS>,
+               QTE_WHEEL_LEVELS> slot; // lists of armed time events
+    QTimeEvt *cascade;     // time events moved to the lower levels
+    QTimeEvt *expiring;    // time events expiring in the current tick
+    std::uint32_t now;     // current tick count at this tick rate
+    std::uint32_t nLinked; // number of time events linked into the wheel
+};
+
+extern std::array<QTimeWheel, QF_MAX_TICK_RATE> QTimeWheel_;
+
+#endif // QF_TIMEEVT_WHEEL
 
 // Bitmasks are for the QTimeEvt::flags attribute
 constexpr std::uint8_t QTE_FLAG_IS_LINKED    {1U << 7U};
 constexpr std::uint8_t QTE_FLAG_WAS_DISARMED {1U << 6U};
+constexpr std::uint8_t QTE_FLAG_IS_DEADLINE  {1U << 5U};
+
+#ifdef QF_TIMEEVT_TICKLESS
+// deadline time events served by a single timerfd (Linux only),
+// see ports/posix-common/qf_tickless.cpp
+class QTickless {
+public:
+    static void init() noexcept;
+    static std::uint64_t now() noexcept;
+    static bool wait(
+        std::uint64_t &nextTick,
+        std::uint64_t const period) noexcept;
+    static void wake() noexcept;
+    static bool isDeadline(QTimeEvt const &te) noexcept; // armed by armAt()?
+
+private:
+    static void schedule_(QTimeEvt * const te) noexcept;
+    static QTimeEvt *pop_(std::uint64_t const now) noexcept;
+    static void siftUp_(std::uint32_t idx) noexcept;
+    static void siftDown_(std::uint32_t idx) noexcept;
+    static void program_(std::uint64_t const deadline) noexcept;
+    static void expire_(std::uint64_t const now) noexcept;
+
+    friend class QTimeEvt;
+}; // class QTickless
+#endif // QF_TIMEEVT_TICKLESS
 
 #endif // (QF_MAX_TICK_RATE > 0U)
 
 //============================================================================
 void QEvt_refCtr_inc_(QEvt const * const me) noexcept;
+void QEvt_refCtr_incEvt_(QEvt const * const me) noexcept;
 void QEvt_refCtr_dec_(QEvt const * const me) noexcept;
 
 //----------------------------------------------------------------------------
@@ -80,6 +218,9 @@ public:
 #if (QF_MAX_EPOOL > 0U)
     std::array<QF_EPOOL_TYPE_, QF_MAX_EPOOL> ePool_;
     std::uint8_t maxPool_;
+#ifdef QF_EPOOL_LUT_SIZE
+    std::array<std::uint8_t, QF_EPOOL_LUT_SIZE> poolLut_; // size classes
+#endif
 #else
     std::uint8_t dummy;
 #endif // (QF_MAX_EPOOL == 0U)
@@ -0,0 +1,585 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QTSM_HPP_
+#define QTSM_HPP_
+
+#include <type_traits> // std::is_same<>, std::integral_constant<>
+
+// NOTE: this header must be included after "qpcpp.hpp"
+
+namespace QP {
+
+template<class SM_> struct QTTop; // forward declaration
+
+//! @cond INTERNAL
+
+//----------------------------------------------------------------------------
+// compile-time state hierarchy queries, see NOTE1
+
+// is state S_ the same as, or nested inside, state A_?
+template<class S_, class A_>
+struct QTIsIn_ : std::integral_constant<bool,
+    std::is_same<S_, A_>::value
+    || QTIsIn_<typename S_::super, A_>::value> {};
+
+template<class SM_, class A_>
+struct QTIsIn_<QTTop<SM_>, A_> : std::is_same<QTTop<SM_>, A_> {};
+
+// innermost superstate-or-self of S_ that contains T_
+template<class S_, class T_, bool = QTIsIn_<T_, S_>::value>
+struct QTLca_ {
+    using type = S_;
+};
+
+template<class S_, class T_>
+struct QTLca_<S_, T_, false> {
+    using type = typename QTLca_<typename S_::super, T_>::type;
+};
+
+#ifdef Q_SPY
+// QS records of the predefined QEP group (implemented in qep_tsm.cpp)
+class QTsmSpy {
+public:
+    static void stateAct_(std::uint_fast8_t const rec,
+        void const * const obj, QStateHandler const state,
+        std::uint_fast8_t const qsId) noexcept;
+    static void tranSeg_(std::uint_fast8_t const rec,
+        void const * const obj, QStateHandler const src,
+        QStateHandler const trg, std::uint_fast8_t const qsId) noexcept;
+    static void tranAct_(std::uint_fast8_t const rec, QSignal const sig,
+        void const * const obj, QStateHandler const state,
+        std::uint_fast8_t const qsId) noexcept;
+    static void tran0_(std::uint_fast8_t const rec, QSignal const sig,
+        void const * const obj, QStateHandler const state,
+        std::uint_fast8_t const qsId) noexcept;
+    static void topInit_(std::uint_fast8_t const rec,
+        void const * const obj, QStateHandler const trg,
+        std::uint_fast8_t const qsId) noexcept;
+    static void tranEnd_(std::uint_fast8_t const rec, QSignal const sig,
+        void const * const obj, QStateHandler const src,
+        QStateHandler const trg, std::uint_fast8_t const qsId) noexcept;
+}; // class QTsmSpy
+#endif // def Q_SPY
+
+//----------------------------------------------------------------------------
+// statically dispatching event processor for the state machine SM_
+template<class SM_>
+class QTEngine {
+public:
+    using Top = QTTop<SM_>;
+
+    // state handler identifying the state S_ (QHsm-compatible)
+    template<class S_>
+    static constexpr QStateHandler fun_() noexcept {
+        if constexpr (std::is_same<S_, Top>::value) {
+            return &QAsm::top;
+        }
+        else {
+            return &S_::hndl;
+        }
+    }
+
+    // handle event e in state S_ and its superstates (current state Leaf_)
+    template<class S_, class Leaf_>
+    static QState handle_(SM_ &me, QEvt const * const e) {
+        if constexpr (std::is_same<S_, Top>::value) {
+            static_cast<void>(me);
+            static_cast<void>(e);
+            return QAsm::Q_RET_IGNORED; // the top state ignores all events
+        }
+        else {
+            QState r = S_::template handle<Leaf_>(me, e);
+            if (r == QAsm::Q_RET_UNHANDLED) { // unhandled due to a guard?
+#ifdef Q_SPY
+                QTsmSpy::tranAct_(QS_QEP_UNHANDLED, e->sig, &me,
+                    fun_<S_>(), me.m_qsId);
+#endif
+                r = QAsm::Q_RET_SUPER;
+            }
+            if (r == QAsm::Q_RET_SUPER) { // try the superstate (inlined)
+                r = handle_<typename S_::super, Leaf_>(me, e);
+            }
+#ifdef Q_SPY
+            else if (r == QAsm::Q_RET_HANDLED) { // handled in S_?
+                QTsmSpy::tran0_(QS_QEP_INTERN_TRAN, e->sig, &me,
+                    fun_<S_>(), me.m_qsId);
+            }
+#endif
+            else {
+                // empty
+            }
+            return r;
+        }
+    }
+
+    // exit the states from S_ up to (but not including) Lca_
+    template<class S_, class Lca_>
+    static void exit_(SM_ &me) {
+        if constexpr (!std::is_same<S_, Lca_>::value) {
+            if (S_::exit(me) == QAsm::Q_RET_HANDLED) {
+#ifdef Q_SPY
+                QTsmSpy::stateAct_(QS_QEP_STATE_EXIT, &me,
+                    fun_<S_>(), me.m_qsId);
+#endif
+            }
+            exit_<typename S_::super, Lca_>(me);
+        }
+        else {
+            static_cast<void>(me);
+        }
+    }
+
+    // enter the states from (but not including) Lca_ down to T_
+    template<class Lca_, class T_>
+    static void enter_(SM_ &me) {
+        if constexpr (!std::is_same<T_, Lca_>::value) {
+            enter_<Lca_, typename T_::super>(me);
+            if (T_::entry(me) == QAsm::Q_RET_HANDLED) {
+#ifdef Q_SPY
+                QTsmSpy::stateAct_(QS_QEP_STATE_ENTRY, &me,
+                    fun_<T_>(), me.m_qsId);
+#endif
+            }
+        }
+        else {
+            static_cast<void>(me);
+        }
+    }
+
+    // take the initial transitions nested in T_ (already entered)
+    template<class T_>
+    static void drill_(SM_ &me) {
+        if (T_::init(me) != QAsm::Q_RET_TRAN) { // no initial tran. in T_?
+            me.m_state.fun = fun_<T_>(); // T_ becomes the current state
+        }
+    }
+}; // class QTEngine
+
+//! @endcond
+
+//----------------------------------------------------------------------------
+// top state of the state machine SM_ (superstate of all states)
+template<class SM_>
+struct QTTop {
+    using sm = SM_;
+
+    // superstate of the top-level QMStateDef<> states (none)
+    static constexpr QMState const *objPtr() noexcept {
+        return nullptr;
+    }
+}; // struct QTTop
+
+//----------------------------------------------------------------------------
+// base of the states of SM_; the state Self_ is nested in Super_, see NOTE1
+template<class SM_, class Self_, class Super_ = QTTop<SM_>>
+struct QTState {
+    using sm    = SM_;
+    using super = Super_;
+
+    // defaults (hidden by the same names in Self_)...
+    static QState entry(SM_ &me) noexcept {
+        static_cast<void>(me);
+        return QAsm::Q_RET_SUPER;     // no entry action
+    }
+    static QState exit(SM_ &me) noexcept {
+        static_cast<void>(me);
+        return QAsm::Q_RET_SUPER;     // no exit action
+    }
+    static QState init(SM_ &me) noexcept {
+        static_cast<void>(me);
+        return QAsm::Q_RET_SUPER;     // no initial transition
+    }
+    template<class Leaf_>
+    static QState handle(SM_ &me, QEvt const * const e) noexcept {
+        static_cast<void>(me);
+        static_cast<void>(e);
+        return QAsm::Q_RET_SUPER;     // all events handled by the superstate
+    }
+
+    // state handler identifying this state, see NOTE2
+    static QState hndl(void * const me, QEvt const * const e) {
+        SM_ &sm_ = *static_cast<SM_ *>(me);
+        if (e->sig == QAsm::Q_EMPTY_SIG) { // superstate query?
+            sm_.m_temp.fun = QTEngine<SM_>::template fun_<Super_>();
+            return QAsm::Q_RET_SUPER;
+        }
+        // statically dispatch e with Self_ as the current state
+        return QTEngine<SM_>::template handle_<Self_, Self_>(sm_, e);
+    }
+
+protected:
+    static constexpr QState Q_HANDLED() {
+        return QAsm::Q_RET_HANDLED;   }
+    static constexpr QState Q_UNHANDLED() {
+        return QAsm::Q_RET_UNHANDLED; }
+    static constexpr QState Q_SUPER() {
+        return QAsm::Q_RET_SUPER;     }
+
+    // tran. from this state to Trg_ (called in handle<Leaf_>), see NOTE3
+    template<class Leaf_, class Trg_>
+    static QState tran(SM_ &me) {
+        static_assert(QTIsIn_<Leaf_, Self_>::value,
+            "the current state must be nested in the tran. source");
+        static_assert(QTIsIn_<Trg_, QTTop<SM_>>::value
+            && !std::is_same<Trg_, QTTop<SM_>>::value,
+            "the tran. target must be a state of the same state machine");
+
+        // least common ancestor (the superstate for a self-tran.)
+        using Lca = typename std::conditional<std::is_same<Self_, Trg_>::value,
+            Super_, typename QTLca_<Self_, Trg_>::type>::type;
+
+#ifdef Q_SPY
+        // NOTE: not in m_temp, which isIn() in the entry actions overwrites
+        me.m_tranSrc = QTEngine<SM_>::template fun_<Self_>(); // tran. source
+#endif
+        QTEngine<SM_>::template exit_<Leaf_, Lca>(me);
+        QTEngine<SM_>::template enter_<Lca, Trg_>(me);
+        QTEngine<SM_>::template drill_<Trg_>(me);
+        return QAsm::Q_RET_TRAN;
+    }
+
+    // initial tran. from this state to Trg_ (called in init())
+    template<class Trg_>
+    static QState tran_init(SM_ &me) {
+        static_assert(QTIsIn_<Trg_, Self_>::value
+            && !std::is_same<Trg_, Self_>::value,
+            "the initial tran. target must be nested in the source");
+#ifdef Q_SPY
+        QTsmSpy::tranSeg_(QS_QEP_STATE_INIT, &me,
+            QTEngine<SM_>::template fun_<Self_>(),
+            QTEngine<SM_>::template fun_<Trg_>(), me.m_qsId);
+#endif
+        QTEngine<SM_>::template enter_<Self_, Trg_>(me);
+        QTEngine<SM_>::template drill_<Trg_>(me);
+        return QAsm::Q_RET_TRAN;
+    }
+
+    // friends...
+    template<class SMx_, class Base_> friend class QTsm;
+}; // struct QTState
+
+//----------------------------------------------------------------------------
+// state machine SM_ with compile-time hierarchy executed as Base_
+// (QHsm for passive state machines, QActive for active objects)
+template<class SM_, class Base_>
+class QTsm : public Base_ {
+public:
+#ifdef Q_SPY
+    QStateHandler m_tranSrc; // source of the last tran. (for QS only)
+    std::uint8_t m_qsId; // QS-id of the current init()/dispatch()
+#endif
+
+    using Base_::init;
+    void init(
+        void const * const e,
+        std::uint_fast8_t const qsId) override
+    {
+#ifdef Q_SPY
+        m_qsId = static_cast<std::uint8_t>(qsId);
+#else
+        Q_UNUSED_PAR(qsId);
+#endif
+        // the top-most initial tran. provided by the state machine SM_
+        QState const r = SM_::initial(*static_cast<SM_ *>(this), e);
+
+#ifndef Q_UNSAFE
+        if (r != QAsm::Q_RET_TRAN) { // top-most initial tran. not taken?
+            QF_CRIT_EST();
+            Q_onError("qtsm", 240);
+        }
+#else
+        Q_UNUSED_PAR(r);
+#endif
+#ifdef Q_SPY
+        QTsmSpy::topInit_(QS_QEP_INIT_TRAN, this, this->m_state.fun, m_qsId);
+#endif
+    }
+    void dispatch(
+        QEvt const * const e,
+        std::uint_fast8_t const qsId) override
+    {
+        QStateHandler const s = this->m_state.fun; // current state
+#ifdef Q_SPY
+        m_qsId = static_cast<std::uint8_t>(qsId);
+        QTsmSpy::tran0_(QS_QEP_DISPATCH, e->sig, this, s, m_qsId);
+#else
+        Q_UNUSED_PAR(qsId);
+#endif
+        // the only indirect call, the rest is resolved at compile time
+        QState const r = (*s)(static_cast<SM_ *>(this), e);
+
+#ifdef Q_SPY
+        if (r == QAsm::Q_RET_TRAN) { // tran. taken?
+            QTsmSpy::tranEnd_(QS_QEP_TRAN, e->sig, this,
+                m_tranSrc, this->m_state.fun, m_qsId);
+        }
+        else if (r == QAsm::Q_RET_IGNORED) { // event ignored?
+            QTsmSpy::tran0_(QS_QEP_IGNORED, e->sig, this, s, m_qsId);
+        }
+        else {
+            // empty (internal tran. traced in QTEngine::handle_())
+        }
+#else
+        Q_UNUSED_PAR(r);
+#endif
+    }
+    bool isIn(QStateHandler const stateHndl) noexcept override {
+        static constexpr QEvt emptyEvt(QAsm::Q_EMPTY_SIG);
+        bool inState = false; // assume that this SM is NOT in 'stateHndl'
+        QStateHandler s = this->m_state.fun;
+        QState r;
+        do {
+            if (s == stateHndl) { // do the states match?
+                inState = true;
+                break;
+            }
+            r = (*s)(static_cast<SM_ *>(this), &emptyEvt); // superstate
+            s = this->m_temp.fun;
+        } while (r == QAsm::Q_RET_SUPER);
+        return inState;
+    }
+    QStateHandler getStateHandler() const noexcept override {
+        return this->m_state.fun;
+    }
+
+protected:
+    explicit QTsm() noexcept
+      : Base_(nullptr) // initial tran. provided by SM_::initial()
+    {
+        if constexpr (std::is_base_of<QActive, Base_>::value) {
+            // bind the static dispatch (NOTE2 in qf_qact.cpp)
+            this->setDispatch_(&QActive::dispatchStatic_<SM_>);
+        }
+    }
+
+    // top-most initial tran. to Trg_ (called in SM_::initial())
+    template<class Trg_>
+    static QState tran_init(SM_ &me) {
+        return QTState<SM_, QTTop<SM_>>::template tran_init<Trg_>(me);
+    }
+}; // class QTsm
+
+template<class SM_>
+using QTHsm = QTsm<SM_, QHsm>;
+
+template<class SM_>
+using QTActive = QTsm<SM_, QActive>;
+
+//----------------------------------------------------------------------------
+// compile-time QMsm state and transition-action tables, see NOTE4
+
+// state of a QMsm with the given handlers nested in Super_ (QTTop<SM_>
+// for the top-level states of the QMsm subclass SM_)
+template<class Super_,
+    QStateHandler  state_,
+    QActionHandler entry_ = nullptr,
+    QActionHandler exit_  = nullptr,
+    QActionHandler init_  = nullptr>
+struct QMStateDef {
+    using super = Super_;
+
+    static constexpr QMState obj {
+        Super_::objPtr(), state_, entry_, exit_, init_
+    };
+    static constexpr QMState const *objPtr() noexcept {
+        return &obj;
+    }
+}; // struct QMStateDef
+
+// transition-action table (layout of QMTranActTable with N_ actions)
+template<std::size_t N_>
+struct QMTranActs {
+    QMState const *target;
+    std::array<QActionHandler, N_> act;
+};
+
+//! @cond INTERNAL
+
+// table of actions: exits from Exit_ up to Lca_ (excluding), entries
+// from Lca_ (excluding) down to Trg_, and the initial tran. of Trg_
+template<class Lca_, class Exit_, class Trg_>
+class QMTatblMaker_ {
+    template<class S_, class Stop_>
+    static constexpr std::size_t exits_() noexcept {
+        if constexpr (std::is_same<S_, Stop_>::value) {
+            return 0U;
+        }
+        else {
+            return ((S_::obj.exitAction != nullptr) ? 1U : 0U)
+                   + exits_<typename S_::super, Stop_>();
+        }
+    }
+    template<class S_, class Stop_>
+    static constexpr std::size_t entries_() noexcept {
+        if constexpr (std::is_same<S_, Stop_>::value) {
+            return 0U;
+        }
+        else {
+            return ((S_::obj.entryAction != nullptr) ? 1U : 0U)
+                   + entries_<typename S_::super, Stop_>();
+        }
+    }
+
+public:
+    static constexpr std::size_t N_ = exits_<Exit_, Lca_>()
+        + entries_<Trg_, Lca_>()
+        + ((Trg_::obj.initAction != nullptr) ? 1U : 0U)
+        + 1U; // terminating nullptr
+
+private:
+    template<class S_>
+    static constexpr std::size_t addExits_(QMTranActs<N_> &t,
+        std::size_t i) noexcept
+    {
+        if constexpr (!std::is_same<S_, Lca_>::value) {
+            if (S_::obj.exitAction != nullptr) {
+                t.act[i] = S_::obj.exitAction;
+                ++i;
+            }
+            i = addExits_<typename S_::super>(t, i);
+        }
+        return i;
+    }
+    template<class S_>
+    static constexpr std::size_t addEntries_(QMTranActs<N_> &t,
+        std::size_t i) noexcept
+    {
+        if constexpr (!std::is_same<S_, Lca_>::value) {
+            i = addEntries_<typename S_::super>(t, i); // outermost first
+            if (S_::obj.entryAction != nullptr) {
+                t.act[i] = S_::obj.entryAction;
+                ++i;
+            }
+        }
+        return i;
+    }
+public:
+    static constexpr QMTranActs<N_> make_() noexcept {
+        QMTranActs<N_> t { &Trg_::obj, {} };
+        std::size_t i = addExits_<Exit_>(t, 0U);
+        i = addEntries_<Trg_>(t, i);
+        if (Trg_::obj.initAction != nullptr) {
+            t.act[i] = Trg_::obj.initAction;
+            ++i;
+        }
+        t.act[i] = nullptr; // terminate the table
+        return t;
+    }
+}; // class QMTatblMaker_
+
+template<class Lca_, class Exit_, class Trg_>
+struct QMTatbl_ {
+    using Maker = QMTatblMaker_<Lca_, Exit_, Trg_>;
+    static constexpr QMTranActs<Maker::N_> tatbl = Maker::make_();
+}; // struct QMTatbl_
+
+// least common ancestor of a tran. (the superstate for a self-tran.)
+template<class Src_, class Trg_>
+using QMTranLca_ = typename std::conditional<std::is_same<Src_, Trg_>::value,
+    typename Src_::super, typename QTLca_<Src_, Trg_>::type>::type;
+
+//! @endcond
+
+// transition-action table for the tran. from Src_ to Trg_
+// (usage: return qm_tran(&QP::QMTran<S1, S2>::tatbl);)
+template<class Src_, class Trg_>
+struct QMTran : public QMTatbl_<QMTranLca_<Src_, Trg_>, Src_, Trg_> {
+}; // struct QMTran
+
+// transition-action table for the initial tran. from Src_ to Trg_
+// (usage: return qm_tran_init(&QP::QMTranInit<S1, S11>::tatbl);)
+template<class Src_, class Trg_>
+struct QMTranInit : public QMTatbl_<Src_, Src_, Trg_> {
+    static_assert(QTIsIn_<Trg_, Src_>::value
+        && !std::is_same<Trg_, Src_>::value,
+        "the initial tran. target must be nested in the source");
+}; // struct QMTranInit
+
+} // namespace QP
+
+//============================================================================
+// NOTE1:
+// In a QTsm state machine the states are types and the state hierarchy is
+// known to the compiler. Every state derives from QTState<SM_, Self_,
+// Super_> and provides (hides) any of the static functions entry(), exit(),
+// init(), and handle<Leaf_>(), where Leaf_ is the current state on whose
+// behalf the event is handled. Unhandled events (Q_SUPER()/Q_UNHANDLED())
+// fall through to handle<Leaf_>() of the superstate, which the compiler
+// inlines, so an event costs a single indirect call through m_state.
+// The exit and entry chains of a transition are computed from the types
+// Leaf_, Self_ and Trg_ and are also fully inlined. The transitions have
+// the same semantics as in QHsm (actions before exits, local transitions
+// to superstates and substates, self-transitions exit and re-enter the
+// source). History transitions are not supported.
+//
+// The state machine class SM_ derives from QTHsm<SM_> or QTActive<SM_> and
+// provides the top-most initial transition as a public static function
+// QState initial(SM_ &me, void const * const e) that returns
+// tran_init<Trg_>(me). QTActive<SM_> is an ordinary QActive, so it is
+// started, posted to, and scheduled exactly like any other active object.
+// With QACTIVE_STATIC_DISPATCH, the kernels call QTsm::dispatch() without
+// the vtable, so the whole state machine is inlined into the event loop.
+//
+// NOTE2:
+// The static function QTState::hndl() has the signature of a QHsm state
+// handler and identifies the state at run time. It is what m_state holds,
+// what state() and getStateHandler() return, what isIn() takes, and what
+// the QS trace records (e.g., QS_FUN_DICTIONARY(&Blinky::Off::hndl)).
+// The hndl() functions answer the Q_EMPTY_SIG superstate query, so the
+// inherited QHsm::childState() and QActive::childState() work as usual.
+//
+// NOTE3:
+// The functions of the states are static and receive the state machine as
+// the 'me' reference. The transition functions must be called in the state
+// that "owns" the transition (Self_), so that the source is known, e.g.:
+// return tran<Leaf_, On>(me);
+//
+// NOTE4:
+// QMStateDef<>, QMTran<> and QMTranInit<> produce the constant data of an
+// ordinary QMsm (or QMActive) without the QM code generator. The states are
+// described by types derived from QMStateDef<Super_, state, entry, exit,
+// init>, which are nested in the QMsm subclass after the static state- and
+// action-handlers (Q_STATE_DECL(), QM_ACTION_DECL()), outer states first:
+//
+//     using Top = QP::QTTop<Blinky>;
+//     struct Off : QP::QMStateDef<Top, &off, &off_e> {};
+//     struct On  : QP::QMStateDef<Top, &on, &on_e, &on_x> {};
+//
+// The QMState of such a state is the constexpr member obj (e.g., in the
+// entry action: return qm_entry(&Off::obj);). The transition-action table
+// of every transition is a constexpr object computed by the compiler from
+// the source and target types with the same semantics as in QHsm:
+// return qm_tran(&QP::QMTran<Off, On>::tatbl); in the state handler of the
+// source and return qm_tran_init(&QP::QMTranInit<Top, Off>::tatbl); in the
+// top-most initial tran. or in the init action of a composite state. The
+// tables have the layout of QMTranActTable and are placed in ROM, so the
+// QMsm event processor executes them exactly as the generated code.
+//
+
+#endif // QTSM_HPP_
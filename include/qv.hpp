@@ -71,6 +71,10 @@ public:
 #define QF_EPOOL_GET_(p_, e_, m_, qsId_) \
     ((e_) = static_cast<QEvt *>((p_).get((m_), (qsId_))))
 #define QF_EPOOL_PUT_(p_, e_, qsId_) ((p_).put((e_), (qsId_)))
+#define QF_EPOOL_GET_BATCH_(p_, blocks_, n_, m_, qsId_, nGot_) \
+    ((nGot_) = (p_).getBatch((blocks_), (n_), (m_), (qsId_)))
+#define QF_EPOOL_PUT_BATCH_(p_, blocks_, n_, qsId_) \
+    ((p_).putBatch((blocks_), (n_), (qsId_)))
 #define QF_EPOOL_USE_(ePool_)   ((ePool_)->getUse())
 #define QF_EPOOL_FREE_(ePool_)  ((ePool_)->getFree())
 #define QF_EPOOL_MIN_(ePool_)   ((ePool_)->getMin())
@@ -45,6 +45,14 @@
     #error FreeRTOS configMAX_PRIORITIES must not be less than QF_MAX_ACTIVE
 #endif
 
+#ifdef QF_TIMEEVT_WHEEL
+    #error QTimeEvt::tickFromISR() in this port does not support QF_TIMEEVT_WHEEL
+#endif
+
+#if (QF_MAX_ACTIVE > 64U)
+    #error FreeRTOS port supports QF_MAX_ACTIVE of up to 64U
+#endif
+
 //============================================================================
 namespace { // anonymous namespace with local definitions
 
@@ -0,0 +1,374 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#define QP_IMPL             // this is QP implementation
+#include "qp_port.hpp"      // QP port
+#include "qp_pkg.hpp"       // QP package-scope interface
+#include "qsafe.h"          // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY                // QS software tracing enabled?
+    #include "qs_port.hpp"  // QS port
+    #include "qs_pkg.hpp"   // QS package-scope internal interface
+#else
+    #include "qs_dummy.hpp" // disable the QS software tracing
+#endif // Q_SPY
+
+#ifdef QF_TIMEEVT_TICKLESS  // tickless deadline time events?
+
+#ifndef __linux__
+    #error QF_TIMEEVT_TICKLESS requires the Linux timerfd
+#endif
+
+#ifndef QF_TIMEEVT_HEAP_SIZE
+    #define QF_TIMEEVT_HEAP_SIZE 256U
+#endif
+
+#include <pthread.h>         // for pthread_mutex_t
+#include <sys/timerfd.h>    // for timerfd_create()/timerfd_settime()
+#include <time.h>           // for clock_gettime()
+#include <unistd.h>         // for read()
+
+namespace { // unnamed local namespace
+
+Q_DEFINE_THIS_MODULE("qf_tickless")
+
+// Local objects =============================================================
+constexpr std::uint64_t NSEC_PER_SEC {1000000000U};
+constexpr std::uint64_t NO_DEADLINE  {~static_cast<std::uint64_t>(0U)};
+
+// the deadline heap and the timerfd (all protected by l_heapMutex)
+static pthread_mutex_t l_heapMutex = PTHREAD_MUTEX_INITIALIZER;
+static QP::QTimeEvt *l_heap[QF_TIMEEVT_HEAP_SIZE + 1U]; // 1-based min-heap
+static std::uint32_t l_heapLen;     // number of time events in the heap
+static int l_timerFd = -1;          // the timerfd for all deadlines
+static std::uint64_t l_timerAt;     // deadline programmed in the timerfd
+static bool l_wakeUp;               // QTickless::wake() request pending
+
+} // unnamed local namespace
+
+//============================================================================
+namespace QP {
+
+//............................................................................
+void QTimeEvt::armAt(
+    std::uint64_t const deadline,
+    std::uint64_t const period) noexcept
+{
+    QF_CRIT_STAT
+    QF_TIME_CRIT_ENTRY_(m_tickRate);
+
+    // the time event must not be already armed
+    Q_REQUIRE_INCRIT(100, m_ctr == 0U);
+
+    // the AO associated with this time event must be valid
+    Q_REQUIRE_INCRIT(110, m_act != nullptr);
+
+    // the tick rate of this time event must be in range (lock domain)
+    Q_REQUIRE_INCRIT(120, m_tickRate < QF_MAX_TICK_RATE);
+
+    m_ctr = 1U; // armed (the tick counter is NOT used for deadlines)
+    m_interval = 0U;
+    m_flags |= QTE_FLAG_IS_DEADLINE;
+
+    pthread_mutex_lock(&l_heapMutex);
+    m_deadline = deadline;
+    m_period   = period;
+    QTickless::schedule_(this);
+    pthread_mutex_unlock(&l_heapMutex);
+
+    // the same record as QTimeEvt::armX(), see NOTE3
+    QS_BEGIN_PRE(QS_QF_TIMEEVT_ARM,
+            static_cast<QActive const *>(m_act)->m_prio)
+        QS_TIME_PRE();        // timestamp
+        QS_OBJ_PRE(this);     // this time event object
+        QS_OBJ_PRE(m_act);    // the active object
+        QS_TEC_PRE(m_ctr);    // the # ticks
+        QS_TEC_PRE(m_interval); // the interval
+        QS_U8_PRE(m_tickRate);  // tick rate
+    QS_END_PRE()
+
+    QF_TIME_CRIT_EXIT_(m_tickRate);
+}
+//............................................................................
+void QTimeEvt::armIn(
+    std::uint64_t const nsec,
+    std::uint64_t const period) noexcept
+{
+    armAt(QTickless::now() + nsec, period);
+}
+
+//============================================================================
+//............................................................................
+void QTickless::init() noexcept {
+    l_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    l_heapLen = 0U;
+    l_timerAt = NO_DEADLINE;
+    l_wakeUp  = false;
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_ASSERT_INCRIT(200, l_timerFd >= 0); // the timerfd must be created
+    QF_CRIT_EXIT();
+}
+//............................................................................
+std::uint64_t QTickless::now() noexcept {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (static_cast<std::uint64_t>(ts.tv_sec) * NSEC_PER_SEC)
+           + static_cast<std::uint64_t>(ts.tv_nsec);
+}
+//............................................................................
+bool QTickless::wait(
+    std::uint64_t &nextTick,
+    std::uint64_t const period) noexcept
+{
+    // program the timerfd for the earliest of the next tick and deadline
+    pthread_mutex_lock(&l_heapMutex);
+    std::uint64_t at = (period != 0U) ? nextTick : NO_DEADLINE;
+    if ((l_heapLen > 0U) && (l_heap[1]->m_deadline < at)) {
+        at = l_heap[1]->m_deadline;
+    }
+    if (l_wakeUp) { // wake() requested?
+        l_wakeUp = false;
+        at = 1U; // already in the past
+    }
+    program_(at);
+    pthread_mutex_unlock(&l_heapMutex);
+
+    // block until the timerfd expires, see NOTE1
+    std::uint64_t nExp;
+    ssize_t const n = read(l_timerFd, &nExp, sizeof(nExp));
+    Q_UNUSED_PAR(n);
+
+    std::uint64_t const t = now();
+    expire_(t); // post all the deadline time events due by now
+
+    bool tickDue = false;
+    if ((period != 0U) && (t >= nextTick)) { // clock tick due?
+        nextTick += period;
+        tickDue = true;
+    }
+    return tickDue;
+}
+//............................................................................
+void QTickless::wake() noexcept {
+    pthread_mutex_lock(&l_heapMutex);
+    l_wakeUp = true;
+    program_(1U); // already in the past
+    pthread_mutex_unlock(&l_heapMutex);
+}
+//............................................................................
+bool QTickless::isDeadline(QTimeEvt const &te) noexcept {
+    QF_CRIT_STAT
+    QF_TIME_CRIT_ENTRY_(te.m_tickRate);
+    bool const isDl = (te.m_ctr != 0U)
+                      && ((te.m_flags & QTE_FLAG_IS_DEADLINE) != 0U);
+    QF_TIME_CRIT_EXIT_(te.m_tickRate);
+    return isDl;
+}
+
+//............................................................................
+void QTickless::schedule_(QTimeEvt * const te) noexcept {
+    // NOTE: this helper function is called *inside* the time-event
+    // critical section and with l_heapMutex locked
+    std::uint32_t idx = te->m_heapIdx;
+    if (idx == 0U) { // not in the heap yet?
+        // the deadline heap must not overflow
+        Q_ASSERT_INCRIT(300, l_heapLen < QF_TIMEEVT_HEAP_SIZE);
+
+        ++l_heapLen;
+        idx = l_heapLen;
+        l_heap[idx] = te;
+        te->m_heapIdx = idx;
+        siftUp_(idx);
+    }
+    else { // stale entry of a disarmed time event, see NOTE2
+        siftUp_(idx);
+        siftDown_(te->m_heapIdx);
+    }
+
+    // new earliest deadline?
+    if (te->m_deadline < l_timerAt) {
+        program_(te->m_deadline);
+    }
+}
+//............................................................................
+QTimeEvt *QTickless::pop_(std::uint64_t const now) noexcept {
+    // NOTE: this helper function is called with l_heapMutex locked
+    QTimeEvt *te = nullptr;
+    if ((l_heapLen > 0U) && (l_heap[1]->m_deadline <= now)) {
+        te = l_heap[1];
+        te->m_heapIdx = 0U;
+        l_heap[1] = l_heap[l_heapLen];
+        --l_heapLen;
+        if (l_heapLen > 0U) {
+            l_heap[1]->m_heapIdx = 1U;
+            siftDown_(1U);
+        }
+    }
+    return te;
+}
+//............................................................................
+void QTickless::siftUp_(std::uint32_t idx) noexcept {
+    QTimeEvt * const te = l_heap[idx];
+    while (idx > 1U) {
+        QTimeEvt * const parent = l_heap[idx / 2U];
+        if (parent->m_deadline <= te->m_deadline) {
+            break;
+        }
+        l_heap[idx] = parent;
+        parent->m_heapIdx = idx;
+        idx /= 2U;
+    }
+    l_heap[idx] = te;
+    te->m_heapIdx = idx;
+}
+//............................................................................
+void QTickless::siftDown_(std::uint32_t idx) noexcept {
+    QTimeEvt * const te = l_heap[idx];
+    for (;;) {
+        std::uint32_t child = idx * 2U;
+        if (child > l_heapLen) {
+            break;
+        }
+        if ((child < l_heapLen)
+            && (l_heap[child + 1U]->m_deadline < l_heap[child]->m_deadline))
+        {
+            ++child;
+        }
+        if (te->m_deadline <= l_heap[child]->m_deadline) {
+            break;
+        }
+        l_heap[idx] = l_heap[child];
+        l_heap[idx]->m_heapIdx = idx;
+        idx = child;
+    }
+    l_heap[idx] = te;
+    te->m_heapIdx = idx;
+}
+//............................................................................
+void QTickless::program_(std::uint64_t const deadline) noexcept {
+    // NOTE: this helper function is called with l_heapMutex locked
+    struct itimerspec its {};
+    if (deadline != NO_DEADLINE) {
+        its.it_value.tv_sec  = static_cast<time_t>(deadline / NSEC_PER_SEC);
+        its.it_value.tv_nsec = static_cast<long>(deadline % NSEC_PER_SEC);
+    }
+    // else: all-zero it_value disarms the timerfd
+    timerfd_settime(l_timerFd, TFD_TIMER_ABSTIME, &its, nullptr);
+    l_timerAt = deadline;
+}
+//............................................................................
+void QTickless::expire_(std::uint64_t const now) noexcept {
+    for (;;) {
+        pthread_mutex_lock(&l_heapMutex);
+        QTimeEvt * const te = pop_(now);
+        pthread_mutex_unlock(&l_heapMutex);
+        if (te == nullptr) { // no more deadlines due?
+            break;
+        }
+
+        QF_CRIT_STAT
+        QF_TIME_CRIT_ENTRY_(te->m_tickRate);
+
+        QActive * const act = te->toActive();
+
+        // still armed for this deadline? (not disarmed or re-armed)
+        bool const isDue = (te->m_ctr != 0U)
+            && ((te->m_flags & QTE_FLAG_IS_DEADLINE) != 0U)
+            && (te->m_heapIdx == 0U)
+            && (te->m_deadline <= now);
+        if (isDue) {
+            if (te->m_period != 0U) { // periodic?
+                pthread_mutex_lock(&l_heapMutex);
+                te->m_deadline += te->m_period; // no drift
+                if (te->m_deadline <= now) { // overrun? skip missed periods
+                    te->m_deadline += (((now - te->m_deadline) / te->m_period)
+                                       + 1U) * te->m_period;
+                }
+                schedule_(te);
+                pthread_mutex_unlock(&l_heapMutex);
+            }
+            else { // one-shot: automatically disarm
+                te->m_ctr = 0U;
+
+                QS_BEGIN_PRE(QS_QF_TIMEEVT_AUTO_DISARM, act->m_prio)
+                    QS_OBJ_PRE(te);       // this time event object
+                    QS_OBJ_PRE(act);      // the target AO
+                    QS_U8_PRE(te->m_tickRate); // tick rate
+                QS_END_PRE()
+            }
+
+            QS_BEGIN_PRE(QS_QF_TIMEEVT_POST, act->m_prio)
+                QS_TIME_PRE();            // timestamp
+                QS_OBJ_PRE(te);           // the time event object
+                QS_SIG_PRE(te->sig);      // signal of this time event
+                QS_OBJ_PRE(act);          // the target AO
+                QS_U8_PRE(te->m_tickRate); // tick rate
+            QS_END_PRE()
+        }
+        QF_TIME_CRIT_EXIT_(te->m_tickRate);
+
+        if (isDue) {
+            // act->POST() asserts if the queue overflows
+            act->POST(te, &l_timerFd);
+        }
+    }
+}
+
+} // namespace QP
+
+#endif // QF_TIMEEVT_TICKLESS
+
+//============================================================================
+// NOTE1:
+// The timerfd is always programmed with an absolute CLOCK_MONOTONIC time, so
+// a deadline that has already passed makes the read() return immediately.
+// QTimeEvt::armAt() re-programs the timerfd (under the heap mutex) only when
+// the new deadline is earlier than the one currently programmed, which
+// wakes up the blocked read() early. Spurious wake-ups are harmless, because
+// QTickless::wait() always re-checks the heap against the current time.
+// A periodic deadline time event that has missed some of its periods (e.g.,
+// when the timer thread was not scheduled in time) is posted only once and
+// the missed periods are skipped, similar to the timerfd overrun count.
+//
+// NOTE2:
+// QTimeEvt::disarm() is the generic operation, which only clears the
+// time event counter, so the disarmed deadline time event stays in the heap
+// until its (stale) deadline comes and it is discarded. If the time event
+// is armed again before that, its stale heap entry is simply moved to the
+// new deadline, so every time event is in the heap at most once.
+//
+// NOTE3:
+// The deadline time events produce the same QS trace records as the
+// tick-based time events: QS_QF_TIMEEVT_ARM in QTimeEvt::armAt(),
+// QS_QF_TIMEEVT_DISARM from the generic QTimeEvt::disarm(), and
+// QS_QF_TIMEEVT_AUTO_DISARM/QS_QF_TIMEEVT_POST when a deadline expires.
+// The nanosecond deadline does not fit the tick counter fields of these
+// records, so they report the time event counters (1 and 0 for an armed
+// deadline time event) instead.
+//
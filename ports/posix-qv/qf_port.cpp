@@ -60,6 +60,10 @@ Q_DEFINE_THIS_MODULE("qf_port")
 static bool l_isRunning;       // flag indicating when QF is running
 static struct timespec l_tick; // structure for the clock tick
 static int_t l_tickPrio;       // priority of the ticker thread
+#ifdef QACTIVE_EQUEUE_SPIN
+static QP::QSpinWait l_spin;   // event-loop spinning, NOTE4 in qp_port.hpp
+static std::uint32_t l_maxSpin; // max. spin time of l_spin [us]
+#endif
 
 constexpr long NSEC_PER_SEC {1000000000L};
 constexpr long DEFAULT_TICKS_PER_SEC {100L};
@@ -107,6 +111,23 @@ static void *ticker_thread(void *arg); // prototype
 static void *ticker_thread(void *arg) { // for pthread_create()
     Q_UNUSED_PAR(arg);
 
+#ifdef QF_TIMEEVT_TICKLESS
+    // clock tick and deadline time events from timerfd, NOTE3 in qp_port.hpp
+    std::uint64_t const period =
+        (static_cast<std::uint64_t>(l_tick.tv_sec) * NSEC_PER_SEC)
+        + static_cast<std::uint64_t>(l_tick.tv_nsec);
+    std::uint64_t nextTick = QP::QTickless::now();
+    if (period != 0U) {
+        // round down to the nearest configured period and advance
+        nextTick = ((nextTick / period) + 1U) * period;
+    }
+    while (l_isRunning) { // the timer loop...
+        if (QP::QTickless::wait(nextTick, period)) { // clock tick due?
+            // clock tick callback (must call QTimeEvt::TICK_X())
+            QP::QF::onClockTick();
+        }
+    }
+#else
     // system clock tick must be configured
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
@@ -137,6 +158,7 @@ static void *ticker_thread(void *arg) { // for pthread_create()
             QP::QF::onClockTick();
         }
     }
+#endif // QF_TIMEEVT_TICKLESS
     return nullptr; // return success
 }
 //............................................................................
@@ -155,6 +177,9 @@ namespace QF {
 
 QPSet readySet_;
 pthread_cond_t condVar_; // cond.var. to signal events
+#ifdef QACTIVE_EQUEUE_SPIN
+bool readyHint_;         // readySet_ might be not empty (for spinning)
+#endif
 
 //============================================================================
 // QF functions
@@ -197,6 +222,10 @@ void init() {
     l_tick.tv_nsec = NSEC_PER_SEC / DEFAULT_TICKS_PER_SEC; // default rate
     l_tickPrio = sched_get_priority_min(SCHED_FIFO); // default ticker prio
 
+#ifdef QF_TIMEEVT_TICKLESS
+    QTickless::init(); // the timerfd for the deadline time events
+#endif
+
     // install the SIGINT (Ctrl-C) signal handler
     struct sigaction sig_act;
     memset(&sig_act, 0, sizeof(sig_act));
@@ -222,7 +251,11 @@ int run() {
     QF_CRIT_EXIT();
 
     // system clock tick configured?
-    if ((l_tick.tv_sec != 0) || (l_tick.tv_nsec != 0)) {
+    bool needTicker = (l_tick.tv_sec != 0) || (l_tick.tv_nsec != 0);
+#ifdef QF_TIMEEVT_TICKLESS
+    needTicker = true; // the ticker thread serves also the deadlines
+#endif
+    if (needTicker) {
 
         pthread_attr_t attr;
         pthread_attr_init(&attr);
@@ -268,7 +301,7 @@ int run() {
     while (l_isRunning) {
         // find the maximum priority AO ready to run
         if (readySet_.notEmpty()) {
-            std::uint_fast8_t p = readySet_.findMax();
+            QPrio p = static_cast<QPrio>(readySet_.findMax());
             QActive *a = QActive_registry_[p];
 
             // the active object 'a' must still be registered in QF
@@ -276,11 +309,30 @@ int run() {
             Q_ASSERT_INCRIT(320, a != nullptr);
             QF_CRIT_EXIT();
 
+#ifndef QF_DISPATCH_QUOTA
             QEvt const * const e = a->get_(); // NO blocking (not empty)
-            a->dispatch(e, a->getPrio()); // virtual call
+            a->dispatch_(&e, 1U); // virtual or static, NOTE2 in qf_qact.cpp
 #if (QF_MAX_EPOOL > 0U)
             QF::gc(e); // check if the event is garbage, and collect it if so
 #endif
+#else // drain up to QF_DISPATCH_QUOTA events (NOTE1 in qf_actq.cpp)
+            QEvt const *evts[QF_DISPATCH_QUOTA];
+            std::uint_fast16_t const n =
+                a->getBatch_(&evts[0], QF_DISPATCH_QUOTA); // NO blocking
+#ifdef QACTIVE_CAN_STOP
+            for (std::uint_fast16_t i = 0U; i < n; ++i) {
+                if (QActive_registry_[p] != a) { // AO stopped itself?
+                    break; // the rest of the batch is only garbage-collected
+                }
+                a->dispatch_(&evts[i], 1U);
+            }
+#else
+            a->dispatch_(&evts[0], n); // the whole batch
+#endif
+#if (QF_MAX_EPOOL > 0U)
+            QF::gcBatch_(&evts[0], n); // collect the garbage events
+#endif
+#endif // QF_DISPATCH_QUOTA
 
             QF_CRIT_ENTRY();
             if (a->m_eQueue.isEmpty()) { // empty queue?
@@ -292,6 +344,17 @@ int run() {
             // callback. However, the POSIX-QV port does not do busy-waiting
             // for events. Instead, the POSIX-QV port efficiently waits until
             // QP events become available.
+#ifdef QACTIVE_EQUEUE_SPIN
+            // ...unless an AO requested spinning, see NOTE4 in qp_port.hpp
+            if (l_spin.begin()) {
+                readyHint_ = false; // set again by QACTIVE_EQUEUE_SIGNAL_()
+                QF_CRIT_EXIT();
+                l_spin.spin([]() noexcept {
+                    return __atomic_load_n(&readyHint_, __ATOMIC_ACQUIRE);
+                });
+                QF_CRIT_ENTRY();
+            }
+#endif
             while (readySet_.isEmpty()) {
                 Q_ASSERT_INCRIT(390, l_critSectNest == 1);
                 --l_critSectNest;
@@ -301,6 +364,9 @@ int run() {
                 Q_ASSERT_INCRIT(391, l_critSectNest == 0);
                 ++l_critSectNest;
             }
+#ifdef QACTIVE_EQUEUE_SPIN
+            l_spin.end();
+#endif
         }
     }
     QF_CRIT_EXIT();
@@ -318,7 +384,13 @@ void stop() {
 
     // unblock the event-loop so it can terminate
     readySet_.insert(1U);
+#ifdef QACTIVE_EQUEUE_SPIN
+    __atomic_store_n(&readyHint_, true, __ATOMIC_RELEASE);
+#endif
     pthread_cond_signal(&condVar_);
+#ifdef QF_TIMEEVT_TICKLESS
+    QTickless::wake(); // unblock the ticker thread so it can terminate
+#endif
 }
 //............................................................................
 void setTickRate(std::uint32_t ticksPerSec, int tickPrio) {
@@ -390,7 +462,7 @@ void QActive::start(QPrioSpec const prioSpec,
 
     m_eQueue.init(qSto, qLen);
 
-    m_prio  = static_cast<std::uint8_t>(prioSpec & 0xFFU); // QF-priority
+    m_prio  = static_cast<QPrio>(prioSpec); // QF-prio. (low part of prioSpec)
     m_pthre = 0U; // preemption-threshold (not used in this port)
     register_();  // register this AO
 
@@ -398,6 +470,48 @@ void QActive::start(QPrioSpec const prioSpec,
     QS_FLUSH(); // flush the QS trace buffer to the host
 }
 
+//............................................................................
+void QActive::setAttr(std::uint32_t attr1, void const *attr2) {
+    // NOTE: this function must be called *before* QActive::start()
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the AO must not be started yet
+    Q_REQUIRE_INCRIT(900, m_prio == 0U);
+
+    switch (attr1) {
+#ifdef QACTIVE_EQUEUE_SPIN
+        case WAIT_BLOCK_ATTR: // intentionally fall through
+        case WAIT_SPIN_ATTR:  // intentionally fall through
+        case WAIT_POLL_ATTR: {
+            // all AOs share the event-loop, which takes the most aggressive
+            // waiting policy of all AOs (POLL > SPIN > BLOCK), NOTE4
+            std::uint32_t const maxSpin = (attr2 != nullptr)
+                ? *static_cast<std::uint32_t const *>(attr2)
+                : QSpinWait::DEFAULT_MAX_SPIN;
+            if ((sysconf(_SC_NPROCESSORS_ONLN) > 1) // spinning not futile?
+                && ((attr1 > l_spin.getPolicy())
+                    || ((attr1 == WAIT_SPIN_ATTR)
+                        && (attr1 == l_spin.getPolicy())
+                        && (maxSpin > l_maxSpin))))
+            {
+                l_spin.init(attr1, maxSpin);
+                l_maxSpin = maxSpin;
+            }
+            break;
+        }
+#else
+        case WAIT_BLOCK_ATTR: // the only waiting policy available
+            Q_UNUSED_PAR(attr2);
+            break;
+#endif
+        default:
+            Q_ERROR_INCRIT(910); // unsupported attribute
+            break;
+    }
+    QF_CRIT_EXIT();
+}
+
 //............................................................................
 #ifdef QACTIVE_CAN_STOP
 void QActive::stop() {
@@ -33,6 +33,9 @@
 #include <cstdint>        // Exact-width types. C++11 Standard
 #include <array>          // std::array<> template. C++11 Standard
 #include "qp_config.hpp"  // QP configuration from the application
+#ifdef QACTIVE_EQUEUE_SPIN
+#include <time.h>         // for clock_gettime()
+#endif
 
 // no-return function specifier (C++11 Standard)
 #define Q_NORETURN  [[ noreturn ]] void
@@ -51,7 +54,15 @@
 #define QF_CRIT_EXIT()       QP::QF::leaveCriticalSection_()
 #define QF_CRIT_EST()        QP::QF::enterCriticalSection_()
 
+#if (QF_MAX_ACTIVE > 64U)
+// QF_LOG2 based on the count-leading-zeros builtin (GCC/Clang) for the
+// hierarchical QPSet (__builtin_clz(0) is undefined, so LOG2(0) is 0)
+#define QF_LOG2(n_) (static_cast<std::uint8_t>(((n_) != 0U) \
+    ? (32U - static_cast<unsigned>(__builtin_clz(static_cast<unsigned>(n_)))) \
+    : 0U))
+#else
 // QF_LOG2 not defined -- use the internal LOG2() implementation
+#endif
 
 namespace QP {
 namespace QF {
@@ -76,6 +87,113 @@ void onClockTick();
 #endif
 
 } // namespace QF
+
+// attributes of the AOs (see QActive::setAttr())
+enum POSIX_ThreadAttrs : std::uint32_t {
+    WAIT_BLOCK_ATTR, // block on the empty queue (default)
+    WAIT_SPIN_ATTR,  // spin, then block; attr2: max. spin [us], see NOTE4
+    WAIT_POLL_ATTR   // busy-poll the empty queue (never block)
+};
+
+#ifdef QACTIVE_EQUEUE_SPIN
+// adaptive spinning of the QV event-loop without ready AOs, see NOTE4
+class QSpinWait {
+public:
+    static constexpr std::uint32_t DEFAULT_MAX_SPIN {50U}; // [us]
+
+    void init(
+        std::uint32_t const policy,
+        std::uint32_t const maxSpin) noexcept
+    {
+        m_policy  = static_cast<std::uint8_t>(policy);
+        m_maxSpin = (maxSpin <= (0xFFFFFFFFU / 1000U))
+            ? (maxSpin * 1000U)  // [us] -> [ns]
+            : 0xFFFFFFFFU;       // clamped to ~4.29s
+        m_avg     = m_maxSpin / 2U;  // start with spinning
+        m_budget  = 0U;
+        m_t0      = 0U;
+    }
+
+    // start waiting for a ready AO; should the thread spin?
+    bool begin() noexcept {
+        bool doSpin = false;
+        if (m_policy == WAIT_SPIN_ATTR) {
+            m_t0 = now_();
+            // spin only when the events tend to arrive within the limit
+            m_budget = (m_avg <= m_maxSpin)
+                ? ((m_avg < (m_maxSpin / 2U)) ? (2U * m_avg) : m_maxSpin)
+                : 0U;
+            doSpin = (m_budget != 0U);
+        }
+        else if (m_policy == WAIT_POLL_ATTR) {
+            doSpin = true;
+        }
+        else {
+            // empty
+        }
+        return doSpin;
+    }
+
+    // spin until ready() or until the spin budget runs out
+    template<typename Ready_>
+    void spin(Ready_ const &ready) noexcept {
+        std::uint64_t const deadline = m_t0 + m_budget;
+        std::uint32_t n = 0U;
+        while (!ready()) {
+            relax_();
+            ++n;
+            if (((n & 0x3FU) == 0U) // check the time only once in a while
+                && (m_policy != WAIT_POLL_ATTR)
+                && (now_() >= deadline))
+            {
+                break; // the spin budget exhausted (the thread will block)
+            }
+        }
+    }
+
+    // an event has arrived (after spinning or blocking)
+    void end() noexcept {
+        if (m_policy == WAIT_SPIN_ATTR) {
+            std::uint64_t dt = now_() - m_t0;
+            if (dt > 0xFFFFFFFFU) {
+                dt = 0xFFFFFFFFU;
+            }
+            // exponentially weighted moving average (1/8) of the waits
+            m_avg = static_cast<std::uint32_t>(
+                ((7U * static_cast<std::uint64_t>(m_avg)) + dt) / 8U);
+        }
+    }
+
+    std::uint8_t getPolicy() const noexcept {
+        return m_policy;
+    }
+
+    static void relax_() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ volatile ("yield" ::: "memory");
+#else
+        __asm__ volatile ("" ::: "memory");
+#endif
+    }
+
+    static std::uint64_t now_() noexcept {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (static_cast<std::uint64_t>(ts.tv_sec) * 1000000000U)
+               + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+private:
+    std::uint64_t m_t0 {0U};      // start of the current wait [ns]
+    std::uint32_t m_maxSpin {0U}; // the max. spin duration [ns]
+    std::uint32_t m_avg {0U};     // moving average of the waits [ns]
+    std::uint32_t m_budget {0U};  // spin budget of the current wait [ns]
+    std::uint8_t  m_policy {WAIT_BLOCK_ATTR}; // the waiting policy
+}; // class QSpinWait
+#endif // def QACTIVE_EQUEUE_SPIN
+
 } // namespace QP
 
 // include files -------------------------------------------------------------
@@ -96,9 +214,17 @@ void onClockTick();
     // QF event queue customization for POSIX-QV...
     #define QACTIVE_EQUEUE_WAIT_(me_) (static_cast<void>(0))
 
+#ifndef QACTIVE_EQUEUE_SPIN
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) \
+        QF::readySet_.insert((me_)->m_prio); \
+        pthread_cond_signal(&QP::QF::condVar_)
+#else
+    // also ends spinning of the event-loop, see NOTE4
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
         QF::readySet_.insert((me_)->m_prio); \
+        __atomic_store_n(&QP::QF::readyHint_, true, __ATOMIC_RELEASE); \
         pthread_cond_signal(&QP::QF::condVar_)
+#endif
 
     // QMPool operations
     #define QF_EPOOL_TYPE_ QMPool
@@ -108,6 +234,10 @@ void onClockTick();
     #define QF_EPOOL_GET_(p_, e_, m_, qsId_) \
         ((e_) = static_cast<QEvt *>((p_).get((m_), (qsId_))))
     #define QF_EPOOL_PUT_(p_, e_, qsId_) ((p_).put((e_), (qsId_)))
+    #define QF_EPOOL_GET_BATCH_(p_, blocks_, n_, m_, qsId_, nGot_) \
+        ((nGot_) = (p_).getBatch((blocks_), (n_), (m_), (qsId_)))
+    #define QF_EPOOL_PUT_BATCH_(p_, blocks_, n_, qsId_) \
+        ((p_).putBatch((blocks_), (n_), (qsId_)))
     #define QF_EPOOL_USE_(ePool_)   ((ePool_)->getUse())
     #define QF_EPOOL_FREE_(ePool_)  ((ePool_)->getFree())
     #define QF_EPOOL_MIN_(ePool_)   ((ePool_)->getMin())
@@ -118,7 +248,11 @@ namespace QP {
 namespace QF {
     extern QPSet readySet_;
     extern pthread_cond_t condVar_; // Cond.var. to signal events
+#ifdef QACTIVE_EQUEUE_SPIN
+    extern bool readyHint_; // readySet_ might be not empty (for spinning)
+#endif
 } // namespace QF
+
 } // namespace QP
 
 #endif // QP_IMPL
@@ -156,6 +290,40 @@ namespace QF {
 // Scheduler locking (used inside QActive::publish()) is not needed in the
 // single-threaded port because event multicasting is already atomic.
 //
+// NOTE3:
+// Defining QF_TIMEEVT_TICKLESS in "qp_config.hpp" (Linux only) adds the
+// QTimeEvt::armAt()/QTimeEvt::armIn() operations, which arm a time event
+// for an absolute CLOCK_MONOTONIC deadline with nanosecond resolution
+// (optionally periodic). Such "deadline" time events are kept in a min-heap
+// (up to QF_TIMEEVT_HEAP_SIZE) and a single timerfd is always programmed to
+// the earliest of the deadlines and the next system clock tick. The ticker
+// thread blocks on that timerfd instead of sleeping for the fixed clock
+// tick and it is started even with QF::setTickRate(0U, ...), in which case
+// the port is completely tickless: the ticker thread wakes up only when a
+// deadline expires and QF::onClockTick() is never called. Deadline time
+// events are disarmed with the regular QTimeEvt::disarm() and can be
+// converted back with QTimeEvt::rearm(). The deadline heap and the timerfd
+// (class QTickless) are implemented in ports/posix-common/qf_tickless.cpp.
+//
+// NOTE4:
+// Defining QACTIVE_EQUEUE_SPIN in "qp_config.hpp" lets the QV event-loop
+// in QF::run() spin for a while before blocking on QF::condVar_ when no AO
+// is ready to run, which saves the wakeup latency of the condition variable
+// for events posted from other threads (e.g., the ticker thread). The AOs
+// select the waiting policy with QActive::setAttr() (before starting them):
+// WAIT_BLOCK_ATTR (default), WAIT_SPIN_ATTR (attr2: pointer to the maximum
+// spin time [us] as std::uint32_t, or nullptr for 50us; clamped to
+// 4294967us) or WAIT_POLL_ATTR (never block). Because all AOs share the
+// single event-loop, the loop uses the most aggressive policy selected by
+// any AO. The polling is unbounded, so WAIT_POLL_ATTR requires that the
+// thread calling QF::run() does not have a real-time policy (SCHED_FIFO or
+// SCHED_RR) and has a CPU of its own. The actual spin time adapts
+// to the average of the recent waits and drops to zero when the events
+// arrive less frequently than the maximum spin time. The spinning thread
+// executes the "pause" ("yield") instruction in every iteration. Spinning
+// requires another CPU, so WAIT_SPIN_ATTR and WAIT_POLL_ATTR revert to
+// WAIT_BLOCK_ATTR on a single-CPU system.
+//
 
 #endif // QP_PORT_HPP_
 
@@ -0,0 +1,617 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+
+// expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008)
+#define _POSIX_C_SOURCE 200809L
+
+#define QP_IMPL             // this is QP implementation
+#include "qp_port.hpp"      // QP port
+#include "qp_pkg.hpp"       // QP package-scope interface
+#include "qsafe.h"          // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY                // QS software tracing enabled?
+    #include "qs_port.hpp"  // QS port
+    #include "qs_pkg.hpp"   // QS package-scope internal interface
+#else
+    #include "qs_dummy.hpp" // disable the QS software tracing
+#endif // Q_SPY
+
+#include <atomic>           // std::atomic<> (C++11 Standard)
+#include <sys/mman.h>       // for mlockall()
+#include <sys/ioctl.h>
+#include <time.h>           // for clock_nanosleep()
+#include <string.h>         // for memcpy() and memset()
+#include <unistd.h>         // for sysconf() and _exit()
+#include <signal.h>
+
+namespace { // unnamed local namespace
+
+Q_DEFINE_THIS_MODULE("qf_port")
+
+// Local objects =============================================================
+static std::atomic<bool> l_isRunning; // flag indicating when QF is running
+static struct timespec l_tick; // structure for the clock tick
+static int_t l_tickPrio;       // priority of the ticker thread
+
+constexpr long NSEC_PER_SEC {1000000000L};
+constexpr long DEFAULT_TICKS_PER_SEC {100L};
+
+// worker thread with its own ready-set of AOs, see NOTE2 in qp_port.hpp
+struct alignas(64) Worker {
+    pthread_mutex_t mutex;     // protects the readySet of this worker
+    QP::QPSet readySet;        // AOs ready to run, at most one per prio.
+    std::atomic<QP::QPrio> top; // highest prio. in readySet (0 == empty)
+    pthread_t thread;          // the p-thread of this worker
+};
+
+static Worker l_worker[QF_WS_MAX_WORKERS];
+static std::uint_fast8_t l_nWorkers; // number of workers used
+
+// the number of AOs in all ready-sets and the number of idle workers
+static std::atomic<std::uint_fast16_t> l_nReady;
+static std::atomic<std::uint_fast8_t> l_nIdle;
+
+// idle workers wait on this condition variable, see NOTE02
+static pthread_mutex_t l_idleMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  l_idleCond  = PTHREAD_COND_INITIALIZER;
+
+// NOTE: initialize the critical section mutex as non-recursive,
+// but check that nesting of critical sections never occurs
+// (see QF::enterCriticalSection_()/QF::leaveCriticalSection_()
+static pthread_mutex_t l_critSectMutex = PTHREAD_MUTEX_INITIALIZER;
+static int_t l_critSectNest;   // critical section nesting up-down counter
+
+//............................................................................
+static void sigIntHandler(int dummy); // prototype
+static void sigIntHandler(int dummy) {
+    Q_UNUSED_PAR(dummy);
+    QP::QF::onCleanup();
+    _exit(-1); // async-signal-safe, unlike exit()
+}
+
+//............................................................................
+static std::uint_fast8_t onlineCpus() {
+    long const n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1L) {
+        return 1U;
+    }
+    else if (n > static_cast<long>(QF_WS_MAX_WORKERS)) {
+        return static_cast<std::uint_fast8_t>(QF_WS_MAX_WORKERS);
+    }
+    else {
+        return static_cast<std::uint_fast8_t>(n);
+    }
+}
+
+//............................................................................
+// take the highest-priority ready AO from all ready-sets (the own ready-set
+// of the worker 'me' on ties) or return nullptr if no AO is ready
+static QP::QActive *takeReady(std::uint_fast8_t const me) {
+    std::uint_fast8_t victim = me;
+    QP::QPrio best = l_worker[me].top.load(std::memory_order_relaxed);
+    for (std::uint_fast8_t i = 1U; i < l_nWorkers; ++i) {
+        std::uint_fast8_t w = me + i;
+        if (w >= l_nWorkers) {
+            w -= l_nWorkers;
+        }
+        QP::QPrio const t = l_worker[w].top.load(std::memory_order_relaxed);
+        if (t > best) {
+            best   = t;
+            victim = w;
+        }
+    }
+    if (best == 0U) { // no AO ready?
+        return nullptr;
+    }
+
+    QP::QActive *act = nullptr;
+    Worker &v = l_worker[victim];
+    pthread_mutex_lock(&v.mutex);
+    if (v.readySet.notEmpty()) { // still not empty? (might have been stolen)
+        QP::QPrio const p = static_cast<QP::QPrio>(v.readySet.findMax());
+        v.readySet.remove(p);
+        v.top.store(v.readySet.notEmpty()
+                    ? static_cast<QP::QPrio>(v.readySet.findMax())
+                    : static_cast<QP::QPrio>(0U),
+                    std::memory_order_relaxed);
+        l_nReady.fetch_sub(1U);
+        act = QP::QActive_registry_[p];
+    }
+    pthread_mutex_unlock(&v.mutex);
+
+    return act;
+}
+
+//............................................................................
+static void waitForWork() {
+    pthread_mutex_lock(&l_idleMutex);
+    l_nIdle.fetch_add(1U); // see NOTE02
+    while (l_isRunning && (l_nReady.load() == 0U)) {
+        pthread_cond_wait(&l_idleCond, &l_idleMutex);
+    }
+    l_nIdle.fetch_sub(1U);
+    pthread_mutex_unlock(&l_idleMutex);
+}
+
+//............................................................................
+static void *worker_thread(void *arg); // prototype
+static void *worker_thread(void *arg) { // thread routine for all workers
+    std::uint_fast8_t const me = static_cast<std::uint_fast8_t>(
+        reinterpret_cast<std::uintptr_t>(arg));
+
+    while (l_isRunning) {
+        QP::QActive * const act = takeReady(me);
+        if (act != nullptr) {
+            // the AO is not in any ready-set and not running elsewhere,
+            // so its "home" worker can be changed without crit.section
+            act->setThread(static_cast<std::uint8_t>(me));
+            QP::QActive::evtLoop_(act); // run-to-completion step, NOTE04
+        }
+        else {
+            waitForWork();
+        }
+    }
+    return nullptr; // return success
+}
+
+//----------------------------------------------------------------------------
+#ifdef __APPLE__
+
+constexpr int TIMER_ABSTIME {0};
+
+// emulate clock_nanosleep() for CLOCK_MONOTONIC and TIMER_ABSTIME
+static inline int clock_nanosleep(clockid_t clockid, int flags,
+    const struct timespec* t,
+    struct timespec* remain)
+{
+    Q_UNUSED_PAR(clockid);
+    Q_UNUSED_PAR(flags);
+    Q_UNUSED_PAR(remain);
+
+    struct timespec ts_delta;
+    clock_gettime(CLOCK_MONOTONIC, &ts_delta);
+
+    ts_delta.tv_sec  = t->tv_sec  - ts_delta.tv_sec;
+    ts_delta.tv_nsec = t->tv_nsec - ts_delta.tv_nsec;
+    if (ts_delta.tv_sec < 0) {
+        ts_delta.tv_sec = 0;
+        ts_delta.tv_nsec = 0;
+    }
+    else if (ts_delta.tv_nsec < 0) {
+        if (ts_delta.tv_sec == 0) {
+            ts_delta.tv_sec = 0;
+            ts_delta.tv_nsec = 0;
+        }
+        else {
+            ts_delta.tv_sec = ts_delta.tv_sec - 1;
+            ts_delta.tv_nsec = ts_delta.tv_nsec + NSEC_PER_SEC;
+        }
+    }
+
+    return nanosleep(&ts_delta, NULL);
+}
+#endif
+
+} // unnamed local namespace
+
+//============================================================================
+namespace QP {
+namespace QF {
+
+//............................................................................
+void enterCriticalSection_() {
+    pthread_mutex_lock(&l_critSectMutex);
+    Q_ASSERT_INCRIT(100, l_critSectNest == 0); // NO nesting of crit.sect!
+    ++l_critSectNest;
+}
+//............................................................................
+void leaveCriticalSection_() {
+    Q_ASSERT_INCRIT(200, l_critSectNest == 1); // crit.sect. must balance!
+    if ((--l_critSectNest) == 0) {
+        pthread_mutex_unlock(&l_critSectMutex);
+    }
+}
+
+//............................................................................
+void makeReady_(QActive * const act) noexcept {
+    // NOTE: called inside the QF critical section when the AO was neither
+    // ready nor running (see QACTIVE_EQUEUE_SIGNAL_() and evtLoop_())
+    std::uint_fast8_t w = act->getThread();
+    if (w >= l_nWorkers) { // "home" worker not running (see setWorkers())?
+        w %= l_nWorkers;
+    }
+    Worker &wk = l_worker[w];
+    QPrio const p = act->getPrio();
+
+    pthread_mutex_lock(&wk.mutex);
+    wk.readySet.insert(p);
+    if (p > wk.top.load(std::memory_order_relaxed)) {
+        wk.top.store(p, std::memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&wk.mutex);
+
+    l_nReady.fetch_add(1U);
+    if (l_nIdle.load() != 0U) { // any idle workers? see NOTE02
+        pthread_mutex_lock(&l_idleMutex);
+        pthread_cond_signal(&l_idleCond);
+        pthread_mutex_unlock(&l_idleMutex);
+    }
+}
+
+//............................................................................
+void init() {
+    // lock memory so we're never swapped out to disk
+    //mlockall(MCL_CURRENT | MCL_FUTURE); // un-comment when supported
+
+    l_tick.tv_sec = 0;
+    l_tick.tv_nsec = NSEC_PER_SEC / DEFAULT_TICKS_PER_SEC; // default rate
+    l_tickPrio = sched_get_priority_min(SCHED_FIFO); // default ticker prio
+
+    // one worker per online CPU by default
+    l_nWorkers = onlineCpus();
+    for (auto &wk : l_worker) {
+        pthread_mutex_init(&wk.mutex, NULL);
+        wk.readySet.setEmpty();
+        wk.top.store(0U);
+    }
+    l_nReady.store(0U);
+    l_nIdle.store(0U);
+
+#ifdef QF_TIMEEVT_TICKLESS
+    QTickless::init(); // the timerfd for the deadline time events
+#endif
+
+    // install the SIGINT (Ctrl-C) signal handler
+    struct sigaction sig_act;
+    memset(&sig_act, 0, sizeof(sig_act));
+    sig_act.sa_handler = &sigIntHandler;
+    sigaction(SIGINT, &sig_act, NULL);
+}
+
+//............................................................................
+int run() {
+    // produce the QS_QF_RUN trace record
+    QS_BEGIN_PRE(QS_QF_RUN, 0U)
+    QS_END_PRE()
+
+    // Application callback: configure and enable individual interrupts.
+    // NOTE: called within critical section and returns also in
+    // critical section.
+    onStartup();
+
+    // try to set the priority of the ticker thread, see NOTE01
+    struct sched_param sparam;
+    sparam.sched_priority = l_tickPrio;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sparam) == 0) {
+        // success, this application has sufficient privileges
+    }
+    else {
+        // setting priority failed, probably due to insufficient privileges
+    }
+
+    l_isRunning = true;
+
+    // start the worker threads with the default (SCHED_OTHER) policy
+    for (std::uint_fast8_t i = 0U; i < l_nWorkers; ++i) {
+        int const err = pthread_create(&l_worker[i].thread, NULL,
+            &worker_thread,
+            reinterpret_cast<void *>(static_cast<std::uintptr_t>(i)));
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        Q_ASSERT_INCRIT(310, err == 0); // worker thread must be created
+        QF_CRIT_EXIT();
+#ifdef Q_UNSAFE
+        Q_UNUSED_PAR(err);
+#endif
+    }
+
+#ifdef QF_TIMEEVT_TICKLESS
+    // clock tick and deadline time events from timerfd, NOTE4 in qp_port.hpp
+    std::uint64_t const period =
+        (static_cast<std::uint64_t>(l_tick.tv_sec) * NSEC_PER_SEC)
+        + static_cast<std::uint64_t>(l_tick.tv_nsec);
+    std::uint64_t nextTick = QTickless::now();
+    if (period != 0U) {
+        // round down to the nearest configured period and advance
+        nextTick = ((nextTick / period) + 1U) * period;
+    }
+    while (l_isRunning) { // the timer loop...
+        if (QTickless::wait(nextTick, period)) { // clock tick due?
+            // clock tick callback (must call QTimeEvt::TICK_X() once)
+            onClockTick();
+        }
+    }
+#else
+    // The provided clock tick service configured?
+    if ((l_tick.tv_sec != 0) || (l_tick.tv_nsec != 0)) {
+
+        // get the absolute monotonic time for no-drift sleeping
+        static struct timespec next_tick;
+        clock_gettime(CLOCK_MONOTONIC, &next_tick);
+
+        // round down nanoseconds to the nearest configured period
+        next_tick.tv_nsec
+            = (next_tick.tv_nsec / l_tick.tv_nsec) * l_tick.tv_nsec;
+
+        while (l_isRunning) { // the clock tick loop...
+
+            // advance to the next tick (absolute time)
+            next_tick.tv_nsec += l_tick.tv_nsec;
+            if (next_tick.tv_nsec >= NSEC_PER_SEC) {
+                next_tick.tv_nsec -= NSEC_PER_SEC;
+                next_tick.tv_sec  += 1;
+            }
+
+            // sleep without drifting till next_time (absolute), see NOTE03
+            if (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+                                &next_tick, NULL) == 0) // success?
+            {
+                // clock tick callback (must call QTimeEvt::TICK_X() once)
+                onClockTick();
+            }
+        }
+    }
+    else { // The provided system clock tick NOT configured
+
+        while (l_isRunning) { // the clock tick loop...
+
+            // In case the application intentionally DISABLED the provided
+            // system clock, the QF_onClockTick() callback is used to let
+            // the application implement the alternative tick service.
+            // In that case the QF_onClockTick() must internally WAIT
+            // for the desired clock period before calling QTIMEEVT_TICK_X().
+            onClockTick();
+        }
+    }
+#endif // QF_TIMEEVT_TICKLESS
+
+    // the workers finish the current RTC steps and terminate
+    for (std::uint_fast8_t i = 0U; i < l_nWorkers; ++i) {
+        pthread_join(l_worker[i].thread, NULL);
+    }
+
+    onCleanup(); // cleanup callback
+    QS_EXIT();   // cleanup the QSPY connection
+
+    for (auto &wk : l_worker) {
+        pthread_mutex_destroy(&wk.mutex);
+    }
+    pthread_cond_destroy(&l_idleCond);
+    pthread_mutex_destroy(&l_idleMutex);
+    pthread_mutex_destroy(&l_critSectMutex);
+
+    return 0; // return success
+}
+//............................................................................
+void stop() {
+    l_isRunning = false; // terminate the main (ticker) thread and workers
+
+    // unblock all idle workers so they can terminate
+    pthread_mutex_lock(&l_idleMutex);
+    pthread_cond_broadcast(&l_idleCond);
+    pthread_mutex_unlock(&l_idleMutex);
+#ifdef QF_TIMEEVT_TICKLESS
+    QTickless::wake(); // unblock the timer loop so it can terminate
+#endif
+}
+//............................................................................
+void setTickRate(std::uint32_t ticksPerSec, int tickPrio) {
+    // NOTE: called inside crit.section
+    if (ticksPerSec != 0U) {
+        l_tick.tv_nsec = NSEC_PER_SEC / ticksPerSec;
+    }
+    else {
+        l_tick.tv_nsec = 0U; // means NO system clock tick
+    }
+    l_tickPrio = tickPrio;
+}
+//............................................................................
+void setWorkers(std::uint_fast8_t const nWorkers) {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    // the workers can be set only before they are started in QF::run()
+    Q_REQUIRE_INCRIT(400, !l_isRunning);
+    QF_CRIT_EXIT();
+
+    if (nWorkers == 0U) { // use one worker per online CPU?
+        l_nWorkers = onlineCpus();
+    }
+    else if (nWorkers > QF_WS_MAX_WORKERS) {
+        l_nWorkers = static_cast<std::uint_fast8_t>(QF_WS_MAX_WORKERS);
+    }
+    else {
+        l_nWorkers = nWorkers;
+    }
+}
+
+// console access ============================================================
+#ifdef QF_CONSOLE
+
+#include <termios.h>
+
+static struct termios l_tsav;  // structure with saved terminal attributes
+
+void consoleSetup() {
+    struct termios tio;   // modified terminal attributes
+
+    tcgetattr(0, &l_tsav); // save the current terminal attributes
+    tcgetattr(0, &tio);    // obtain the current terminal attributes
+    // disable the canonical mode & echo
+    tio.c_lflag &= static_cast<tcflag_t>(~(ICANON | ECHO));
+    tcsetattr(0, TCSANOW, &tio);     // set the new attributes
+}
+//............................................................................
+void consoleCleanup() {
+    tcsetattr(0, TCSANOW, &l_tsav); // restore the saved attributes
+}
+//............................................................................
+int consoleGetKey() {
+    int byteswaiting;
+    ioctl(0, FIONREAD, &byteswaiting);
+    if (byteswaiting > 0) {
+        char ch;
+        byteswaiting = read(0, &ch, 1);
+        return static_cast<int>(ch);
+    }
+    return 0; // no input at this time
+}
+//............................................................................
+int consoleWaitForKey() {
+    return static_cast<int>(getchar());
+}
+
+#endif // #ifdef QF_CONSOLE
+
+} // namespace QF
+
+// QActive functions =========================================================
+void QActive::evtLoop_(QActive *act) {
+    // NOTE: the POSIX-WS port calls this function from a worker thread
+    // for a single scheduling round of the ready AO 'act'
+#ifndef QF_DISPATCH_QUOTA
+    QEvt const * const e = act->get_(); // NO blocking (not empty)
+    act->dispatch_(&e, 1U); // virtual or static, NOTE2 in qf_qact.cpp
+#if (QF_MAX_EPOOL > 0U)
+    QF::gc(e); // check if the event is garbage, and collect it if so
+#endif
+#else // drain up to QF_DISPATCH_QUOTA events (NOTE1 in qf_actq.cpp)
+    QEvt const *evts[QF_DISPATCH_QUOTA];
+    std::uint_fast16_t const n =
+        act->getBatch_(&evts[0], QF_DISPATCH_QUOTA); // NO blocking
+#ifdef QACTIVE_CAN_STOP
+    for (std::uint_fast16_t i = 0U; i < n; ++i) {
+        if (QActive_registry_[act->m_prio] != act) { // AO stopped itself?
+            break; // the rest of the batch is only garbage-collected
+        }
+        act->dispatch_(&evts[i], 1U);
+    }
+#else
+    act->dispatch_(&evts[0], n); // the whole batch
+#endif
+#if (QF_MAX_EPOOL > 0U)
+    QF::gcBatch_(&evts[0], n); // collect the garbage events
+#endif
+#endif // QF_DISPATCH_QUOTA
+
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+#ifdef QACTIVE_CAN_STOP
+    if (QActive_registry_[act->m_prio] != act) { // AO stopped itself?
+        // leave the AO marked as "ready", so it is never scheduled again
+    }
+    else
+#endif
+    if (act->m_eQueue.isEmpty()) { // no more events?
+        act->m_osObject = false; // the AO is no longer ready
+    }
+    else { // more events, put the AO back into the ready-set of the worker
+        QF::makeReady_(act);
+    }
+    QF_CRIT_EXIT();
+}
+
+//............................................................................
+void QActive::start(QPrioSpec const prioSpec,
+    QEvtPtr * const qSto, std::uint_fast16_t const qLen,
+    void * const stkSto, std::uint_fast16_t const stkSize,
+    void const * const par)
+{
+    Q_UNUSED_PAR(stkSto);
+    Q_UNUSED_PAR(stkSize);
+
+    // no per-AO stack needed for this port
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(800, stkSto == nullptr);
+    QF_CRIT_EXIT();
+
+    m_eQueue.init(qSto, qLen);
+
+    m_prio  = static_cast<QPrio>(prioSpec); // QF-prio. (low part of prioSpec)
+    m_pthre = 0U; // preemption-threshold (not used in this port)
+
+    // spread the AOs among the workers initially, see NOTE2 in qp_port.hpp
+    m_thread = static_cast<std::uint8_t>(m_prio % QF_WS_MAX_WORKERS);
+
+    QF_CRIT_ENTRY();
+    m_osObject = false; // the AO is not ready yet
+    QF_CRIT_EXIT();
+
+    register_();  // register this AO
+
+    this->init(par, m_prio); // top-most initial tran. (virtual call)
+    QS_FLUSH(); // flush the QS trace buffer to the host
+}
+
+//............................................................................
+#ifdef QACTIVE_CAN_STOP
+void QActive::stop() {
+    // NOTE: must be called only from the AO itself (from its state machine)
+    if (QActive_subscrList_ != nullptr) {
+        unsubscribeAll(); // unsubscribe from all events
+    }
+    unregister_(); // remove this AO from QF, see QActive::evtLoop_()
+}
+#endif
+
+} // namespace QP
+
+//============================================================================
+// NOTE01:
+// In Linux, the scheduler policy closest to real-time is the SCHED_FIFO
+// policy, available only with superuser privileges. QF::run() attempts to set
+// this policy as well as to maximize its priority, so that the ticking
+// occurs in the most timely manner (as close to an interrupt as possible).
+// However, setting the SCHED_FIFO policy might fail, most probably due to
+// insufficient privileges. The worker threads always run with the default
+// SCHED_OTHER policy, so the port does not depend on superuser privileges.
+//
+// NOTE02:
+// The idle worker increments l_nIdle before it checks l_nReady, while
+// QF::makeReady_() increments l_nReady before it checks l_nIdle. Both
+// counters are sequentially consistent, so at least one of them sees the
+// other's update and the wake-up of an idle worker cannot be lost. At the
+// same time, posting to an AO does not touch l_idleMutex when all workers
+// are busy.
+//
+// NOTE03:
+// Any blocking system call, such as clock_nanosleep() system call can
+// be interrupted by a signal, such as ^C from the keyboard. In this case this
+// QF port breaks out of the event-loop and returns to main() that exits and
+// terminates all spawned p-threads.
+//
+// NOTE04:
+// The workers are not preemptive: a worker always completes the current
+// run-to-completion step before it takes the next ready AO. A higher-
+// priority AO becoming ready is taken immediately only by an idle worker.
+// When all workers are busy, it waits until the first of them finishes its
+// current step, even if all of them run lower-priority AOs. The priorities
+// only decide which ready AO is taken next, so the delay of a ready AO is
+// bounded by the longest run-to-completion step of the AOs that are already
+// running, not by the priorities.
+//
@@ -0,0 +1,199 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL (see <www.gnu.org/licenses/gpl-3.0>) does NOT permit the
+// incorporation of the QP/C++ software into proprietary programs. Please
+// contact Quantum Leaps for commercial licensing options, which expressly
+// supersede the GPL and are designed explicitly for licensees interested
+// in using QP/C++ in closed-source proprietary applications.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+#ifndef QP_PORT_HPP_
+#define QP_PORT_HPP_
+
+#include <cstdint>        // Exact-width types. C++11 Standard
+#include <array>          // std::array<> template. C++11 Standard
+#include "qp_config.hpp"  // QP configuration from the application
+
+// no-return function specifier (C++11 Standard)
+#define Q_NORETURN  [[ noreturn ]] void
+
+// static assertion (C++11 Standard)
+#define Q_ASSERT_STATIC(expr_)  static_assert((expr_), "QP static assert")
+
+// maximum number of worker threads, see NOTE2
+#ifndef QF_WS_MAX_WORKERS
+    #define QF_WS_MAX_WORKERS 16U
+#endif
+
+// QActive event queue and thread types for POSIX-WS
+#define QACTIVE_EQUEUE_TYPE  QEQueue
+#define QACTIVE_OS_OBJ_TYPE  bool          // AO is ready or running
+#define QACTIVE_THREAD_TYPE  std::uint8_t  // "home" worker of the AO
+
+// QF critical section for POSIX-WS, see NOTE1
+#define QF_CRIT_STAT
+#define QF_CRIT_ENTRY()      QP::QF::enterCriticalSection_()
+#define QF_CRIT_EXIT()       QP::QF::leaveCriticalSection_()
+#define QF_CRIT_EST()        QP::QF::enterCriticalSection_()
+
+// QF_LOG2 based on the count-leading-zeros builtin (GCC/Clang)
+#define QF_LOG2(n_) (static_cast<std::uint8_t>( \
+    32U - static_cast<unsigned>(__builtin_clz(static_cast<unsigned>(n_)))))
+
+namespace QP {
+namespace QF {
+
+// internal functions for critical section management
+void enterCriticalSection_();
+void leaveCriticalSection_();
+
+// set clock tick rate and p-thread priority
+void setTickRate(std::uint32_t ticksPerSec, int tickPrio);
+
+// set the number of worker threads (0 means one per online CPU)
+void setWorkers(std::uint_fast8_t const nWorkers);
+
+// clock tick callback
+void onClockTick();
+
+#ifdef QF_CONSOLE
+    // abstractions for console access...
+    void consoleSetup();
+    void consoleCleanup();
+    int consoleGetKey();
+    int consoleWaitForKey();
+#endif
+
+} // namespace QF
+} // namespace QP
+
+// include files -------------------------------------------------------------
+#include "qequeue.hpp"   // POSIX-WS port needs the native event-queue
+#include "qmpool.hpp"    // POSIX-WS port needs the native memory-pool
+#include "qp.hpp"        // QP platform-independent public interface
+
+//============================================================================
+// interface used only inside QF implementation, but not in applications
+
+#ifdef QP_IMPL
+
+    // QF scheduler locking for POSIX-WS (not used at this point, see NOTE3)
+    #define QF_SCHED_STAT_
+    #define QF_SCHED_LOCK_(dummy) (static_cast<void>(0))
+    #define QF_SCHED_UNLOCK_()    (static_cast<void>(0))
+
+    // QF event queue customization for POSIX-WS...
+    #define QACTIVE_EQUEUE_WAIT_(me_) (static_cast<void>(0))
+
+    // NOTE: called inside the QF critical section
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) do { \
+        if (!(me_)->m_osObject) { \
+            (me_)->m_osObject = true; \
+            QP::QF::makeReady_((me_)); \
+        } \
+    } while (false)
+
+    // QMPool operations
+    #define QF_EPOOL_TYPE_ QMPool
+    #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
+        (p_).init((poolSto_), (poolSize_), (evtSize_))
+    #define QF_EPOOL_EVENT_SIZE_(p_) ((p_).getBlockSize())
+    #define QF_EPOOL_GET_(p_, e_, m_, qsId_) \
+        ((e_) = static_cast<QEvt *>((p_).get((m_), (qsId_))))
+    #define QF_EPOOL_PUT_(p_, e_, qsId_) ((p_).put((e_), (qsId_)))
+    #define QF_EPOOL_GET_BATCH_(p_, blocks_, n_, m_, qsId_, nGot_) \
+        ((nGot_) = (p_).getBatch((blocks_), (n_), (m_), (qsId_)))
+    #define QF_EPOOL_PUT_BATCH_(p_, blocks_, n_, qsId_) \
+        ((p_).putBatch((blocks_), (n_), (qsId_)))
+    #define QF_EPOOL_USE_(ePool_)   ((ePool_)->getUse())
+    #define QF_EPOOL_FREE_(ePool_)  ((ePool_)->getFree())
+    #define QF_EPOOL_MIN_(ePool_)   ((ePool_)->getMin())
+
+    #include <pthread.h> // POSIX-thread API
+
+namespace QP {
+namespace QF {
+    // put the AO into the ready-set of its "home" worker (see qf_port.cpp)
+    void makeReady_(QActive * const act) noexcept;
+} // namespace QF
+} // namespace QP
+
+#endif // QP_IMPL
+
+//============================================================================
+// NOTE1:
+// QP, like all real-time frameworks, needs to execute certain sections of
+// code exclusively, meaning that only one thread can execute the code at
+// the time. Such sections of code are called "critical sections".
+//
+// This port uses a pair of functions QF::enterCriticalSection_() /
+// QF::leaveCriticalSection_() to enter/leave the critical section,
+// respectively. These functions are implemented in the qf_port.cpp module,
+// where they manipulate a single POSIX mutex to protect all critical
+// sections, exactly as in the POSIX port.
+//
+// NOTE2:
+// The POSIX-WS port does not create a p-thread per active object. Instead,
+// QF::run() starts a fixed pool of worker p-threads (by default one per
+// online CPU, but not more than QF_WS_MAX_WORKERS), which can be changed
+// with QF::setWorkers() before calling QF::run(). Every worker owns a
+// ready-set of active objects. An AO becomes "ready" when its event queue
+// goes from empty to not-empty and is inserted into the ready-set of its
+// "home" worker (m_thread), which is the worker that ran it last time.
+//
+// A worker always takes the highest-priority ready AO from all ready-sets
+// (its own ready-set on ties), which means that an idle or finishing worker
+// "steals" ready AOs from the other workers. The AO processes one event
+// to completion and is then inserted back into the ready-set of the
+// worker, if it has more events. The m_osObject flag of the AO stays set
+// while the AO is ready or running, so every AO is in at most one ready-set
+// and never runs on two workers at the same time.
+//
+// The ready-sets are priority sets (QPSet), not the double-ended work
+// queues of the classic work-stealing schedulers (e.g., Chase-Lev deques).
+// Such deques are FIFO/LIFO and ignore the AO priorities, while QP requires
+// the highest-priority ready AO to run first. Also, a ready AO is at most
+// once in one ready-set, which a QPSet represents directly. The resulting
+// scheduler is a global priority scheduler with per-worker ready-sets:
+// every worker scans the "top" priorities of all ready-sets (one atomic
+// load per worker) and locks only the ready-set it takes the AO from, so
+// the workers do not contend on a single ready-set lock. The price is that
+// taking an AO is O(number of workers) instead of the O(1) of a deque.
+//
+// NOTE3:
+// Scheduler locking (used inside QActive::publish()) is NOT implemented
+// in this port, so event multicasting is NOT atomic: a worker can process
+// the published event in one subscriber before QActive::publish() has
+// delivered it to all other subscribers. Applications must not rely on
+// all subscribers receiving a published event before any of them reacts.
+//
+// NOTE4:
+// Defining QF_TIMEEVT_TICKLESS in "qp_config.hpp" (Linux only) adds the
+// QTimeEvt::armAt()/QTimeEvt::armIn() operations, which arm a time event
+// for an absolute CLOCK_MONOTONIC deadline with nanosecond resolution
+// (optionally periodic). The main (ticker) thread in QF::run() then blocks
+// on a single timerfd programmed to the earliest of the deadlines and the
+// next system clock tick (see the POSIX port and
+// ports/posix-common/qf_tickless.cpp).
+//
+
+#endif // QP_PORT_HPP_
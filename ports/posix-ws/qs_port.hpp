@@ -0,0 +1,56 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: LicenseRef-QL-commercial
+//
+// This software is licensed under the terms of the Quantum Leaps commercial
+// licenses. Please contact Quantum Leaps for more information about the
+// available licensing options.
+//
+// RESTRICTIONS
+// You may NOT :
+// (a) redistribute, encumber, sell, rent, lease, sublicense, or otherwise
+//     transfer rights in this software,
+// (b) remove or alter any trademark, logo, copyright or other proprietary
+//     notices, legends, symbols or labels present in this software,
+// (c) plagiarize this software to sidestep the licensing obligations.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QS_PORT_HPP_
+#define QS_PORT_HPP_
+
+#if defined(_WIN64) || defined(__LP64__) || defined(_LP64)  // 64-bit OS?
+    #define QS_OBJ_PTR_SIZE 8U
+    #define QS_FUN_PTR_SIZE 8U
+#else  // 32-bit OS
+    #define QS_OBJ_PTR_SIZE 4U
+    #define QS_FUN_PTR_SIZE 4U
+#endif
+
+namespace QP {
+void QS_output();    // handle the QS output
+void QS_rx_input();  // handle the QS-RX input
+}
+
+//============================================================================
+// NOTE: QS might be used with or without other QP components, in which
+// case the separate definitions of the macros QF_CRIT_STAT, QF_CRIT_ENTRY(),
+// and QF_CRIT_EXIT() are needed. In this port QS is configured to be used
+// with the other QP component, by simply including "qp_port.hpp"
+// *before* "qs.hpp".
+#ifndef QP_PORT_HPP_
+#include "qp_port.hpp" // use QS with QP
+#endif
+
+#include "qs.hpp"      // QS platform-independent public interface
+
+#endif // QS_PORT_HPP_
@@ -0,0 +1,243 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#define QP_IMPL             // this is QP implementation
+#include "qp_port.hpp"      // QP port
+#include "qp_pkg.hpp"       // QP package-scope interface
+#include "qsafe.h"          // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY                // QS software tracing enabled?
+    #include "qs_port.hpp"  // QS port
+    #include "qs_pkg.hpp"   // QS package-scope internal interface
+#else
+    #include "qs_dummy.hpp" // disable the QS software tracing
+#endif // Q_SPY
+
+#ifdef QF_EPOOL_MAGAZINE    // per-thread magazines for the event pools?
+
+#if (QF_EPOOL_MAGAZINE < 2U) || ((QF_EPOOL_MAGAZINE % 2U) != 0U)
+    #error QF_EPOOL_MAGAZINE must be an even number of at least 2
+#endif
+
+#include <atomic>           // for std::atomic<>
+
+namespace { // unnamed local namespace
+
+Q_DEFINE_THIS_MODULE("qf_magazine")
+
+// Local objects =============================================================
+constexpr std::uint_fast16_t MAG_HALF {QF_EPOOL_MAGAZINE / 2U};
+
+// magazine of free blocks cached by a single thread, see NOTE1
+class Magazine {
+public:
+    Magazine() noexcept;
+    ~Magazine() noexcept;
+
+    std::atomic<std::uint16_t> m_n[QF_MAX_EPOOL]; // # cached blocks
+    void *m_blk[QF_MAX_EPOOL][QF_EPOOL_MAGAZINE]; // cached blocks (LIFO)
+    Magazine *m_next;   // next magazine in the registry
+};
+
+// registry of all magazines (protected by l_regMutex)
+static pthread_mutex_t l_regMutex = PTHREAD_MUTEX_INITIALIZER;
+static Magazine *l_regHead;
+
+// the magazine of the calling thread
+static thread_local Magazine l_mag;
+
+//............................................................................
+Magazine::Magazine() noexcept
+  : m_n(),
+    m_blk(),
+    m_next(nullptr)
+{
+    pthread_mutex_lock(&l_regMutex);
+    m_next = l_regHead;
+    l_regHead = this;
+    pthread_mutex_unlock(&l_regMutex);
+}
+//............................................................................
+Magazine::~Magazine() noexcept {
+    pthread_mutex_lock(&l_regMutex);
+    Magazine **pm = &l_regHead;
+    while (*pm != this) {
+        pm = &(*pm)->m_next;
+    }
+    *pm = m_next; // unlink this magazine from the registry
+    pthread_mutex_unlock(&l_regMutex);
+
+    // return all blocks cached by the exiting thread to their pools
+    for (std::uint_fast8_t i = 0U; i < QF_MAX_EPOOL; ++i) {
+        std::uint_fast16_t const n = m_n[i].load(std::memory_order_relaxed);
+        if (n > 0U) {
+            QP::QF::priv_.ePool_[i].putBatch(&m_blk[i][0], n, 0U);
+            m_n[i].store(0U, std::memory_order_relaxed);
+        }
+    }
+}
+
+//............................................................................
+static std::uint_fast8_t poolIdx(QP::QMPool const &pool) noexcept {
+    std::ptrdiff_t const idx = &pool - &QP::QF::priv_.ePool_[0];
+
+    // the pool must be one of the QF event pools
+    Q_REQUIRE_LOCAL(100, (0 <= idx) && (idx < QF_MAX_EPOOL));
+
+    return static_cast<std::uint_fast8_t>(idx);
+}
+
+} // unnamed local namespace
+
+//============================================================================
+namespace QP {
+namespace QF {
+
+//............................................................................
+void *magGet_(
+    QMPool &pool,
+    std::uint_fast16_t const margin,
+    std::uint_fast8_t const qsId) noexcept
+{
+    std::uint_fast8_t const idx = poolIdx(pool);
+    Magazine &mag = l_mag;
+    std::uint_fast16_t n = mag.m_n[idx].load(std::memory_order_relaxed);
+
+    if (margin == 0U) { // allocation without margin?
+        if (n == 0U) { // magazine empty?
+            // refill half of the magazine in one pool critical section,
+            // but leave the other threads a reserve in the shared pool
+            n = pool.getBatch(&mag.m_blk[idx][0], MAG_HALF,
+                              QF_EPOOL_MAGAZINE, qsId);
+            if (n == 0U) { // the reserve reached?
+                return pool.get(0U, qsId); // take directly from the pool
+            }
+        }
+    }
+    else { // allocation with margin
+        void * const block = pool.get(margin, qsId);
+        if (block != nullptr) {
+            return block;
+        }
+        if (n == 0U) { // nothing cached locally?
+            return nullptr;
+        }
+
+        // the blocks cached in the magazines count as free for the margin
+        QF_CRIT_STAT
+        QF_MEM_CRIT_ENTRY_(&pool);
+        std::uint_fast16_t const nFree = pool.getFree();
+        QF_MEM_CRIT_EXIT_(&pool);
+        if ((nFree + magCached_(pool)) <= margin) {
+            return nullptr;
+        }
+    }
+
+    --n;
+    mag.m_n[idx].store(static_cast<std::uint16_t>(n),
+                       std::memory_order_relaxed);
+    return mag.m_blk[idx][n];
+}
+
+//............................................................................
+void magPut_(
+    QMPool &pool,
+    void * const block,
+    std::uint_fast8_t const qsId) noexcept
+{
+    // the returned block must be valid
+    Q_REQUIRE_LOCAL(200, block != nullptr);
+
+    std::uint_fast8_t const idx = poolIdx(pool);
+    Magazine &mag = l_mag;
+    std::uint_fast16_t n = mag.m_n[idx].load(std::memory_order_relaxed);
+
+    if (n == QF_EPOOL_MAGAZINE) { // magazine full?
+        // return the older half of the magazine in one critical section
+        pool.putBatch(&mag.m_blk[idx][0], MAG_HALF, qsId);
+        for (std::uint_fast16_t i = 0U; i < MAG_HALF; ++i) {
+            mag.m_blk[idx][i] = mag.m_blk[idx][MAG_HALF + i];
+        }
+        n = MAG_HALF;
+    }
+
+    mag.m_blk[idx][n] = block;
+    mag.m_n[idx].store(static_cast<std::uint16_t>(n + 1U),
+                       std::memory_order_relaxed);
+}
+
+//............................................................................
+std::uint16_t magCached_(QMPool const &pool) noexcept {
+    std::uint_fast8_t const idx = poolIdx(pool);
+    std::uint16_t nCached = 0U;
+
+    pthread_mutex_lock(&l_regMutex);
+    for (Magazine const *m = l_regHead; m != nullptr; m = m->m_next) {
+        nCached += m->m_n[idx].load(std::memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&l_regMutex);
+
+    return nCached;
+}
+//............................................................................
+std::uint16_t magUse_(QMPool const &pool) noexcept {
+    // NOTE: called with the pool locked, but the magazines change without
+    // that lock, so clamp the result (see NOTE6 in "qp_port.hpp")
+    std::uint16_t const nUse = pool.getUse();
+    std::uint16_t const nCached = magCached_(pool);
+    return (nCached < nUse)
+           ? static_cast<std::uint16_t>(nUse - nCached)
+           : 0U;
+}
+//............................................................................
+std::uint16_t magFree_(QMPool const &pool) noexcept {
+    // NOTE: called with the pool locked, but the magazines change without
+    // that lock, so clamp the result (see NOTE6 in "qp_port.hpp")
+    std::uint16_t const nUse = pool.getUse();
+    std::uint16_t const nCached = magCached_(pool);
+    return static_cast<std::uint16_t>(pool.getFree()
+                                      + ((nCached < nUse) ? nCached : nUse));
+}
+
+} // namespace QF
+} // namespace QP
+
+#endif // QF_EPOOL_MAGAZINE
+
+//============================================================================
+// NOTE1:
+// Every thread that allocates or recycles dynamic events gets its own
+// magazine, which caches up to QF_EPOOL_MAGAZINE free blocks per event pool.
+// The magazine is accessed only by its owner thread, so the common case of
+// allocating and recycling an event does not enter any critical section.
+// The magazine is refilled (when empty) and flushed (when full) by half of
+// its capacity at a time with QMPool::getBatch()/QMPool::putBatch(), so
+// the pool lock is taken at most once per QF_EPOOL_MAGAZINE/2 operations.
+// The number of cached blocks is atomic only to allow other threads to
+// compute the pool statistics (see magCached_()). The blocks cached by a
+// thread are returned to the pool when the thread exits.
+//
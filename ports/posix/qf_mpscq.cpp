@@ -0,0 +1,740 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#define QP_IMPL             // this is QP implementation
+#include "qp_port.hpp"      // QP port
+#include "qp_pkg.hpp"       // QP package-scope interface
+#include "qsafe.h"          // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY                // QS software tracing enabled?
+    #include "qs_port.hpp"  // QS port
+    #include "qs_pkg.hpp"   // QS facilities for pre-defined trace records
+#else
+    #include "qs_dummy.hpp" // disable the QS software tracing
+#endif // Q_SPY
+
+#ifdef QACTIVE_EQUEUE_MPSC  // lock-free MPSC event queues for AOs?
+
+//============================================================================
+// unnamed namespace for local definitions with internal linkage
+namespace {
+Q_DEFINE_THIS_MODULE("qf_mpscq")
+
+// layout of the QMPSCQueue control word, see NOTE2 in "qmpscq.hpp"
+constexpr std::uint32_t CTL_NFREE_MASK {0xFFFFU};
+constexpr std::uint32_t CTL_TAIL_SHIFT {16U};
+
+// max. # iterations to spin on a reserved slot, see NOTE3 in "qmpscq.hpp"
+constexpr std::uint_fast16_t PUBLISH_SPIN_MAX {256U};
+
+static inline void relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile ("yield" ::: "memory");
+#else
+    __asm__ volatile ("" ::: "memory");
+#endif
+}
+
+} // unnamed namespace
+
+namespace QP {
+
+//............................................................................
+QMPSCQueue::QMPSCQueue() noexcept
+  : m_frontEvt(),         // queue empty initially
+    m_ring(nullptr),      // no queue buffer initially
+    m_end(0U),            // end index 0 initially
+    m_head(0U),           // head index 0 initially
+    m_ctl(0U),            // tail index 0 and no free events initially
+    m_nMin(0U),           // all time minimum of free entries so far
+    m_waiting(false),     // consumer not waiting for publishing
+    m_nTicks(0U),         // no ticks pending (QTicker only)
+    m_tickRate(0U)        // tick rate (QTicker only)
+{}
+//............................................................................
+void QMPSCQueue::init(
+    QEvtPtr * const qSto,
+    std::uint_fast16_t const qLen) noexcept
+{
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+#if (QF_EQUEUE_CTR_SIZE == 1U)
+    // the qLen paramter must not exceed the dynamic range of uint8_t
+    Q_REQUIRE_INCRIT(10, qLen < 0xFFU);
+#endif
+
+    m_frontEvt.e = nullptr; // the extra slot is empty
+    m_ring = qSto;          // the beginning of the ring buffer
+    m_end  = static_cast<QEQueueCtr>(qLen); // index of the extra slot
+    if (qLen > 0U) { // queue buffer storage provided?
+        m_head = 0U; // head index: for removing events
+    }
+    for (std::uint_fast16_t i = 0U; i < qLen; ++i) {
+        qSto[i].e = nullptr; // all slots must be empty, see take_()
+    }
+
+    QEQueueCtr const nFree = static_cast<QEQueueCtr>(qLen + 1U);
+    m_ctl.store(nFree, std::memory_order_relaxed); // tail index 0
+    m_nMin.store(nFree, std::memory_order_relaxed);
+
+    QF_CRIT_EXIT();
+}
+//............................................................................
+std::uint16_t QMPSCQueue::getFree() const noexcept {
+    // NOTE: this function does NOT need critical section
+    return static_cast<std::uint16_t>(
+        m_ctl.load(std::memory_order_relaxed) & CTL_NFREE_MASK);
+}
+//............................................................................
+std::uint16_t QMPSCQueue::getUse() const noexcept {
+    // NOTE: this function does NOT need critical section
+    return static_cast<std::uint16_t>(
+        static_cast<std::uint16_t>(m_end) + 1U - getFree());
+}
+//............................................................................
+std::uint16_t QMPSCQueue::getMin() const noexcept {
+    // NOTE: this function does NOT need critical section
+    return static_cast<std::uint16_t>(
+        m_nMin.load(std::memory_order_relaxed));
+}
+//............................................................................
+bool QMPSCQueue::isEmpty() const noexcept {
+    // NOTE: this function does NOT need critical section
+    return (static_cast<std::uint_fast16_t>(
+                m_ctl.load(std::memory_order_acquire) & CTL_NFREE_MASK)
+            == (static_cast<std::uint_fast16_t>(m_end) + 1U));
+}
+//............................................................................
+QEvtPtr *QMPSCQueue::slot_(std::uint_fast16_t const idx) noexcept {
+    // NOTE: index m_end (or any index of a queue without the ring buffer,
+    // such as the queue of QTicker) designates the extra slot m_frontEvt
+    return (idx < m_end) ? &m_ring[idx] : &m_frontEvt;
+}
+//............................................................................
+void QMPSCQueue::updateMin_(QEQueueCtr const nFree) noexcept {
+    QEQueueCtr nMin = m_nMin.load(std::memory_order_relaxed);
+    while ((nFree < nMin)
+           && (!m_nMin.compare_exchange_weak(nMin, nFree,
+                   std::memory_order_relaxed, std::memory_order_relaxed)))
+    {}
+}
+//............................................................................
+bool QMPSCQueue::reserve_(
+    std::uint_fast16_t const n,
+    std::uint_fast16_t const margin,
+    std::uint32_t &ctl) noexcept
+{
+    // NOTE: called by any producer without critical section.
+    // On success, 'ctl' holds the control word *before* the reservation,
+    // which designates the first of the n consecutive reserved slots (tail)
+    // and the previous # free.
+    ctl = m_ctl.load(std::memory_order_relaxed);
+    for (;;) {
+        std::uint32_t const nFree = (ctl & CTL_NFREE_MASK);
+        if (nFree < (n + margin)) { // not enough free entries?
+            return false;
+        }
+        std::uint32_t tail = (ctl >> CTL_TAIL_SHIFT) + n; // advance...
+        if (tail > m_end) { // ...and wrap the tail
+            tail -= (static_cast<std::uint32_t>(m_end) + 1U);
+        }
+        if (m_ctl.compare_exchange_weak(ctl,
+                (tail << CTL_TAIL_SHIFT) | (nFree - n),
+                std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            break; // slots reserved
+        }
+    }
+    updateMin_(static_cast<QEQueueCtr>((ctl & CTL_NFREE_MASK) - n));
+    return true;
+}
+//............................................................................
+void QMPSCQueue::put_(
+    std::uint_fast16_t const idx,
+    QEvt const * const e) noexcept
+{
+    // publish the event in a slot reserved by reserve_()
+    // NOTE: the atomic built-ins are applied to the plain QEvtPtr storage
+    // provided by the application. The store is sequentially consistent
+    // with the subsequent check of m_waiting, see NOTE3 in "qmpscq.hpp"
+    QEvtPtr * const slot = slot_(idx);
+    __atomic_store_n(&slot->e, e, __ATOMIC_SEQ_CST);
+}
+//............................................................................
+bool QMPSCQueue::isPublished_() const noexcept {
+    // NOTE: called only by the consumer, when the queue is NOT empty
+    QEvtPtr const * const slot = (m_head < m_end)
+                                 ? &m_ring[m_head]
+                                 : &m_frontEvt;
+    return __atomic_load_n(&slot->e, __ATOMIC_SEQ_CST) != nullptr;
+}
+//............................................................................
+bool QMPSCQueue::putFront_(
+    QEvt const * const e,
+    QEQueueCtr &nFree) noexcept
+{
+    // NOTE: called only by the consumer, which owns m_head
+    std::uint32_t ctl = m_ctl.load(std::memory_order_relaxed);
+    do {
+        if ((ctl & CTL_NFREE_MASK) == 0U) { // no free entries?
+            return false;
+        }
+    } while (!m_ctl.compare_exchange_weak(ctl, ctl - 1U, // only nFree
+                std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    nFree = static_cast<QEQueueCtr>((ctl & CTL_NFREE_MASK) - 1U);
+    updateMin_(nFree);
+
+    // the slot just before the head is at the far end of the free space,
+    // which producers can't reach while the entry is reserved here
+    QEQueueCtr head = m_head;
+    head = (head > 0U) ? static_cast<QEQueueCtr>(head - 1U) : m_end;
+    m_head = head;
+    __atomic_store_n(&slot_(head)->e, e, __ATOMIC_RELEASE);
+    return true;
+}
+//............................................................................
+QEvt const *QMPSCQueue::take_(QEQueueCtr &nFree) noexcept {
+    // NOTE: called only by the consumer, when the event in the head slot
+    // has been published (see QActive::get_())
+    QEQueueCtr const head = m_head;
+    QEvtPtr * const slot = slot_(head);
+
+    QEvt const * const e = __atomic_load_n(&slot->e, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&slot->e, nullptr, __ATOMIC_RELAXED);
+
+    if (m_end != 0U) { // ring buffer present? (see QTicker)
+        m_head = (head < m_end) ? static_cast<QEQueueCtr>(head + 1U) : 0U;
+    }
+
+    // return the slot to the producers (changes only nFree)
+    nFree = static_cast<QEQueueCtr>(
+        (m_ctl.fetch_add(1U, std::memory_order_release) & CTL_NFREE_MASK)
+        + 1U);
+    return e;
+}
+
+//============================================================================
+bool QActive::postx_(
+    QEvt const * const e,
+    std::uint_fast16_t const margin,
+    void const * const sender) noexcept
+{
+#ifdef Q_UTEST // test?
+#if (Q_UTEST != 0) // testing QP-stub?
+    if (m_temp.fun == Q_STATE_CAST(0)) { // QActiveDummy?
+        return static_cast<QActiveDummy *>(this)->fakePost(e, margin, sender);
+    }
+#endif // (Q_UTEST != 0)
+#endif // def Q_UTEST
+
+#ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+#endif
+
+    // the event to post must not be NULL
+    Q_REQUIRE_LOCAL(100, e != nullptr);
+
+    std::uint32_t ctl;
+    bool const status = m_eQueue.reserve_(1U,
+        (margin == QF::NO_MARGIN) ? 0U : margin, ctl);
+
+    QS_CRIT_STAT
+    if (status) { // slot reserved?
+
+#if (QF_MAX_EPOOL > 0U)
+        if (e->poolNum_ != 0U) { // is it a mutable event?
+            QF_CRIT_STAT
+            QF_EVT_CRIT_ENTRY_(e);
+            QEvt_refCtr_incEvt_(e); // increment the reference counter
+            QF_EVT_CRIT_EXIT_(e);
+        }
+#endif // (QF_MAX_EPOOL > 0U)
+
+        QS_CRIT_ENTRY();
+        QS_BEGIN_PRE(QS_QF_ACTIVE_POST, m_prio)
+            QS_TIME_PRE();        // timestamp
+            QS_OBJ_PRE(sender);   // the sender object
+            QS_SIG_PRE(e->sig);   // the signal of the event
+            QS_OBJ_PRE(this);     // this active object (recipient)
+            QS_2U8_PRE(e->poolNum_, e->refCtr_);
+            QS_EQC_PRE((ctl & CTL_NFREE_MASK) - 1U); // # free entries
+            QS_EQC_PRE(m_eQueue.getMin()); // min # free entries
+        QS_END_PRE()
+        QS_CRIT_EXIT();
+
+#ifdef Q_UTEST
+        if (QS_LOC_CHECK_(m_prio)) {
+            QS::onTestPost(sender, this, e, true); // QUTest callback
+        }
+#endif // def Q_UTEST
+
+        // NOTE: the event might be consumed right after publishing
+        m_eQueue.put_(ctl >> CTL_TAIL_SHIFT, e);
+
+        // was the queue empty before this post or is the AO waiting for
+        // the event to be published? (see NOTE3 in "qmpscq.hpp")
+        if (((ctl & CTL_NFREE_MASK)
+             == (static_cast<std::uint32_t>(m_eQueue.m_end) + 1U))
+            || m_eQueue.m_waiting.load(std::memory_order_seq_cst))
+        {
+            QACTIVE_EQUEUE_SIGNAL_(this); // signal the Active Object
+        }
+    }
+    else { // event cannot be posted
+        // the queue must not overflow when posting without margin
+        Q_ASSERT_LOCAL(130, margin != QF::NO_MARGIN);
+
+        QS_CRIT_ENTRY();
+        QS_BEGIN_PRE(QS_QF_ACTIVE_POST_ATTEMPT, m_prio)
+            QS_TIME_PRE();       // timestamp
+            QS_OBJ_PRE(sender);  // the sender object
+            QS_SIG_PRE(e->sig);  // the signal of the event
+            QS_OBJ_PRE(this);    // this active object (recipient)
+            QS_2U8_PRE(e->poolNum_, e->refCtr_);
+            QS_EQC_PRE(ctl & CTL_NFREE_MASK); // # free entries
+            QS_EQC_PRE(margin);  // margin requested
+        QS_END_PRE()
+        QS_CRIT_EXIT();
+
+#ifdef Q_UTEST
+        if (QS_LOC_CHECK_(m_prio)) {
+            QS::onTestPost(sender, this, e, status); // QUTEst callback
+        }
+#endif // def Q_USTEST
+
+#if (QF_MAX_EPOOL > 0U)
+        QF::gc(e); // recycle the event to avoid a leak
+#endif // (QF_MAX_EPOOL > 0U)
+    }
+
+    return status;
+}
+
+//............................................................................
+bool QActive::postBatchx_(
+    QEvt const * const * const evts,
+    std::uint_fast16_t const n,
+    std::uint_fast16_t const margin,
+    void const * const sender) noexcept
+{
+#ifdef Q_UTEST // test?
+#if (Q_UTEST != 0) // testing QP-stub?
+    if (m_temp.fun == Q_STATE_CAST(0)) { // QActiveDummy?
+        bool status = true;
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            status = static_cast<QActiveDummy *>(this)->fakePost(
+                evts[i], margin, sender) && status;
+        }
+        return status;
+    }
+#endif // (Q_UTEST != 0)
+#endif // def Q_UTEST
+
+#ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+#endif
+
+    // the events to post must be provided
+    Q_REQUIRE_LOCAL(150, (evts != nullptr) && (n > 0U));
+
+    // all-or-nothing: reserve n consecutive slots (plus margin) in one CAS
+    std::uint32_t ctl;
+    bool const status = m_eQueue.reserve_(n,
+        (margin == QF::NO_MARGIN) ? 0U : margin, ctl);
+
+    QS_CRIT_STAT
+    if (status) { // slots reserved?
+        std::uint_fast16_t idx = (ctl >> CTL_TAIL_SHIFT);
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            QEvt const * const e = evts[i];
+
+            // the event to post must not be NULL
+            Q_ASSERT_LOCAL(170, e != nullptr);
+
+#if (QF_MAX_EPOOL > 0U)
+            if (e->poolNum_ != 0U) { // is it a mutable event?
+                QF_CRIT_STAT
+                QF_EVT_CRIT_ENTRY_(e);
+                QEvt_refCtr_incEvt_(e); // increment the reference counter
+                QF_EVT_CRIT_EXIT_(e);
+            }
+#endif // (QF_MAX_EPOOL > 0U)
+
+            QS_CRIT_ENTRY();
+            QS_BEGIN_PRE(QS_QF_ACTIVE_POST, m_prio)
+                QS_TIME_PRE();        // timestamp
+                QS_OBJ_PRE(sender);   // the sender object
+                QS_SIG_PRE(e->sig);   // the signal of the event
+                QS_OBJ_PRE(this);     // this active object (recipient)
+                QS_2U8_PRE(e->poolNum_, e->refCtr_);
+                QS_EQC_PRE((ctl & CTL_NFREE_MASK) - 1U - i); // # free
+                QS_EQC_PRE(m_eQueue.getMin()); // min # free entries
+            QS_END_PRE()
+            QS_CRIT_EXIT();
+
+#ifdef Q_UTEST
+            if (QS_LOC_CHECK_(m_prio)) {
+                QS::onTestPost(sender, this, e, true); // QUTest callback
+            }
+#endif // def Q_UTEST
+
+            // NOTE: the event might be consumed right after publishing
+            m_eQueue.put_(idx, e);
+            idx = (idx < m_eQueue.m_end) ? (idx + 1U) : 0U;
+        }
+
+        // was the queue empty before this post or is the AO waiting for
+        // an event to be published? (single wakeup for all, see NOTE3 in
+        // "qmpscq.hpp")
+        if (((ctl & CTL_NFREE_MASK)
+             == (static_cast<std::uint32_t>(m_eQueue.m_end) + 1U))
+            || m_eQueue.m_waiting.load(std::memory_order_seq_cst))
+        {
+            QACTIVE_EQUEUE_SIGNAL_(this); // signal the Active Object
+        }
+    }
+    else { // events cannot be posted
+        // the queue must not overflow when posting without margin
+        Q_ASSERT_LOCAL(160, margin != QF::NO_MARGIN);
+
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            QS_CRIT_ENTRY();
+            QS_BEGIN_PRE(QS_QF_ACTIVE_POST_ATTEMPT, m_prio)
+                QS_TIME_PRE();       // timestamp
+                QS_OBJ_PRE(sender);  // the sender object
+                QS_SIG_PRE(evts[i]->sig); // the signal of the event
+                QS_OBJ_PRE(this);    // this active object (recipient)
+                QS_2U8_PRE(evts[i]->poolNum_, evts[i]->refCtr_);
+                QS_EQC_PRE(ctl & CTL_NFREE_MASK); // # free entries
+                QS_EQC_PRE(margin);  // margin requested
+            QS_END_PRE()
+            QS_CRIT_EXIT();
+
+#ifdef Q_UTEST
+            if (QS_LOC_CHECK_(m_prio)) {
+                QS::onTestPost(sender, this, evts[i], false); // QUTest
+            }
+#endif // def Q_UTEST
+
+#if (QF_MAX_EPOOL > 0U)
+            QF::gc(evts[i]); // recycle the event to avoid a leak
+#endif // (QF_MAX_EPOOL > 0U)
+        }
+    }
+
+    return status;
+}
+
+//............................................................................
+void QActive::postLIFO(QEvt const * const e) noexcept {
+#ifdef Q_UTEST // test?
+#if (Q_UTEST != 0) // testing QP-stub?
+    if (m_temp.fun == Q_STATE_CAST(0)) { // QActiveDummy?
+        static_cast<QActiveDummy *>(this)->QActiveDummy::fakePostLIFO(e);
+        return;
+    }
+#endif // (Q_UTEST != 0)
+#endif // def Q_UTEST
+
+    // the event to post must be be valid (which includes not NULL)
+    Q_REQUIRE_LOCAL(200, e != nullptr);
+
+#if (QF_MAX_EPOOL > 0U)
+    if (e->poolNum_ != 0U) { // is it a mutable event?
+        QF_CRIT_STAT
+        QF_EVT_CRIT_ENTRY_(e);
+        QEvt_refCtr_incEvt_(e); // increment the reference counter
+        QF_EVT_CRIT_EXIT_(e);
+    }
+#endif // (QF_MAX_EPOOL > 0U)
+
+    // NOTE: only the AO's own thread can post LIFO, see NOTE3 in qp_port.hpp
+    QEQueueCtr nFree = 0U;
+    if (!m_eQueue.putFront_(e, nFree)) { // queue full?
+#if (QF_MAX_EPOOL > 0U)
+        if (e->poolNum_ != 0U) { // is it a mutable event?
+            QF_CRIT_STAT
+            QF_EVT_CRIT_ENTRY_(e);
+            QEvt_refCtr_dec_(e); // undo the increment above
+            QF_EVT_CRIT_EXIT_(e);
+        }
+#endif // (QF_MAX_EPOOL > 0U)
+
+        // the queue must NOT overflow for the LIFO posting policy.
+        Q_ERROR_LOCAL(230);
+        return;
+    }
+
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_BEGIN_PRE(QS_QF_ACTIVE_POST_LIFO, m_prio)
+        QS_TIME_PRE();       // timestamp
+        QS_SIG_PRE(e->sig);  // the signal of this event
+        QS_OBJ_PRE(this);    // this active object
+        QS_2U8_PRE(e->poolNum_, e->refCtr_);
+        QS_EQC_PRE(nFree);   // # free entries
+        QS_EQC_PRE(m_eQueue.getMin()); // min # free entries
+    QS_END_PRE()
+    QS_CRIT_EXIT();
+
+#ifdef Q_UTEST
+    // callback to examine the posted event under the same conditions
+    // as producing the #QS_QF_ACTIVE_POST trace record, which are:
+    // the local filter for this AO ('m_prio') is set
+    if (QS_LOC_CHECK_(m_prio)) {
+        QS::onTestPost(nullptr, this, e, true);
+    }
+#endif // def Q_UTEST
+}
+
+//............................................................................
+QEvt const * QActive::get_() noexcept {
+    // wait for event to arrive directly (depends on QP port)
+    QACTIVE_EQUEUE_WAIT_(this);
+
+    // the producer that reserved the head slot might not have published
+    // its event yet, see NOTE3 in "qmpscq.hpp"
+    for (std::uint_fast16_t n = PUBLISH_SPIN_MAX;
+         (n > 0U) && (!m_eQueue.isPublished_());
+         --n)
+    {
+        relax();
+    }
+    if (!m_eQueue.isPublished_()) { // producer preempted before publishing?
+        QACTIVE_EQUEUE_PUBLISH_WAIT_(this); // block until published
+    }
+
+    QEQueueCtr nFree = 0U;
+    QEvt const * const e = m_eQueue.take_(nFree);
+
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    if (nFree <= m_eQueue.m_end) { // any more events in the queue?
+        QS_BEGIN_PRE(QS_QF_ACTIVE_GET, m_prio)
+            QS_TIME_PRE();       // timestamp
+            QS_SIG_PRE(e->sig);  // the signal of this event
+            QS_OBJ_PRE(this);    // this active object
+            QS_2U8_PRE(e->poolNum_, e->refCtr_);
+            QS_EQC_PRE(nFree);   // # free entries
+        QS_END_PRE()
+    }
+    else {
+        QS_BEGIN_PRE(QS_QF_ACTIVE_GET_LAST, m_prio)
+            QS_TIME_PRE();       // timestamp
+            QS_SIG_PRE(e->sig);  // the signal of this event
+            QS_OBJ_PRE(this);    // this active object
+            QS_2U8_PRE(e->poolNum_, e->refCtr_);
+        QS_END_PRE()
+    }
+    QS_CRIT_EXIT();
+
+    return e;
+}
+
+#ifdef QF_DISPATCH_QUOTA
+//............................................................................
+std::uint_fast16_t QActive::getBatch_(
+    QEvt const ** const evts,
+    std::uint_fast16_t const max) noexcept
+{
+    // the batch must be in range
+    Q_REQUIRE_LOCAL(380, (0U < max) && (max <= QF_DISPATCH_QUOTA));
+
+    // NOTE: taking an event from the MPSC queue does not need the critical
+    // section, so the batch only saves the re-scheduling of the AO
+    std::uint_fast16_t n = 0U;
+    do {
+        evts[n] = get_(); // BLOCKs only for the first event
+        ++n;
+    } while ((n < max) && (!m_eQueue.isEmpty()));
+
+    return n;
+}
+#endif // def QF_DISPATCH_QUOTA
+
+//............................................................................
+std::uint16_t QActive::getQueueUse(QPrio const prio) noexcept {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // prio must be in range. prio==0 is OK (special case)
+    Q_REQUIRE_INCRIT(500, prio <= QF_MAX_ACTIVE);
+
+    std::uint16_t nUse = 0U;
+
+    if (prio > 0U) {
+        QActive const * const a = QActive_registry_[prio];
+        // the AO must be registered (started)
+        Q_REQUIRE_INCRIT(510, a != nullptr);
+
+        nUse = a->m_eQueue.getUse();
+    }
+    else { // special case of prio==0U: use of all AO event queues
+        for (QPrio p = QF_MAX_ACTIVE; p > 0U; --p) {
+            QActive const * const a = QActive_registry_[p];
+            if (a != nullptr) { // is the AO registered?
+                nUse += a->m_eQueue.getUse();
+            }
+        }
+    }
+
+    QF_CRIT_EXIT();
+
+    return nUse;
+}
+
+//............................................................................
+std::uint16_t QActive::getQueueFree(QPrio const prio) noexcept {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    Q_REQUIRE_INCRIT(600, (0U < prio) && (prio <= QF_MAX_ACTIVE));
+
+    QActive const * const a = QActive_registry_[prio];
+    // the AO must be registered (started)
+    Q_REQUIRE_INCRIT(610, a != nullptr);
+
+    // NOTE: the free count can change asynchronously (snapshot only)
+    std::uint16_t const nFree = a->m_eQueue.getFree();
+    QF_CRIT_EXIT();
+
+    return nFree;
+}
+
+//............................................................................
+std::uint16_t QActive::getQueueMin(QPrio const prio) noexcept {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the queried prio. must be in range (excluding the idle thread)
+    Q_REQUIRE_INCRIT(700, (0U < prio) && (prio <= QF_MAX_ACTIVE));
+
+    QActive const * const a = QActive_registry_[prio];
+    // the AO must be registered (started)
+    Q_REQUIRE_INCRIT(710, a != nullptr);
+
+    std::uint16_t const nMin = a->m_eQueue.getMin();
+
+    QF_CRIT_EXIT();
+
+    return nMin;
+}
+
+//============================================================================
+#if (QF_MAX_TICK_RATE > 0U)
+
+//............................................................................
+QTicker::QTicker(std::uint8_t const tickRate) noexcept
+  : QActive(nullptr)
+{
+    m_eQueue.m_tickRate = tickRate; // the tick rate served
+}
+
+//............................................................................
+void QTicker::init(
+    void const * const e,
+    std::uint_fast8_t const qsId)
+{
+    Q_UNUSED_PAR(e);
+    Q_UNUSED_PAR(qsId);
+
+    // instead of the top-most initial transition, QTicker clears
+    // the number of tick events posted to it, see also QTicker::trig_()
+    m_eQueue.m_nTicks.store(0U, std::memory_order_release);
+}
+
+//............................................................................
+void QTicker::dispatch(
+    QEvt const * const e,
+    std::uint_fast8_t const qsId)
+{
+    Q_UNUSED_PAR(e);
+    Q_UNUSED_PAR(qsId);
+
+    // take all the ticks accumulated so far (the tick event has been
+    // already removed from the queue, so the next trig_() will post again)
+    std::uint8_t nTicks =
+        m_eQueue.m_nTicks.exchange(0U, std::memory_order_acq_rel);
+
+    // QTicker::dispatch() shall be called only when it has tick events
+    Q_REQUIRE_LOCAL(800, nTicks > 0U);
+
+    for (; nTicks > 0U; --nTicks) {
+        QTimeEvt::tick(m_eQueue.m_tickRate, this);
+    }
+}
+
+//............................................................................
+void QTicker::trig_(void const * const sender) noexcept {
+#ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+#endif
+
+    // static immutable (const) event to post to the QTicker AO
+    static constexpr QEvt tickEvt(0U);
+
+    std::uint8_t const nTicks =
+        m_eQueue.m_nTicks.fetch_add(1U, std::memory_order_acq_rel);
+
+    // the nTicks counter must accept one more count without overflowing
+    Q_REQUIRE_LOCAL(950, nTicks < 0xFFU);
+
+    if (nTicks == 0U) { // no ticks accumulated yet?
+        // when no ticks accumulated, the only slot must be free
+        std::uint32_t const ctl =
+            m_eQueue.m_ctl.fetch_sub(1U, std::memory_order_acq_rel);
+        Q_ASSERT_LOCAL(930, (ctl & CTL_NFREE_MASK) == 1U);
+        m_eQueue.updateMin_(0U); // the only slot taken
+
+        // deliver event directly
+        m_eQueue.put_(ctl >> CTL_TAIL_SHIFT, &tickEvt);
+        QACTIVE_EQUEUE_SIGNAL_(this); // signal the event queue
+    }
+
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_BEGIN_PRE(QS_QF_ACTIVE_POST, m_prio)
+        QS_TIME_PRE();      // timestamp
+        QS_OBJ_PRE(sender); // the sender object
+        QS_SIG_PRE(0U);     // the signal of the event
+        QS_OBJ_PRE(this);   // this active object
+        QS_2U8_PRE(0U, 0U); // poolNum & refCtr
+        QS_EQC_PRE(0U);     // # free entries
+        QS_EQC_PRE(0U);     // min # free entries
+    QS_END_PRE()
+    QS_CRIT_EXIT();
+}
+
+#endif // (QF_MAX_TICK_RATE > 0U)
+
+} // namespace QP
+
+#endif // def QACTIVE_EQUEUE_MPSC
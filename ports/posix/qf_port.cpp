@@ -50,6 +50,15 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <signal.h>
+#ifdef QACTIVE_EQUEUE_FUTEX
+    #include <linux/futex.h> // for FUTEX_WAIT_PRIVATE/FUTEX_WAKE_PRIVATE
+#endif
+#if defined(QACTIVE_EQUEUE_FUTEX) || defined(QF_RT_MODE)
+    #include <sys/syscall.h> // for SYS_futex and SYS_sched_setattr
+#endif
+#if defined(QF_RT_MODE) && defined(__GLIBC__)
+    #include <malloc.h>      // for mallopt()
+#endif
 
 namespace { // unnamed local namespace
 
@@ -62,6 +71,19 @@ static pthread_mutex_t l_startupMutex = PTHREAD_MUTEX_INITIALIZER;
 static bool l_isRunning;       // flag indicating when QF is running
 static struct timespec l_tick; // structure for the clock tick
 static int_t l_tickPrio;       // priority of the ticker thread
+static QP::QThreadAttr l_tickAttr; // attributes of the ticker thread
+#ifdef QF_RT_MODE
+static std::uint32_t l_rtStatus;   // real-time guarantees obtained
+#endif
+
+#ifdef QF_SPLIT_CRIT
+// locks for the individual domains of QF, see NOTE4 in "qp_port.hpp"
+// [0] serves the pools outside QF and the immutable (static) events,
+// whose critical sections only check QEvt::poolNum_ (see NOTE4)
+static pthread_mutex_t l_memMutex[QF_MAX_EPOOL + 1U];
+// [QF_MAX_TICK_RATE] serves the out-of-range tick rates (caught later)
+static pthread_mutex_t l_timeMutex[QF_MAX_TICK_RATE + 1U];
+#endif
 
 constexpr long NSEC_PER_SEC {1000000000L};
 constexpr long DEFAULT_TICKS_PER_SEC {100L};
@@ -79,6 +101,152 @@ static void *ao_thread(void *arg) { // thread routine for all AOs
     return nullptr; // return success
 }
 
+#ifdef QF_RT_MODE
+//............................................................................
+// the argument of sched_setattr() (kernel ABI, not provided by the libc)
+struct SchedAttr {
+    std::uint32_t size;
+    std::uint32_t sched_policy;
+    std::uint64_t sched_flags;
+    std::int32_t  sched_nice;
+    std::uint32_t sched_priority;
+    std::uint64_t sched_runtime;
+    std::uint64_t sched_deadline;
+    std::uint64_t sched_period;
+};
+
+//............................................................................
+// switch the calling thread to SCHED_DEADLINE (false if refused)
+static bool setDeadline(QP::QSchedDeadline const &dl) noexcept {
+    SchedAttr sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.size           = sizeof(sa);
+    sa.sched_policy   = SCHED_DEADLINE;
+    sa.sched_flags    = 0x01U; // SCHED_FLAG_RESET_ON_FORK (can start AOs)
+    sa.sched_runtime  = dl.runtime;
+    sa.sched_deadline = (dl.deadline != 0U) ? dl.deadline : dl.period;
+    sa.sched_period   = dl.period;
+    return syscall(SYS_sched_setattr, 0, &sa, 0U) == 0;
+}
+
+//............................................................................
+// touch the unused part of the calling thread's stack
+// (see NOTE10 in "qp_port.hpp")
+static void prefaultStack() noexcept {
+    void *stkAddr = nullptr;
+    std::size_t stkSize = 0U;
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        pthread_attr_getstack(&attr, &stkAddr, &stkSize);
+        pthread_attr_destroy(&attr);
+    }
+    if (stkSize != 0U) {
+        std::uintptr_t const pageSize =
+            static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+        std::uintptr_t const bottom =
+            reinterpret_cast<std::uintptr_t>(stkAddr);
+        // the stack grows down from this frame towards the bottom
+        std::uint8_t volatile here = 0U;
+        std::uintptr_t a = reinterpret_cast<std::uintptr_t>(&here);
+        while (a >= (bottom + pageSize)) {
+            a -= pageSize;
+            *reinterpret_cast<std::uint8_t volatile *>(a) = 0U;
+        }
+    }
+}
+#endif // def QF_RT_MODE
+
+//............................................................................
+// apply the attributes of the calling thread that are not set when the
+// thread is created (the policy falls back to SCHED_OTHER if refused)
+static void applyThreadAttr(QP::QThreadAttr &ta) noexcept {
+#ifdef __linux__
+    if (ta.m_name[0] != '\0') {
+        pthread_setname_np(pthread_self(), &ta.m_name[0]);
+    }
+#endif
+#ifdef QF_RT_MODE
+    if ((ta.m_policy == SCHED_DEADLINE) && !setDeadline(ta.m_dl)) {
+        ta.m_policy = SCHED_OTHER; // report the policy obtained
+    }
+#else
+    Q_UNUSED_PAR(ta);
+#endif
+}
+
+//............................................................................
+// set the thread attribute (false if unsupported or invalid)
+static bool setThreadAttr(QP::QThreadAttr &ta,
+    std::uint32_t const attr1, void const * const attr2) noexcept
+{
+    bool ok = (attr2 != nullptr);
+    if (ok) {
+        switch (attr1) {
+#ifdef __linux__
+            case QP::THREAD_NAME_ATTR:
+                // copy the name, truncated to the Linux limit if needed
+                strncpy(&ta.m_name[0], static_cast<char const *>(attr2),
+                        sizeof(ta.m_name) - 1U);
+                ta.m_name[sizeof(ta.m_name) - 1U] = '\0';
+                break;
+            case QP::CPU_SET_ATTR:
+                ta.m_cpus = *static_cast<cpu_set_t const *>(attr2);
+                ok = (CPU_COUNT(&ta.m_cpus) > 0); // at least one CPU
+                break;
+#endif
+#ifdef QF_RT_MODE
+            case QP::SCHED_DEADLINE_ATTR: {
+                QP::QSchedDeadline const &dl =
+                    *static_cast<QP::QSchedDeadline const *>(attr2);
+                std::uint64_t const deadline =
+                    (dl.deadline != 0U) ? dl.deadline : dl.period;
+                // the kernel requires runtime <= deadline <= period
+                ok = (dl.runtime >= 1024U) && (dl.runtime <= deadline)
+                     && (deadline <= dl.period);
+                if (ok) {
+                    ta.m_dl = dl;
+                    ta.m_policy = SCHED_DEADLINE;
+                }
+                break;
+            }
+#endif
+            case QP::SCHED_POLICY_ATTR: {
+                int const policy = *static_cast<int const *>(attr2);
+                ok = (policy == SCHED_FIFO) || (policy == SCHED_RR)
+                     || (policy == SCHED_OTHER);
+                if (ok) {
+                    ta.m_policy = policy;
+                }
+                break;
+            }
+            default:
+                ok = false;
+                break;
+        }
+    }
+    return ok;
+}
+
+//............................................................................
+// priority of the AO thread with the given scheduling policy, see NOTE04
+static int threadPrio(int const policy, QP::QPrio const prio) {
+    if ((policy != SCHED_FIFO) && (policy != SCHED_RR)) {
+        return 0; // non-real-time policies have no static priorities
+    }
+#if (QF_MAX_ACTIVE <= 64U)
+    return static_cast<int>(prio)
+           + (sched_get_priority_max(policy)
+              - static_cast<int>(QF_MAX_ACTIVE) - 3);
+#else // more AOs than p-thread priorities, see NOTE04
+    int const minPrio = sched_get_priority_min(policy);
+    int const maxPrio = sched_get_priority_max(policy) - 3;
+    return minPrio
+        + static_cast<int>((static_cast<long>(prio) - 1L)
+                           * static_cast<long>(maxPrio - minPrio)
+                           / (static_cast<long>(QF_MAX_ACTIVE) - 1L));
+#endif
+}
+
 //----------------------------------------------------------------------------
 #ifdef __APPLE__
 
@@ -143,15 +311,115 @@ void leaveCriticalSection_() {
     }
 }
 
+#ifdef QACTIVE_EQUEUE_FUTEX
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+    "the futex word must be a plain 32-bit integer");
+
+//............................................................................
+void futexWait_(std::atomic<std::uint32_t> * const word) noexcept {
+    // block only while the word still holds FUTEX_SLEEP_, so a wakeup
+    // issued between setting FUTEX_SLEEP_ and this call is not lost
+    // NOTE: spurious returns (EINTR, EAGAIN) are handled by the caller
+    static_cast<void>(syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE,
+        FUTEX_SLEEP_, nullptr, nullptr, 0));
+}
+//............................................................................
+void futexWake_(std::atomic<std::uint32_t> * const word) noexcept {
+    static_cast<void>(syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE,
+        1, nullptr, nullptr, 0));
+}
+//............................................................................
+void futexWakeAfter_(std::atomic<std::uint32_t> * const word) noexcept {
+    // NOTE: called *outside* the queue crit.sect. (see QACTIVE_EQUEUE_WAKE_)
+    // only one of the threads that saw FUTEX_WAKE_ performs the wakeup;
+    // the word no longer holding FUTEX_WAKE_ means that the AO thread
+    // has already taken the queue crit.sect. again (no wakeup needed)
+    std::uint32_t expected = FUTEX_WAKE_;
+    if (word->compare_exchange_strong(expected, FUTEX_IDLE_,
+            std::memory_order_relaxed))
+    {
+        futexWake_(word);
+    }
+}
+
+#endif // def QACTIVE_EQUEUE_FUTEX
+
+#ifdef QF_SPLIT_CRIT
+
+pthread_mutex_t psMutex_ = PTHREAD_MUTEX_INITIALIZER;
+
+//............................................................................
+pthread_mutex_t *memMutex_(void const * const pool) noexcept {
+    std::uint_fast8_t i = 0U; // pools outside QF share the lock [0]
+#if (QF_MAX_EPOOL > 0U)
+    std::uintptr_t const p = reinterpret_cast<std::uintptr_t>(pool);
+    std::uintptr_t const p0 =
+        reinterpret_cast<std::uintptr_t>(&priv_.ePool_[0]);
+    if ((p0 <= p) && (p < p0 + (QF_MAX_EPOOL * sizeof(QMPool)))) {
+        i = static_cast<std::uint_fast8_t>((p - p0) / sizeof(QMPool)) + 1U;
+    }
+#else
+    Q_UNUSED_PAR(pool);
+#endif
+    return &l_memMutex[i];
+}
+//............................................................................
+pthread_mutex_t *evtMutex_(QEvt const * const e) noexcept {
+    // the reference counter is protected by the lock of the event's pool
+    std::uint_fast8_t const i = ((e != nullptr)
+                                 && (e->poolNum_ <= QF_MAX_EPOOL))
+                                ? e->poolNum_
+                                : 0U;
+    return &l_memMutex[i];
+}
+//............................................................................
+pthread_mutex_t *timeMutex_(std::uint_fast8_t const tickRate) noexcept {
+    return &l_timeMutex[(tickRate < QF_MAX_TICK_RATE)
+                        ? tickRate
+                        : QF_MAX_TICK_RATE];
+}
+
+#endif // QF_SPLIT_CRIT
+
 //............................................................................
 void init() {
+#ifdef QF_RT_MODE
+    // real-time mode, see NOTE10 in "qp_port.hpp"
+    l_rtStatus = RT_AO_SCHED; // until an AO thread fails to get its policy
+
+    // lock memory so we're never swapped out to disk
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+        l_rtStatus |= RT_MEM_LOCKED;
+    }
+#ifdef __GLIBC__
+    // keep the freed heap memory (locked and prefaulted) in the process
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+#else
     // lock memory so we're never swapped out to disk
     //mlockall(MCL_CURRENT | MCL_FUTURE); // un-comment when supported
+#endif
 
     l_tick.tv_sec = 0;
     l_tick.tv_nsec = NSEC_PER_SEC / DEFAULT_TICKS_PER_SEC; // default rate
     l_tickPrio = sched_get_priority_min(SCHED_FIFO); // default ticker prio
 
+#ifdef QF_SPLIT_CRIT
+    // initialize the locks for the individual domains of QF
+    for (auto &m : l_memMutex) {
+        pthread_mutex_init(&m, NULL);
+    }
+    for (auto &m : l_timeMutex) {
+        pthread_mutex_init(&m, NULL);
+    }
+#endif
+
+#ifdef QF_TIMEEVT_TICKLESS
+    QTickless::init(); // the timerfd for the deadline time events
+#endif
+
     // install the SIGINT (Ctrl-C) signal handler
     struct sigaction sig_act;
     memset(&sig_act, 0, sizeof(sig_act));
@@ -174,15 +442,49 @@ int run() {
     // critical section.
     onStartup();
 
-    // try to set the priority of the ticker thread, see NOTE01
+    // try to set the policy and priority of the ticker thread, see NOTE01
+    int policy = l_tickAttr.m_policy;
+#ifdef QF_RT_MODE
+    int const tickPolicy = policy; // the requested policy
+    if (policy == SCHED_DEADLINE) {
+        policy = SCHED_OTHER; // SCHED_DEADLINE set in applyThreadAttr()
+    }
+#endif
     struct sched_param sparam;
-    sparam.sched_priority = l_tickPrio;
-    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sparam) == 0) {
+    sparam.sched_priority = ((policy == SCHED_FIFO) || (policy == SCHED_RR))
+                            ? l_tickPrio
+                            : 0;
+    if (pthread_setschedparam(pthread_self(), policy, &sparam) == 0) {
         // success, this application has sufficient privileges
     }
     else {
         // setting priority failed, probably due to insufficient privileges
+        l_tickAttr.m_policy = SCHED_OTHER; // report the policy obtained
+    }
+
+#ifdef __linux__
+    // place the ticker thread, see NOTE9 in "qp_port.hpp"
+    if (CPU_COUNT(&l_tickAttr.m_cpus) > 0) {
+        int const err = pthread_setaffinity_np(pthread_self(),
+                            sizeof(cpu_set_t), &l_tickAttr.m_cpus);
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        Q_ASSERT_INCRIT(320, err == 0); // the CPU set must be valid
+        QF_CRIT_EXIT();
+#ifdef Q_UNSAFE
+        Q_UNUSED_PAR(err);
+#endif
     }
+#endif
+    applyThreadAttr(l_tickAttr); // the name and SCHED_DEADLINE
+#ifdef QF_RT_MODE
+    if (l_tickAttr.m_policy == tickPolicy) { // policy obtained?
+        QF_CRIT_STAT
+        QF_CRIT_ENTRY();
+        l_rtStatus |= RT_TICK_SCHED;
+        QF_CRIT_EXIT();
+    }
+#endif
 
     // unlock the startup mutex to unblock any active objects
     // started before calling QF_run()
@@ -190,6 +492,23 @@ int run() {
 
     l_isRunning = true;
 
+#ifdef QF_TIMEEVT_TICKLESS
+    // clock tick and deadline time events from timerfd, NOTE5 in qp_port.hpp
+    std::uint64_t const period =
+        (static_cast<std::uint64_t>(l_tick.tv_sec) * NSEC_PER_SEC)
+        + static_cast<std::uint64_t>(l_tick.tv_nsec);
+    std::uint64_t nextTick = QTickless::now();
+    if (period != 0U) {
+        // round down to the nearest configured period and advance
+        nextTick = ((nextTick / period) + 1U) * period;
+    }
+    while (l_isRunning) { // the timer loop...
+        if (QTickless::wait(nextTick, period)) { // clock tick due?
+            // clock tick callback (must call QTimeEvt::TICK_X() once)
+            onClockTick();
+        }
+    }
+#else
     // The provided clock tick service configured?
     if ((l_tick.tv_sec != 0) || (l_tick.tv_nsec != 0)) {
 
@@ -231,6 +550,7 @@ int run() {
             onClockTick();
         }
     }
+#endif // QF_TIMEEVT_TICKLESS
     onCleanup(); // cleanup callback
     QS_EXIT();   // cleanup the QSPY connection
 
@@ -242,7 +562,33 @@ int run() {
 //............................................................................
 void stop() {
     l_isRunning = false; // terminate the main (ticker) thread
+#ifdef QF_TIMEEVT_TICKLESS
+    QTickless::wake(); // unblock the timer loop so it can terminate
+#endif
+}
+#ifdef QF_RT_MODE
+//............................................................................
+std::uint32_t getRtStatus() noexcept {
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    std::uint32_t const status = l_rtStatus;
+    QF_CRIT_EXIT();
+    return status;
+}
+//............................................................................
+void prefault_(void * const mem, std::uint_fast32_t const size) noexcept {
+    // write every page (with its own content), so it gets mapped for good
+    std::uint_fast32_t const pageSize =
+        static_cast<std::uint_fast32_t>(sysconf(_SC_PAGESIZE));
+    std::uint8_t volatile * const p = static_cast<std::uint8_t *>(mem);
+    for (std::uint_fast32_t i = 0U; i < size; i += pageSize) {
+        p[i] = p[i];
+    }
+    if (size > 0U) { // the last page (unless already touched)
+        p[size - 1U] = p[size - 1U];
+    }
 }
+#endif // def QF_RT_MODE
 //............................................................................
 void setTickRate(std::uint32_t ticksPerSec, int tickPrio) {
     // NOTE: called inside crit.section
@@ -254,6 +600,17 @@ void setTickRate(std::uint32_t ticksPerSec, int tickPrio) {
     }
     l_tickPrio = tickPrio;
 }
+//............................................................................
+void setTickAttr(std::uint32_t attr1, void const *attr2) {
+    // NOTE: this function must be called *before* QF::run()
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+    Q_REQUIRE_INCRIT(300, !l_isRunning);
+    if (!setThreadAttr(l_tickAttr, attr1, attr2)) {
+        Q_ERROR_INCRIT(310); // unsupported or invalid attribute
+    }
+    QF_CRIT_EXIT();
+}
 
 // console access ============================================================
 #ifdef QF_CONSOLE
@@ -297,6 +654,14 @@ int consoleWaitForKey() {
 
 // QActive functions =========================================================
 void QActive::evtLoop_(QActive *act) {
+    // apply the remaining attributes of this AO thread
+    // (see NOTE9 in "qp_port.hpp")
+    applyThreadAttr(act->m_osObject.m_attr);
+#ifdef QF_RT_MODE
+    prefaultStack(); // see NOTE10 in "qp_port.hpp"
+    sem_post(act->m_osObject.m_started); // unblock QActive::start()
+#endif
+
     // block this thread until the startup mutex is unlocked from QF::run()
     pthread_mutex_lock(&l_startupMutex);
     pthread_mutex_unlock(&l_startupMutex);
@@ -307,11 +672,30 @@ void QActive::evtLoop_(QActive *act) {
 #else
     for (;;) { // for-ever
 #endif
+#ifndef QF_DISPATCH_QUOTA
         QEvt const * const e = act->get_(); // BLOCK for event
-        act->dispatch(e, act->m_prio); // virtual call
+        act->dispatch_(&e, 1U); // virtual or static, NOTE2 in qf_qact.cpp
 #if (QF_MAX_EPOOL > 0U)
         QF::gc(e); // check if the event is garbage, and collect it if so
 #endif
+#else // drain up to QF_DISPATCH_QUOTA events (NOTE1 in qf_actq.cpp)
+        QEvt const *evts[QF_DISPATCH_QUOTA];
+        std::uint_fast16_t const n =
+            act->getBatch_(&evts[0], QF_DISPATCH_QUOTA); // BLOCK for event
+#ifdef QACTIVE_CAN_STOP
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            if (!act->m_thread) { // AO stopped itself in this batch?
+                break; // the rest of the batch is only garbage-collected
+            }
+            act->dispatch_(&evts[i], 1U);
+        }
+#else
+        act->dispatch_(&evts[0], n); // the whole batch
+#endif
+#if (QF_MAX_EPOOL > 0U)
+        QF::gcBatch_(&evts[0], n); // collect the garbage events
+#endif
+#endif // QF_DISPATCH_QUOTA
     }
 #ifdef QACTIVE_CAN_STOP
     act->unregister_(); // remove this object from QF
@@ -331,13 +715,34 @@ void QActive::start(QPrioSpec const prioSpec,
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
     Q_REQUIRE_INCRIT(800, stkSto == nullptr);
+#ifdef QACTIVE_EQUEUE_SPIN
+    // unbounded polling only without a real-time policy, see NOTE8
+    Q_REQUIRE_INCRIT(805,
+        (m_osObject.m_spin.getPolicy() != WAIT_POLL_ATTR)
+        || ((m_osObject.m_attr.m_policy != SCHED_FIFO)
+            && (m_osObject.m_attr.m_policy != SCHED_RR)));
+#endif
     QF_CRIT_EXIT();
 
-    // create the condition variable to throttle the AO's event queue
-    pthread_cond_init(&m_osObject, 0);
+#if defined(QACTIVE_EQUEUE_MPSC) || defined(QF_SPLIT_CRIT) \
+    || defined(QACTIVE_EQUEUE_FUTEX)
+    // create the mutex of the AO's event queue
+    pthread_mutex_init(&m_osObject.m_mutex, 0);
+#endif
+#ifdef QACTIVE_EQUEUE_FUTEX
+    // initialize the futex word to block on the empty queue
+    // (see NOTE7 in "qp_port.hpp")
+    m_osObject.m_futex.store(QF::FUTEX_IDLE_, std::memory_order_relaxed);
+#else
+    // create the condition variable to block on the empty queue
+    pthread_cond_init(&m_osObject.m_cond, 0);
+#endif
+#ifdef QF_RT_MODE
+    QF::prefault_(qSto, qLen * sizeof(QEvtPtr)); // see NOTE10
+#endif
     m_eQueue.init(qSto, qLen);
 
-    m_prio  = static_cast<std::uint8_t>(prioSpec & 0xFFU); // QF-priority
+    m_prio  = static_cast<QPrio>(prioSpec); // QF-prio. (low part of prioSpec)
     m_pthre = 0U; // preemption-threshold (not used in this port)
     register_(); // register this AO
 
@@ -348,29 +753,49 @@ void QActive::start(QPrioSpec const prioSpec,
     pthread_attr_t attr;
     pthread_attr_init(&attr);
 
-    // SCHED_FIFO corresponds to real-time preemptive priority-based scheduler
+    // SCHED_FIFO (default) corresponds to real-time preemptive
+    // priority-based scheduler, see NOTE9 in "qp_port.hpp"
     // NOTE: This scheduling policy requires the superuser privileges
-    pthread_attr_setschedpolicy (&attr, SCHED_FIFO);
+    int policy = m_osObject.m_attr.m_policy;
+#ifdef QF_RT_MODE
+    int const aoPolicy = policy; // the requested policy
+    if (policy == SCHED_DEADLINE) {
+        policy = SCHED_OTHER; // SCHED_DEADLINE set by the AO thread itself
+    }
+#endif
+    pthread_attr_setschedpolicy (&attr, policy);
     pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
     pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
 
     // priority of the p-thread, see NOTE04
     struct sched_param param;
-    param.sched_priority = static_cast<int>(m_prio)
-                           + (sched_get_priority_max(SCHED_FIFO)
-                              - static_cast<int>(QF_MAX_ACTIVE) - 3);
+    param.sched_priority = threadPrio(policy, m_prio);
     pthread_attr_setschedparam(&attr, &param);
 
+#ifdef __linux__
+    // CPU affinity of the p-thread, see NOTE9 in "qp_port.hpp"
+    if (CPU_COUNT(&m_osObject.m_attr.m_cpus) > 0) {
+        pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t),
+                                    &m_osObject.m_attr.m_cpus);
+    }
+#endif
+
     pthread_attr_setstacksize(&attr,
         (stkSize < static_cast<std::uint_fast16_t>(PTHREAD_STACK_MIN)
         ? static_cast<std::size_t>(PTHREAD_STACK_MIN)
         : stkSize));
+#ifdef QF_RT_MODE
+    sem_t started; // the AO thread has applied its attributes
+    sem_init(&started, 0, 0U);
+    m_osObject.m_started = &started;
+#endif
     pthread_t thread;
     int err = pthread_create(&thread, &attr, &ao_thread, this);
-    if (err != 0) {
-        // Creating p-thread with the SCHED_FIFO policy failed. Most likely
+    if ((err != 0) && (policy != SCHED_OTHER)) {
+        // Creating p-thread with the real-time policy failed. Most likely
         // this application has no superuser privileges, so we just fall
         // back to the default SCHED_OTHER policy and priority 0.
+        m_osObject.m_attr.m_policy = SCHED_OTHER; // the policy obtained
         pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
         param.sched_priority = 0;
         pthread_attr_setschedparam(&attr, &param);
@@ -380,12 +805,67 @@ void QActive::start(QPrioSpec const prioSpec,
     Q_ASSERT_INCRIT(810, err == 0); // AO thread must be created
     QF_CRIT_EXIT();
 
+#ifdef QF_RT_MODE
+    // wait until the AO thread has applied its attributes, see NOTE10
+    while (sem_wait(&started) != 0) { // interrupted by a signal?
+    }
+    sem_destroy(&started);
+    if (m_osObject.m_attr.m_policy != aoPolicy) { // policy not obtained?
+        QF_CRIT_ENTRY();
+        l_rtStatus &= ~static_cast<std::uint32_t>(QF::RT_AO_SCHED);
+        QF_CRIT_EXIT();
+    }
+#endif
+
     //pthread_attr_getschedparam(&attr, &param);
     //printf("param.sched_priority==%d\n", param.sched_priority);
 
     pthread_attr_destroy(&attr);
 }
 
+//............................................................................
+void QActive::setAttr(std::uint32_t attr1, void const *attr2) {
+    // NOTE: this function must be called *before* QActive::start()
+    QF_CRIT_STAT
+    QF_CRIT_ENTRY();
+
+    // the AO must not be started yet
+    Q_REQUIRE_INCRIT(900, m_prio == 0U);
+
+    switch (attr1) {
+#ifdef QACTIVE_EQUEUE_SPIN
+        case WAIT_BLOCK_ATTR: // intentionally fall through
+        case WAIT_SPIN_ATTR:  // intentionally fall through
+        case WAIT_POLL_ATTR:
+            // attr2: the max. spin duration [us] or nullptr (default)
+            m_osObject.m_spin.init(
+                // spinning is futile without another CPU to post events
+                (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? attr1 : WAIT_BLOCK_ATTR,
+                (attr2 != nullptr)
+                    ? *static_cast<std::uint32_t const *>(attr2)
+                    : QSpinWait::DEFAULT_MAX_SPIN);
+            break;
+#else
+        case WAIT_BLOCK_ATTR: // the only waiting policy available
+            Q_UNUSED_PAR(attr2);
+            break;
+#endif
+        case THREAD_NAME_ATTR: // intentionally fall through
+        case CPU_SET_ATTR:     // intentionally fall through
+        case SCHED_POLICY_ATTR: // intentionally fall through
+        case SCHED_DEADLINE_ATTR:
+            // applied in QActive::start(), see NOTE9 in "qp_port.hpp"
+            if (!setThreadAttr(m_osObject.m_attr, attr1, attr2)) {
+                Q_ERROR_INCRIT(920); // unsupported or invalid value
+            }
+            break;
+        default:
+            Q_ERROR_INCRIT(910); // unsupported attribute
+            break;
+    }
+    QF_CRIT_EXIT();
+}
+
 //............................................................................
 #ifdef QACTIVE_CAN_STOP
 void QActive::stop() {
@@ -428,4 +908,9 @@ void QActive::stop() {
 // three highest p-thread priorities for the ISR-like threads (e.g., I/O),
 // and the remaining highest-priorities for the active objects.
 //
+// With QF_MAX_ACTIVE above 64, there are more QF priorities than SCHED_FIFO
+// priorities, so the QF priorities are scaled linearly to the available
+// p-thread priorities. Several AOs then share one p-thread priority level,
+// but a higher QF priority never maps to a lower p-thread priority.
+//
 
@@ -0,0 +1,118 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#ifndef QMPSCQ_HPP_
+#define QMPSCQ_HPP_
+
+#include <atomic>  // std::atomic<> template. C++11 Standard
+
+namespace QP {
+
+//----------------------------------------------------------------------------
+// Lock-free multiple-producer/single-consumer event queue for AOs, see NOTE1
+class QMPSCQueue {
+public:
+    QMPSCQueue() noexcept;
+    void init(
+        QEvtPtr * const qSto,
+        std::uint_fast16_t const qLen) noexcept;
+    std::uint16_t getFree() const noexcept;
+    std::uint16_t getUse() const noexcept;
+    std::uint16_t getMin() const noexcept;
+    bool isEmpty() const noexcept;
+
+private:
+    QEvtPtr m_frontEvt;   // the extra slot (the ring holds qLen + 1 events)
+    QEvtPtr * m_ring;     // ring buffer provided by the application
+    QEQueueCtr m_end;     // index of the extra slot (m_frontEvt)
+    QEQueueCtr m_head;    // index for removing events (consumer only)
+    std::atomic<std::uint32_t> m_ctl;   // [tail:16 | nFree:16], see NOTE2
+    std::atomic<QEQueueCtr> m_nMin;     // min # free entries so far
+    std::atomic<bool> m_waiting;  // consumer waits for publishing, NOTE3
+    std::atomic<std::uint8_t> m_nTicks; // # ticks pending (QTicker only)
+    std::uint8_t m_tickRate;      // tick rate served (QTicker only)
+
+    bool reserve_(
+        std::uint_fast16_t const n,
+        std::uint_fast16_t const margin,
+        std::uint32_t &ctl) noexcept;
+    void put_(
+        std::uint_fast16_t const idx,
+        QEvt const * const e) noexcept;
+    bool putFront_(
+        QEvt const * const e,
+        QEQueueCtr &nFree) noexcept;
+    bool isPublished_() const noexcept;
+    QEvt const *take_(QEQueueCtr &nFree) noexcept;
+    QEvtPtr *slot_(std::uint_fast16_t const idx) noexcept;
+    void updateMin_(QEQueueCtr const nFree) noexcept;
+
+    // friends...
+    friend class QActive;
+    friend class QTicker;
+}; // class QMPSCQueue
+
+} // namespace QP
+
+//============================================================================
+// NOTE1:
+// QMPSCQueue replaces the native QEQueue as the AO event queue in the POSIX
+// port when QACTIVE_EQUEUE_MPSC is defined in "qp_config.hpp". Producers
+// (any thread posting to the AO) reserve a slot with a single compare-and-
+// swap on the control word m_ctl and then publish the event pointer into
+// that slot. The only consumer (the AO thread) removes events without any
+// read-modify-write on the producer side other than returning the slot.
+// Consequently, posting events to different AOs never contends on a common
+// lock, and posting to the same AO costs one CAS.
+// QActive::postBatchx_() reserves a run of consecutive slots for a whole
+// batch of events with the same single CAS.
+//
+// The ring has qLen + 1 slots (the application-provided storage plus the
+// m_frontEvt slot), so the free-entry statistics (getFree(), getMin()) are
+// identical to the native QEQueue of the same length.
+//
+// NOTE2:
+// The control word combines the index of the next slot to be reserved
+// (tail) and the number of free entries (nFree), so that the margin check,
+// the free-count update, and the slot reservation happen atomically in one
+// CAS. The consumer returns a slot by atomically incrementing the word,
+// which changes only the nFree part (nFree can never exceed qLen + 1).
+//
+// NOTE3:
+// A producer publishes its event only after reserving the slot, so the
+// consumer can find the head slot reserved, but still empty, when the
+// producer has been preempted in between. Under SCHED_FIFO, or when the
+// producer and the AO share a CPU, spinning on such a slot could starve
+// the producer forever. Therefore the consumer spins only briefly and then
+// blocks on its OS object (QACTIVE_EQUEUE_PUBLISH_WAIT_()) with m_waiting
+// set. Every producer checks m_waiting after publishing its event and
+// signals the AO if it is set. Both sides access the slot and m_waiting
+// with sequentially consistent operations, so the wakeup cannot be lost.
+//
+
+#endif // QMPSCQ_HPP_
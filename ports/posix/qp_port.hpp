@@ -32,7 +32,28 @@
 #include <cstdint>        // Exact-width types. C++11 Standard
 #include <array>          // std::array<> template. C++11 Standard
 #include <pthread.h>      // POSIX-thread API
+#include <sched.h>        // scheduling policies and CPU sets
 #include "qp_config.hpp"  // QP configuration from the application
+#ifdef QACTIVE_EQUEUE_FUTEX
+#include <atomic>         // std::atomic<> template. C++11 Standard
+#endif
+#ifdef QACTIVE_EQUEUE_SPIN
+#include <time.h>         // for clock_gettime()
+#endif
+#ifdef QF_RT_MODE
+#if !defined(__linux__)
+    #error QF_RT_MODE is supported only on Linux, see NOTE10
+#endif
+#include <semaphore.h>    // for sem_t
+#endif
+
+#ifdef Q_SPY
+#ifdef QF_SPLIT_CRIT
+    #error QF_SPLIT_CRIT is not supported in the Spy build, see NOTE4
+#endif
+    // every allocated and recycled event must be traced by the pool
+    #undef QF_EPOOL_MAGAZINE
+#endif
 
 // no-return function specifier (C++11 Standard)
 #define Q_NORETURN  [[ noreturn ]] void
@@ -41,8 +62,12 @@
 #define Q_ASSERT_STATIC(expr_)  static_assert((expr_), "QP static assert")
 
 // QActive event queue and thread types for POSIX
-#define QACTIVE_EQUEUE_TYPE  QEQueue
-#define QACTIVE_OS_OBJ_TYPE  pthread_cond_t
+#ifndef QACTIVE_EQUEUE_MPSC
+    #define QACTIVE_EQUEUE_TYPE  QEQueue
+#else // lock-free multiple-producer/single-consumer AO queues, see NOTE3
+    #define QACTIVE_EQUEUE_TYPE  QMPSCQueue
+#endif
+#define QACTIVE_OS_OBJ_TYPE  OsObject
 #define QACTIVE_THREAD_TYPE  bool
 
 // QF critical section for POSIX, see NOTE1
@@ -51,7 +76,15 @@
 #define QF_CRIT_EXIT()       QP::QF::leaveCriticalSection_()
 #define QF_CRIT_EST()        QP::QF::enterCriticalSection_()
 
+#if (QF_MAX_ACTIVE > 64U)
+// QF_LOG2 based on the count-leading-zeros builtin (GCC/Clang) for the
+// hierarchical QPSet (__builtin_clz(0) is undefined, so LOG2(0) is 0)
+#define QF_LOG2(n_) (static_cast<std::uint8_t>(((n_) != 0U) \
+    ? (32U - static_cast<unsigned>(__builtin_clz(static_cast<unsigned>(n_)))) \
+    : 0U))
+#else
 // QF_LOG2 not defined -- use the internal LOG2() implementation
+#endif
 
 namespace QP {
 namespace QF {
@@ -63,9 +96,25 @@ void leaveCriticalSection_();
 // set clock tick rate and priority
 void setTickRate(uint32_t ticksPerSec, int tickPrio);
 
+// set the attributes of the ticker thread in QF::run(), see NOTE9
+void setTickAttr(std::uint32_t attr1, void const *attr2);
+
 // clock tick callback
 void onClockTick();
 
+#ifdef QF_RT_MODE
+// real-time guarantees actually obtained, see NOTE10
+enum RtStatus : std::uint32_t {
+    RT_MEM_LOCKED = (1U << 0U), // all memory locked in RAM (mlockall())
+    RT_AO_SCHED   = (1U << 1U), // all AO threads got their sched. policy
+    RT_TICK_SCHED = (1U << 2U)  // the ticker thread got its sched. policy
+};
+std::uint32_t getRtStatus() noexcept;
+
+// touch every page of the memory, so it is resident, see NOTE10
+void prefault_(void * const mem, std::uint_fast32_t const size) noexcept;
+#endif
+
 #ifdef QF_CONSOLE
     // abstractions for console access...
     void consoleSetup();
@@ -75,11 +124,172 @@ void onClockTick();
 #endif
 
 } // namespace QF
+
+// attributes of the AO threads (see QActive::setAttr())
+enum POSIX_ThreadAttrs : std::uint32_t {
+    WAIT_BLOCK_ATTR, // block on the empty queue (default)
+    WAIT_SPIN_ATTR,  // spin, then block; attr2: max. spin [us], see NOTE8
+    WAIT_POLL_ATTR,  // busy-poll the empty queue (never block)
+    THREAD_NAME_ATTR, // attr2: thread name (char const *), see NOTE9
+    CPU_SET_ATTR,     // attr2: CPU affinity (cpu_set_t const *), see NOTE9
+    SCHED_POLICY_ATTR, // attr2: scheduling policy (int const *), see NOTE9
+    SCHED_DEADLINE_ATTR // attr2: QSchedDeadline const *, see NOTE10
+};
+
+#ifdef QF_RT_MODE
+// parameters of the SCHED_DEADLINE policy [ns], see NOTE10
+struct QSchedDeadline {
+    std::uint64_t runtime;  // CPU time reserved in every period
+    std::uint64_t deadline; // relative deadline (0: the period)
+    std::uint64_t period;   // period of the reservation
+};
+#endif
+
+// thread attributes applied when the thread starts, see NOTE9
+struct QThreadAttr {
+#ifdef __linux__
+    cpu_set_t m_cpus {};  // CPU affinity (empty: inherited)
+    char m_name[16] {};   // thread name (empty: inherited)
+#endif
+    int m_policy {SCHED_FIFO}; // scheduling policy
+#ifdef QF_RT_MODE
+    QSchedDeadline m_dl {};    // SCHED_DEADLINE parameters
+#endif
+};
+
+#ifdef QACTIVE_EQUEUE_SPIN
+// adaptive spinning of an AO thread on the empty queue, see NOTE8
+class QSpinWait {
+public:
+    static constexpr std::uint32_t DEFAULT_MAX_SPIN {50U}; // [us]
+
+    void init(
+        std::uint32_t const policy,
+        std::uint32_t const maxSpin) noexcept
+    {
+        m_policy  = static_cast<std::uint8_t>(policy);
+        m_maxSpin = (maxSpin <= (0xFFFFFFFFU / 1000U))
+            ? (maxSpin * 1000U)  // [us] -> [ns]
+            : 0xFFFFFFFFU;       // clamped to ~4.29s
+        m_avg     = m_maxSpin / 2U;  // start with spinning
+        m_budget  = 0U;
+        m_t0      = 0U;
+    }
+
+    // start waiting on the empty queue; should the thread spin?
+    bool begin() noexcept {
+        bool doSpin = false;
+        if (m_policy == WAIT_SPIN_ATTR) {
+            m_t0 = now_();
+            // spin only when the events tend to arrive within the limit
+            m_budget = (m_avg <= m_maxSpin)
+                ? ((m_avg < (m_maxSpin / 2U)) ? (2U * m_avg) : m_maxSpin)
+                : 0U;
+            doSpin = (m_budget != 0U);
+        }
+        else if (m_policy == WAIT_POLL_ATTR) {
+            doSpin = true;
+        }
+        else {
+            // empty
+        }
+        return doSpin;
+    }
+
+    // spin until ready() or until the spin budget runs out
+    template<typename Ready_>
+    void spin(Ready_ const &ready) noexcept {
+        std::uint64_t const deadline = m_t0 + m_budget;
+        std::uint32_t n = 0U;
+        while (!ready()) {
+            relax_();
+            ++n;
+            if (((n & 0x3FU) == 0U) // check the time only once in a while
+                && (m_policy != WAIT_POLL_ATTR)
+                && (now_() >= deadline))
+            {
+                break; // the spin budget exhausted (the thread will block)
+            }
+        }
+    }
+
+    // an event has arrived (after spinning or blocking)
+    void end() noexcept {
+        if (m_policy == WAIT_SPIN_ATTR) {
+            std::uint64_t dt = now_() - m_t0;
+            if (dt > 0xFFFFFFFFU) {
+                dt = 0xFFFFFFFFU;
+            }
+            // exponentially weighted moving average (1/8) of the waits
+            m_avg = static_cast<std::uint32_t>(
+                ((7U * static_cast<std::uint64_t>(m_avg)) + dt) / 8U);
+        }
+    }
+
+    std::uint8_t getPolicy() const noexcept {
+        return m_policy;
+    }
+
+    static void relax_() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ volatile ("yield" ::: "memory");
+#else
+        __asm__ volatile ("" ::: "memory");
+#endif
+    }
+
+    static std::uint64_t now_() noexcept {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (static_cast<std::uint64_t>(ts.tv_sec) * 1000000000U)
+               + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+private:
+    std::uint64_t m_t0 {0U};      // start of the current wait [ns]
+    std::uint32_t m_maxSpin {0U}; // the max. spin duration [ns]
+    std::uint32_t m_avg {0U};     // moving average of the waits [ns]
+    std::uint32_t m_budget {0U};  // spin budget of the current wait [ns]
+    std::uint8_t  m_policy {WAIT_BLOCK_ATTR}; // the waiting policy
+}; // class QSpinWait
+#endif // def QACTIVE_EQUEUE_SPIN
+
 } // namespace QP
 
 // include files -------------------------------------------------------------
 #include "qequeue.hpp"   // POSIX port needs the native event-queue
 #include "qmpool.hpp"    // POSIX port needs the native memory-pool
+#ifdef QACTIVE_EQUEUE_MPSC
+#include "qmpscq.hpp"    // lock-free MPSC event queue for AOs
+#endif
+
+namespace QP {
+
+// per-AO thread attributes and the lock and condition variable (or futex)
+// for blocking on the empty queue
+struct OsObject {
+#if defined(QACTIVE_EQUEUE_MPSC) || defined(QF_SPLIT_CRIT) \
+    || defined(QACTIVE_EQUEUE_FUTEX)
+    pthread_mutex_t m_mutex;
+#endif
+#ifndef QACTIVE_EQUEUE_FUTEX
+    pthread_cond_t  m_cond;
+#else
+    std::atomic<std::uint32_t> m_futex; // futex word, see NOTE7
+#endif
+#ifdef QACTIVE_EQUEUE_SPIN
+    QSpinWait       m_spin;  // spinning on the empty queue, see NOTE8
+#endif
+    QThreadAttr     m_attr;  // applied in QActive::start(), see NOTE9
+#ifdef QF_RT_MODE
+    sem_t *m_started;        // the AO thread has applied m_attr
+#endif
+};
+
+} // namespace QP
+
 #include "qp.hpp"        // QP platform-independent public interface
 
 //============================================================================
@@ -92,37 +302,309 @@ void onClockTick();
     #define QF_SCHED_LOCK_(dummy) (static_cast<void>(0))
     #define QF_SCHED_UNLOCK_()    (static_cast<void>(0))
 
+#if defined(QACTIVE_EQUEUE_FUTEX) && !defined(QACTIVE_EQUEUE_MPSC)
+    // wake up the AO thread *after* leaving the queue crit.sect., see NOTE7
+    #define QACTIVE_EQUEUE_WAKE_(me_) do { \
+        if ((me_)->m_osObject.m_futex.load(std::memory_order_relaxed) \
+            == QP::QF::FUTEX_WAKE_) \
+        { \
+            QP::QF::futexWakeAfter_(&(me_)->m_osObject.m_futex); \
+        } \
+    } while (false)
+#ifndef QF_SPLIT_CRIT
+    #define QACTIVE_EQUEUE_CRIT_ENTRY_(me_) QF_CRIT_ENTRY()
+    #define QACTIVE_EQUEUE_CRIT_EXIT_(me_) do { \
+        QF_CRIT_EXIT(); \
+        QACTIVE_EQUEUE_WAKE_(me_); \
+    } while (false)
+#endif
+#else
+    #define QACTIVE_EQUEUE_WAKE_(me_) (static_cast<void>(0))
+#endif
+
+#ifdef QF_SPLIT_CRIT
+    // QF critical sections for the individual domains, see NOTE4
+    #define QF_MEM_CRIT_ENTRY_(pool_) \
+        pthread_mutex_lock(QP::QF::memMutex_(pool_))
+    #define QF_MEM_CRIT_EXIT_(pool_) \
+        pthread_mutex_unlock(QP::QF::memMutex_(pool_))
+    #define QF_MEM_LOCK_(pool_)  QF_MEM_CRIT_ENTRY_(pool_)
+    #define QF_MEM_UNLOCK_(pool_) QF_MEM_CRIT_EXIT_(pool_)
+
+#ifndef QEVT_REFCTR_ATOMIC // reference counters not atomic?
+    #define QF_EVT_CRIT_ENTRY_(e_) \
+        pthread_mutex_lock(QP::QF::evtMutex_(e_))
+    #define QF_EVT_CRIT_EXIT_(e_) \
+        pthread_mutex_unlock(QP::QF::evtMutex_(e_))
+    #define QF_EVT_LOCK_(e_)     QF_EVT_CRIT_ENTRY_(e_)
+    #define QF_EVT_UNLOCK_(e_)   QF_EVT_CRIT_EXIT_(e_)
+#endif
+
+    #define QF_TIME_CRIT_ENTRY_(tickRate_) \
+        pthread_mutex_lock(QP::QF::timeMutex_(tickRate_))
+    #define QF_TIME_CRIT_EXIT_(tickRate_) \
+        pthread_mutex_unlock(QP::QF::timeMutex_(tickRate_))
+
+    #define QF_PS_CRIT_ENTRY_()  pthread_mutex_lock(&QP::QF::psMutex_)
+    #define QF_PS_CRIT_EXIT_()   pthread_mutex_unlock(&QP::QF::psMutex_)
+
+    #define QACTIVE_EQUEUE_CRIT_ENTRY_(me_) \
+        pthread_mutex_lock(&(me_)->m_osObject.m_mutex)
+    #define QACTIVE_EQUEUE_CRIT_EXIT_(me_) do { \
+        pthread_mutex_unlock(&(me_)->m_osObject.m_mutex); \
+        QACTIVE_EQUEUE_WAKE_(me_); \
+    } while (false)
+    #define QACTIVE_EQUEUE_LOCK_(me_) pthread_mutex_lock( \
+        const_cast<pthread_mutex_t *>(&(me_)->m_osObject.m_mutex))
+    #define QACTIVE_EQUEUE_UNLOCK_(me_) pthread_mutex_unlock( \
+        const_cast<pthread_mutex_t *>(&(me_)->m_osObject.m_mutex))
+#endif // QF_SPLIT_CRIT
+
     // QF event queue customization for POSIX...
-    #define QACTIVE_EQUEUE_WAIT_(me_) do { \
+#if defined(QACTIVE_EQUEUE_FUTEX) && defined(QACTIVE_EQUEUE_MPSC)
+    // NOTE: called *outside* any critical section, see NOTE7
+    #define QACTIVE_EQUEUE_BLOCK_(me_) do { \
+        while ((me_)->m_eQueue.isEmpty()) { \
+            static_cast<void>((me_)->m_osObject.m_futex.exchange( \
+                QP::QF::FUTEX_SLEEP_, std::memory_order_seq_cst)); \
+            if ((me_)->m_eQueue.isEmpty()) { \
+                QP::QF::futexWait_(&(me_)->m_osObject.m_futex); \
+            } \
+        } \
+        (me_)->m_osObject.m_futex.store(QP::QF::FUTEX_IDLE_, \
+            std::memory_order_relaxed); \
+    } while (false)
+
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) do { \
+        if ((me_)->m_osObject.m_futex.exchange(QP::QF::FUTEX_IDLE_, \
+                std::memory_order_seq_cst) == QP::QF::FUTEX_SLEEP_) \
+        { \
+            QP::QF::futexWake_(&(me_)->m_osObject.m_futex); \
+        } \
+    } while (false)
+
+    // block until the head slot is published, see NOTE3 in "qmpscq.hpp"
+    #define QACTIVE_EQUEUE_PUBLISH_WAIT_(me_) do { \
+        (me_)->m_eQueue.m_waiting.store(true, std::memory_order_seq_cst); \
+        while (!(me_)->m_eQueue.isPublished_()) { \
+            static_cast<void>((me_)->m_osObject.m_futex.exchange( \
+                QP::QF::FUTEX_SLEEP_, std::memory_order_seq_cst)); \
+            if (!(me_)->m_eQueue.isPublished_()) { \
+                QP::QF::futexWait_(&(me_)->m_osObject.m_futex); \
+            } \
+        } \
+        (me_)->m_osObject.m_futex.store(QP::QF::FUTEX_IDLE_, \
+            std::memory_order_relaxed); \
+        (me_)->m_eQueue.m_waiting.store(false, std::memory_order_relaxed); \
+    } while (false)
+#elif defined(QACTIVE_EQUEUE_FUTEX)
+    // NOTE: called inside the AO's event-queue crit.sect., see NOTE7
+    #define QACTIVE_EQUEUE_BLOCK_(me_) do { \
+        while ((me_)->m_eQueue.m_frontEvt.e == nullptr) { \
+            (me_)->m_osObject.m_futex.store(QP::QF::FUTEX_SLEEP_, \
+                std::memory_order_relaxed); \
+            QACTIVE_EQUEUE_SLEEP_(me_); \
+        } \
+        (me_)->m_osObject.m_futex.store(QP::QF::FUTEX_IDLE_, \
+            std::memory_order_relaxed); \
+    } while (false)
+#ifdef QF_SPLIT_CRIT
+    #define QACTIVE_EQUEUE_SLEEP_(me_) do { \
+        pthread_mutex_unlock(&(me_)->m_osObject.m_mutex); \
+        QP::QF::futexWait_(&(me_)->m_osObject.m_futex); \
+        pthread_mutex_lock(&(me_)->m_osObject.m_mutex); \
+    } while (false)
+#else
+    #define QACTIVE_EQUEUE_SLEEP_(me_) do { \
+        QF_CRIT_EXIT(); \
+        QP::QF::futexWait_(&(me_)->m_osObject.m_futex); \
+        QF_CRIT_ENTRY(); \
+    } while (false)
+#endif
+
+    // only mark the wakeup (performed in QACTIVE_EQUEUE_WAKE_())
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) do { \
+        if ((me_)->m_osObject.m_futex.load(std::memory_order_relaxed) \
+            == QP::QF::FUTEX_SLEEP_) \
+        { \
+            (me_)->m_osObject.m_futex.store(QP::QF::FUTEX_WAKE_, \
+                std::memory_order_relaxed); \
+        } \
+    } while (false)
+#elif defined(QACTIVE_EQUEUE_MPSC)
+    // NOTE: called *outside* the QF critical section, see NOTE3
+    #define QACTIVE_EQUEUE_BLOCK_(me_) do { \
+        if ((me_)->m_eQueue.isEmpty()) { \
+            pthread_mutex_lock(&(me_)->m_osObject.m_mutex); \
+            while ((me_)->m_eQueue.isEmpty()) { \
+                pthread_cond_wait(&(me_)->m_osObject.m_cond, \
+                                  &(me_)->m_osObject.m_mutex); \
+            } \
+            pthread_mutex_unlock(&(me_)->m_osObject.m_mutex); \
+        } \
+    } while (false)
+
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) do { \
+        pthread_mutex_lock(&(me_)->m_osObject.m_mutex); \
+        pthread_cond_signal(&(me_)->m_osObject.m_cond); \
+        pthread_mutex_unlock(&(me_)->m_osObject.m_mutex); \
+    } while (false)
+
+    // block until the head slot is published, see NOTE3 in "qmpscq.hpp"
+    #define QACTIVE_EQUEUE_PUBLISH_WAIT_(me_) do { \
+        (me_)->m_eQueue.m_waiting.store(true, std::memory_order_seq_cst); \
+        pthread_mutex_lock(&(me_)->m_osObject.m_mutex); \
+        while (!(me_)->m_eQueue.isPublished_()) { \
+            pthread_cond_wait(&(me_)->m_osObject.m_cond, \
+                              &(me_)->m_osObject.m_mutex); \
+        } \
+        pthread_mutex_unlock(&(me_)->m_osObject.m_mutex); \
+        (me_)->m_eQueue.m_waiting.store(false, std::memory_order_relaxed); \
+    } while (false)
+#elif defined(QF_SPLIT_CRIT)
+    // NOTE: called inside the AO's own event-queue crit.sect.
+    #define QACTIVE_EQUEUE_BLOCK_(me_) do { \
+        while ((me_)->m_eQueue.m_frontEvt.e == nullptr) { \
+            pthread_cond_wait(&(me_)->m_osObject.m_cond, \
+                              &(me_)->m_osObject.m_mutex); \
+        } \
+    } while (false)
+
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) \
+        pthread_cond_signal(&(me_)->m_osObject.m_cond)
+#else
+    #define QACTIVE_EQUEUE_BLOCK_(me_) do { \
         while ((me_)->m_eQueue.m_frontEvt.e == nullptr) { \
             Q_ASSERT_INCRIT(400, QF::critSectNest_ == 1); \
             --QF::critSectNest_; \
-            pthread_cond_wait(&(me_)->m_osObject, &QF::critSectMutex_); \
+            pthread_cond_wait(&(me_)->m_osObject.m_cond, \
+                              &QF::critSectMutex_); \
             Q_ASSERT_INCRIT(302, QF::critSectNest_ == 0); \
             ++QF::critSectNest_; \
         } \
     } while (false)
 
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
-        pthread_cond_signal(&(me_)->m_osObject)
+        pthread_cond_signal(&(me_)->m_osObject.m_cond)
+#endif
+
+#ifndef QACTIVE_EQUEUE_MPSC
+    // NOTE: the AO queue is accessed without the crit.sect. while spinning
+    #define QACTIVE_EQUEUE_READY_(me_) \
+        (__atomic_load_n(&(me_)->m_eQueue.m_frontEvt.e, __ATOMIC_ACQUIRE) \
+         != nullptr)
+#ifdef QF_SPLIT_CRIT
+    #define QACTIVE_EQUEUE_SPIN_(me_, spin_) do { \
+        pthread_mutex_unlock(&(me_)->m_osObject.m_mutex); \
+        spin_; \
+        pthread_mutex_lock(&(me_)->m_osObject.m_mutex); \
+    } while (false)
+#else
+    #define QACTIVE_EQUEUE_SPIN_(me_, spin_) do { \
+        QF_CRIT_EXIT(); \
+        spin_; \
+        QF_CRIT_ENTRY(); \
+    } while (false)
+#endif
+#else
+    #define QACTIVE_EQUEUE_READY_(me_) (!(me_)->m_eQueue.isEmpty())
+    #define QACTIVE_EQUEUE_SPIN_(me_, spin_) spin_
+#endif
+
+#ifdef QACTIVE_EQUEUE_SPIN
+    // spin (outside the crit.sect.) before blocking, see NOTE8
+    #define QACTIVE_EQUEUE_WAIT_(me_) do { \
+        if (!QACTIVE_EQUEUE_READY_(me_)) { \
+            QP::QSpinWait &spin_ = (me_)->m_osObject.m_spin; \
+            if (spin_.begin()) { \
+                QACTIVE_EQUEUE_SPIN_((me_), spin_.spin([me_]() noexcept { \
+                    return QACTIVE_EQUEUE_READY_(me_); })); \
+            } \
+            QACTIVE_EQUEUE_BLOCK_(me_); \
+            spin_.end(); \
+        } \
+    } while (false)
+#else
+    #define QACTIVE_EQUEUE_WAIT_(me_) QACTIVE_EQUEUE_BLOCK_(me_)
+#endif
 
     // QMPool operations
     #define QF_EPOOL_TYPE_ QMPool
+#ifndef QF_RT_MODE
     #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
         (p_).init((poolSto_), (poolSize_), (evtSize_))
+#else // prefault the pool storage, see NOTE10
+    #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) do { \
+        QP::QF::prefault_((poolSto_), (poolSize_)); \
+        (p_).init((poolSto_), (poolSize_), (evtSize_)); \
+    } while (false)
+#endif
     #define QF_EPOOL_EVENT_SIZE_(p_) ((p_).getBlockSize())
+#ifndef QF_EPOOL_MAGAZINE
     #define QF_EPOOL_GET_(p_, e_, m_, qsId_) \
         ((e_) = static_cast<QEvt *>((p_).get((m_), (qsId_))))
     #define QF_EPOOL_PUT_(p_, e_, qsId_) ((p_).put((e_), (qsId_)))
+    #define QF_EPOOL_GET_BATCH_(p_, blocks_, n_, m_, qsId_, nGot_) \
+        ((nGot_) = (p_).getBatch((blocks_), (n_), (m_), (qsId_)))
+    #define QF_EPOOL_PUT_BATCH_(p_, blocks_, n_, qsId_) \
+        ((p_).putBatch((blocks_), (n_), (qsId_)))
     #define QF_EPOOL_USE_(ePool_)   ((ePool_)->getUse())
     #define QF_EPOOL_FREE_(ePool_)  ((ePool_)->getFree())
+#else // per-thread magazines of free blocks, see NOTE6
+    #define QF_EPOOL_GET_(p_, e_, m_, qsId_) \
+        ((e_) = static_cast<QEvt *>(QP::QF::magGet_((p_), (m_), (qsId_))))
+    #define QF_EPOOL_PUT_(p_, e_, qsId_) \
+        (QP::QF::magPut_((p_), (e_), (qsId_)))
+    // batches come straight from the shared pool (all-or-nothing)
+    #define QF_EPOOL_GET_BATCH_(p_, blocks_, n_, m_, qsId_, nGot_) \
+        ((nGot_) = (p_).getBatch((blocks_), (n_), (m_), (qsId_)))
+    #define QF_EPOOL_USE_(ePool_)   (QP::QF::magUse_(*(ePool_)))
+    #define QF_EPOOL_FREE_(ePool_)  (QP::QF::magFree_(*(ePool_)))
+#endif
+    // NOTE: with QF_EPOOL_MAGAZINE the blocks cached in the magazines
+    // count as used in the minimum (see NOTE6)
     #define QF_EPOOL_MIN_(ePool_)   ((ePool_)->getMin())
 
 namespace QP {
 namespace QF {
     extern pthread_mutex_t critSectMutex_;
     extern int_t critSectNest_;
+
+#ifdef QF_SPLIT_CRIT
+    // locks for the individual domains (see qf_port.cpp)
+    pthread_mutex_t *memMutex_(void const * const pool) noexcept;
+    pthread_mutex_t *evtMutex_(QEvt const * const e) noexcept;
+    pthread_mutex_t *timeMutex_(std::uint_fast8_t const tickRate) noexcept;
+    extern pthread_mutex_t psMutex_;
+#endif
+
+#ifdef QACTIVE_EQUEUE_FUTEX
+    // states of the futex word of an AO (see qf_port.cpp and NOTE7)
+    constexpr std::uint32_t FUTEX_IDLE_  {0U}; // AO thread not blocked
+    constexpr std::uint32_t FUTEX_SLEEP_ {1U}; // AO thread (about to) block
+    constexpr std::uint32_t FUTEX_WAKE_  {2U}; // wakeup pending
+
+    void futexWait_(std::atomic<std::uint32_t> * const word) noexcept;
+    void futexWake_(std::atomic<std::uint32_t> * const word) noexcept;
+    void futexWakeAfter_(std::atomic<std::uint32_t> * const word) noexcept;
+#endif
+
+#ifdef QF_EPOOL_MAGAZINE
+    // per-thread magazines of free blocks (see qf_magazine.cpp)
+    void *magGet_(
+        QMPool &pool,
+        std::uint_fast16_t const margin,
+        std::uint_fast8_t const qsId) noexcept;
+    void magPut_(
+        QMPool &pool,
+        void * const block,
+        std::uint_fast8_t const qsId) noexcept;
+    std::uint16_t magCached_(QMPool const &pool) noexcept;
+    std::uint16_t magUse_(QMPool const &pool) noexcept;
+    std::uint16_t magFree_(QMPool const &pool) noexcept;
+#endif
 } // namespace QF
+
 } // namespace QP
 
 #endif // QP_IMPL
@@ -163,6 +645,172 @@ namespace QF {
 // thread publishes events to higher-priority threads. This can lead to
 // (occasionally) unexpected event sequences.
 //
+// NOTE3:
+// Defining QACTIVE_EQUEUE_MPSC in "qp_config.hpp" replaces the native QEQueue
+// of every AO with the lock-free QMPSCQueue (see "qmpscq.hpp"). Posting to
+// and getting from such a queue does not enter the global QF critical
+// section (except for incrementing the reference counter of mutable events
+// and for QS tracing), so posting to different AOs does not contend on
+// QF::critSectMutex_. The AO thread blocks on its own mutex/condition
+// variable pair in m_osObject, which is signaled only when the queue goes
+// from empty to not-empty.
+//
+// The MPSC queue preserves the semantics of postx_() with margin, and the
+// free-entry statistics reported by QActive::getQueueFree()/getQueueMin().
+// However, QActive::postLIFO() may be called only from the AO's own thread
+// (e.g., QActive::recall() called from the AO's state machine), because
+// only the consumer is allowed to insert events at the front of the queue.
+// The AO thread never spins indefinitely on a slot reserved by a preempted
+// producer (see NOTE3 in "qmpscq.hpp").
+//
+// NOTE4:
+// Defining QF_SPLIT_CRIT in "qp_config.hpp" replaces the single QF
+// critical section with separate locks for the individual domains of QF:
+// - one lock per event pool, which also protects the reference counters
+//   of the events allocated from that pool;
+// - one lock per clock tick rate (time events armed at that rate);
+// - one lock for the publish-subscribe lists;
+// - one lock per AO event queue (m_osObject.m_mutex).
+// This way, for example, a clock tick processing the time events does not
+// block an unrelated publish, and posting to different AOs proceeds in
+// parallel. QF::critSectMutex_ still protects the AO registry, the table
+// of event pools and the native QEQueue (e.g., deferred event queues).
+//
+// The locks are acquired in a fixed order (QF critical section or AO queue
+// or publish-subscribe first, event pool last), so they cannot deadlock.
+// The immutable (static) events don't have a pool, so their reference
+// counter operations map to the lock of the pools outside QF. Those
+// critical sections only check QEvt::poolNum_ and don't modify the event,
+// so sharing the lock costs a brief lock/unlock, but no real contention.
+//
+// QF_SPLIT_CRIT is not supported (#error) in the Spy build configuration,
+// because the QS trace buffer is protected by the single QF critical
+// section. Use separate qp_config.hpp settings for the Spy build.
+//
+// NOTE5:
+// Defining QF_TIMEEVT_TICKLESS in "qp_config.hpp" (Linux only) adds the
+// QTimeEvt::armAt()/QTimeEvt::armIn() operations, which arm a time event
+// for an absolute CLOCK_MONOTONIC deadline with nanosecond resolution
+// (optionally periodic). Such "deadline" time events are kept in a min-heap
+// (up to QF_TIMEEVT_HEAP_SIZE) and a single timerfd is always programmed to
+// the earliest of the deadlines and the next system clock tick. The main
+// (ticker) thread in QF::run() blocks on that timerfd instead of sleeping
+// for the fixed clock tick. With QF::setTickRate(0U, ...), the port is
+// completely tickless: the thread wakes up only when a deadline expires
+// and QF::onClockTick() is never called. Deadline time events are disarmed
+// with the regular QTimeEvt::disarm() and can be converted back with
+// QTimeEvt::rearm(). The deadline heap and the timerfd (class QTickless)
+// are implemented in ports/posix-common/qf_tickless.cpp, shared by all
+// POSIX ports.
+//
+// NOTE6:
+// Defining QF_EPOOL_MAGAZINE in "qp_config.hpp" (as an even number of
+// blocks, e.g., 16U) gives every thread a private "magazine" of free blocks
+// for each event pool (see qf_magazine.cpp). Allocating and recycling
+// events then enters the pool critical section only once per
+// QF_EPOOL_MAGAZINE/2 operations, when the magazine needs to be refilled
+// or flushed. The blocks cached in the magazines are still reported as free
+// by QF::getPoolUse()/QF::getPoolFree(). The magazines are updated without
+// the pool lock, so these two statistics are approximate while threads
+// refill or flush their magazines, but they are clamped to the range of the
+// pool (0..total) and never wrap around. QF::getPoolMin() is the low-water
+// mark of the shared part of the pool only, which means that the blocks
+// cached in the magazines count as used. It is therefore a conservative
+// lower bound of the free blocks, lower than without the magazines by up to
+// QF_EPOOL_MAGAZINE blocks for every thread that uses the pool.
+//
+// Allocations without margin (Q_NEW()) fail only when the shared pool is
+// exhausted, so every event pool needs QF_EPOOL_MAGAZINE spare blocks for
+// each thread that allocates or recycles events from that pool.
+// Allocations with margin (Q_NEW_X()) take into account also the blocks
+// cached in the magazines of all threads. Batch allocations (Q_NEW_BATCH())
+// bypass the magazines and take all blocks from the shared pool at once,
+// while the events are recycled through the magazines. QF_EPOOL_MAGAZINE
+// is ignored in the Spy build configuration, because every event
+// allocation and recycling must be traced by the pool.
+//
+// NOTE7:
+// Defining QACTIVE_EQUEUE_FUTEX in "qp_config.hpp" (Linux only) replaces
+// the condition variable of every AO with a futex word m_osObject.m_futex
+// (FUTEX_IDLE_, FUTEX_SLEEP_, or FUTEX_WAKE_). The AO thread sets
+// FUTEX_SLEEP_ inside the queue crit.sect. before blocking on the futex.
+// A post that makes the empty queue non-empty only changes FUTEX_SLEEP_ to
+// FUTEX_WAKE_ inside the crit.sect., and the posting thread issues the
+// futex wakeup only *after* leaving the crit.sect. (QACTIVE_EQUEUE_WAKE_()).
+// The woken AO thread then finds the lock free, instead of blocking on it
+// again right away, as happens with pthread_cond_signal() called under the
+// lock. Posting to a queue that is not empty, or to an AO thread that is
+// not blocked, makes no system call at all.
+//
+// With QACTIVE_EQUEUE_MPSC, the AO thread and the producers hand over the
+// futex word with atomic exchanges (FUTEX_IDLE_ and FUTEX_SLEEP_ only), so
+// neither of them needs the mutex of m_osObject to block or to wake up.
+//
+// NOTE8:
+// Defining QACTIVE_EQUEUE_SPIN in "qp_config.hpp" lets every AO select how
+// its thread waits on the empty event queue with QActive::setAttr() (before
+// starting the AO):
+// - WAIT_BLOCK_ATTR blocks right away (the default);
+// - WAIT_SPIN_ATTR spins (outside the crit.sect.) and then blocks. attr2
+//   points to the maximum spin time [us] as std::uint32_t (nullptr: 50us),
+//   which is clamped to 4294967us;
+// - WAIT_POLL_ATTR spins until an event arrives and never blocks.
+// With WAIT_SPIN_ATTR the actual spin time adapts to the moving average of
+// the recent waits (twice the average, up to the maximum), and drops to
+// zero when the events arrive less frequently than the maximum spin time.
+// Only the AO thread polls its queue while spinning and it executes the
+// "pause" ("yield") instruction in every iteration. Spinning requires
+// another CPU to post the events, so WAIT_SPIN_ATTR and WAIT_POLL_ATTR
+// revert to WAIT_BLOCK_ATTR on a single-CPU system. The busy-polling is
+// unbounded, so a polling thread with the SCHED_FIFO or SCHED_RR policy
+// would take its CPU away from all lower-priority threads (including the
+// kernel threads bound to that CPU) for good. QActive::start() therefore
+// rejects WAIT_POLL_ATTR unless SCHED_POLICY_ATTR selects SCHED_OTHER (or
+// SCHED_DEADLINE, whose runtime budget throttles the polling). A polling
+// AO thread should still be given a dedicated CPU with CPU_SET_ATTR.
+//
+// NOTE9:
+// QActive::setAttr() (before starting the AO) sets also the attributes of
+// the AO thread, which QActive::start() applies when creating the thread:
+// - THREAD_NAME_ATTR names the thread (as shown by "top -H" or debuggers).
+//   The name is copied and truncated to 15 characters (Linux only);
+// - CPU_SET_ATTR restricts the thread to the given CPUs (cpu_set_t), e.g.,
+//   to place communicating AOs on cores that share a cache, or to isolate
+//   a latency-critical AO on a dedicated core. The CPU set is copied.
+//   Without it, the AO thread inherits the affinity of the thread that
+//   calls QActive::start() (Linux only);
+// - SCHED_POLICY_ATTR selects the scheduling policy (SCHED_FIFO, which is
+//   the default, SCHED_RR, or SCHED_OTHER). The QF priority of the AO is
+//   mapped to the thread priority only for SCHED_FIFO and SCHED_RR.
+// QF::setTickAttr() sets the same attributes of the ticker thread, which
+// QF::run() applies to its calling thread before starting the clock tick.
+//
+// NOTE10:
+// Defining QF_RT_MODE in "qp_config.hpp" (Linux only) hardens the port for
+// real-time applications:
+// - QF::init() locks all current and future memory of the process in RAM
+//   (mlockall()) and stops glibc malloc from returning memory to the OS;
+// - QF::poolInit() touches every page of the event pool storage and
+//   QActive::start() touches every page of the AO's queue storage and of
+//   the AO thread's stack, so the first burst of events after startup takes
+//   no page faults, even when the memory cannot be locked;
+// - QActive::start() returns only after the AO thread has applied all its
+//   attributes. A thread that could not get its scheduling policy runs
+//   with SCHED_OTHER, which is reported instead of being silent. The policy
+//   actually obtained is in getOsObject().m_attr.m_policy;
+// - SCHED_DEADLINE_ATTR (QActive::setAttr() or QF::setTickAttr()) selects
+//   the SCHED_DEADLINE policy with the given runtime, deadline and period.
+//   Such a thread runs before all SCHED_FIFO/SCHED_RR threads, regardless
+//   of the QF priority. The kernel admits the reservation only with the
+//   superuser privileges, when the CPU bandwidth is available and when the
+//   thread is not restricted to a subset of the CPUs (CPU_SET_ATTR).
+// QF::getRtStatus() reports the guarantees obtained (RtStatus bitmask).
+// RT_TICK_SCHED is known only after QF::run() has started the clock tick.
+//
+// CAUTION: With the memory locked, every new mapping (e.g., the default
+// 8MB stack of a std::thread) counts against RLIMIT_MEMLOCK and fails when
+// the limit is exceeded, so an application without the CAP_IPC_LOCK
+// capability needs an adequate limit (e.g., "ulimit -l").
+//
 
 #endif // QP_PORT_HPP_
-
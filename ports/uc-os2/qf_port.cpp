@@ -37,6 +37,10 @@
     #include "qs_dummy.hpp" // disable the QS software tracing
 #endif // Q_SPY
 
+#if (QF_MAX_ACTIVE > 64U)
+    #error uC/OS-II port supports QF_MAX_ACTIVE of up to 64U
+#endif
+
 //============================================================================
 namespace { // anonymous namespace with local definitions
 
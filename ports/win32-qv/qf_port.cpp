@@ -37,6 +37,10 @@
     #include "qs_dummy.hpp" // disable the QS software tracing
 #endif // Q_SPY
 
+#if (QF_MAX_ACTIVE > 64U)
+    #error Win32-QV port supports QF_MAX_ACTIVE of up to 64U
+#endif
+
 #include <climits>          // limits of dynamic range for integers
 
 namespace { // unnamed local namespace
@@ -52,6 +52,19 @@ static constexpr std::array<QP::QEvt, 4> l_resEvt_ {
     QP::QEvt(static_cast<QP::QSignal>(QP::QHsm::Q_INIT_SIG))
 };
 
+#ifdef QHSM_SIG_TABLES
+// registry of the signal tables, hashed by the state handler (NOTE2)
+static std::array<QP::QSigTable const *, QHSM_SIG_TABLES> l_sigTbl_;
+static std::size_t l_sigTblNum_; // # registered signal tables
+
+static std::size_t sigTableIdx_(QP::QStateHandler const s) noexcept {
+    QP::QAsmAttr key;
+    key.fun = s;
+    return static_cast<std::size_t>((key.uint >> 2U) ^ (key.uint >> 9U))
+           % QHSM_SIG_TABLES;
+}
+#endif // def QHSM_SIG_TABLES
+
 //! @endcond
 
 } // unnamed namespace
@@ -213,6 +226,9 @@ void QHsm::init(
     QS_TOP_INIT_(QS_QEP_INIT_TRAN, path[0U]); // output QS record
 
     m_state.fun = path[0U]; // change the current active state
+#ifdef QASM_ACTIVE_CONFIG
+    updateConfig_(); // refresh the cached active configuration
+#endif
 #ifndef Q_UNSAFE
     // establish stable state configuration
     m_temp.uint = dis_update<std::uintptr_t>(m_state.uint);
@@ -260,6 +276,38 @@ void QHsm::dispatch(
         --ip; // build the entry path[] from the end
         path[ip] = s; // store the path to potential tran. source
 
+#ifdef QHSM_SIG_TABLES
+        // probe the registry only for SMs with signal tables (NOTE2)
+        QSigTable const * const tbl = m_sigTbls
+                                      ? findSigTable_(s)
+                                      : nullptr;
+        if (tbl != nullptr) { // signal table registered for 's'?
+            QStateHandler const act = (e->sig < tbl->len)
+                                      ? tbl->act[e->sig]
+                                      : nullptr;
+            r = (act != nullptr)
+                ? (*act)(this, e) // jump directly to the action
+                : Q_RET_SUPER;    // 's' does not handle the signal
+
+            if (r == Q_RET_UNHANDLED) { // unhandled due to a guard?
+                QS_TRAN_ACT_(QS_QEP_UNHANDLED, s); // output QS record
+                r = Q_RET_SUPER;
+            }
+            if (r == Q_RET_SUPER) {
+                m_temp.fun = tbl->super; // skip to the superstate (no call)
+            }
+        }
+        else {
+            r = (*s)(this, e); // try to handle event e in state s
+
+            if (r == Q_RET_UNHANDLED) { // unhandled due to a guard?
+                QS_TRAN_ACT_(QS_QEP_UNHANDLED, s); // output QS record
+
+                // find the superstate of 's'
+                r = (*s)(this, &l_resEvt_[Q_EMPTY_SIG]);
+            }
+        }
+#else
         r = (*s)(this, e); // try to handle event e in state s
 
         if (r == Q_RET_UNHANDLED) { // unhandled due to a guard?
@@ -268,6 +316,7 @@ void QHsm::dispatch(
             // find the superstate of 's'
             r = (*s)(this, &l_resEvt_[Q_EMPTY_SIG]);
         }
+#endif // def QHSM_SIG_TABLES
     } while (r == Q_RET_SUPER); // loop as long as superstate returned
 
     // me->state should not change, so it must match the saved DIS
@@ -302,16 +351,32 @@ void QHsm::dispatch(
         path[2U] = s; // save tran. source in path[2]
 
         // take the tran...
+#ifdef QHSM_TRAN_CACHE
+        QTranCache * const cache = tranCache();
+        if (cache != nullptr) { // transition-path cache provided?
+            ip = tran_cached_(path, *cache, qsId); // see NOTE1
+        }
+        else {
+            ip = tran_simple_(path, qsId); // try simple tran. first
+            if (ip > 1U) { // not a simple tran.?
+                ip = tran_complex_(path, qsId);
+            }
+        }
+#else
         ip = tran_simple_(path, qsId); // try simple tran. first
         if (ip > 1U) { // not a simple tran.?
             ip = tran_complex_(path, qsId);
         }
+#endif // def QHSM_TRAN_CACHE
 
         // enter the target (possibly recursively) by initial trans.
         enter_target_(path, ip, qsId);
         QS_TRAN_END_(QS_QEP_TRAN, s, path[0U]); // output QS record
 
         m_state.fun = path[0U]; // change the current active state
+#ifdef QASM_ACTIVE_CONFIG
+        updateConfig_(); // refresh the cached active configuration
+#endif
     }
     else {
         Q_ERROR_LOCAL(370); // last state handler returned impossible value
@@ -479,6 +544,103 @@ std::size_t QHsm::tran_complex_(
     return ip;
 }
 
+#ifdef QHSM_TRAN_CACHE
+//............................................................................
+//! @private @memberof QHsm
+std::size_t QHsm::tran_cached_(
+    std::array<QStateHandler, MAX_NEST_DEPTH_> &path,
+    QTranCache &cache,
+    std::uint_fast8_t const qsId)
+{
+#ifndef Q_SPY
+    Q_UNUSED_PAR(qsId);
+#endif
+
+    QStateHandler const t = path[0U]; // target
+    QStateHandler const s = path[2U]; // source
+    QTranCache::Entry * const entry = cache.slot_(s, t);
+
+    if ((entry->src != s) || (entry->trg != t)) { // cache miss?
+        entry->src = nullptr; // invalidate the entry while being filled
+
+        std::uint8_t nExit = 0U;
+        std::uint8_t nEntry = 0U;
+        if (s == t) { // tran. to self? (external tran. semantics)
+            entry->exit[0U] = s;
+            entry->entry[0U] = t;
+            nExit = 1U;
+            nEntry = 1U;
+        }
+        else {
+            // find the target with all its superstates up to the top
+            std::size_t nt = 0U; // path index & fixed loop bound
+            m_temp.fun = t;
+            QState r;
+            do {
+                // the entry path index must stay in range of the path
+                Q_INVARIANT_LOCAL(560, nt < MAX_NEST_DEPTH_);
+
+                entry->entry[nt] = m_temp.fun;
+                ++nt;
+
+                // find superstate of 'm_temp.fun'
+                r = (*m_temp.fun)(this, &l_resEvt_[Q_EMPTY_SIG]);
+            } while (r == Q_RET_SUPER);
+
+            // find the LCA among the source and its superstates
+            QStateHandler x = s;
+            bool isLca = false;
+            do {
+                for (std::size_t it = 0U; it < nt; ++it) {
+                    if (entry->entry[it] == x) { // is 'x' the LCA?
+                        nEntry = static_cast<std::uint8_t>(it); // not 'x'
+                        isLca = true;
+                        break;
+                    }
+                }
+                if (!isLca) { // 'x' must be exited
+                    // the exit path index must stay in range of the path
+                    Q_INVARIANT_LOCAL(570, nExit < MAX_NEST_DEPTH_);
+
+                    entry->exit[nExit] = x;
+                    ++nExit;
+
+                    // find superstate of 'x'
+                    r = (*x)(this, &l_resEvt_[Q_EMPTY_SIG]);
+
+                    // the top state is common, so 'x' must have a superstate
+                    Q_ASSERT_LOCAL(580, r == Q_RET_SUPER);
+                    x = m_temp.fun;
+                }
+            } while (!isLca);
+        }
+
+        entry->nExit  = nExit;
+        entry->nEntry = nEntry;
+        entry->trg = t;
+        entry->src = s; // the entry is now valid
+    }
+
+    // replay the cached tran. path...
+    QS_CRIT_STAT
+    for (std::size_t iq = 0U; iq < entry->nExit; ++iq) {
+        // exit from 'exit[iq]'
+        if ((*entry->exit[iq])(this, &l_resEvt_[Q_EXIT_SIG])
+            == Q_RET_HANDLED)
+        {
+            QS_STATE_ACT_(QS_QEP_STATE_EXIT, entry->exit[iq]);
+        }
+    }
+    std::size_t const ip = entry->nEntry;
+    for (std::size_t i = 0U; i < ip; ++i) {
+        path[i] = entry->entry[i]; // entry path for QHsm::enter_target_()
+    }
+
+    // # levels in path[] for QHsm::enter_target_()
+    return ip;
+}
+#endif // def QHSM_TRAN_CACHE
+
 //............................................................................
 //! @private @memberof QHsm
 void QHsm::enter_target_(
@@ -545,6 +707,33 @@ void QHsm::enter_target_(
     }
 }
 
+#ifdef QASM_ACTIVE_CONFIG
+//............................................................................
+//! @private @memberof QHsm
+void QHsm::updateConfig_() noexcept {
+    QActiveConfig * const cfg = activeConfig();
+    if (cfg == nullptr) { // this SM does not cache its configuration?
+        return;
+    }
+
+    // record the current state and all its superstates up to the top
+    std::uint8_t n = 0U; // configuration index & fixed loop bound
+    m_temp.fun = m_state.fun;
+    QState r;
+    do {
+        // the state nesting must fit in the configuration array
+        Q_INVARIANT_LOCAL(690, n < cfg->state.size());
+
+        cfg->state[n].fun = m_temp.fun;
+        ++n;
+
+        // find superstate of 'm_temp.fun'
+        r = (*m_temp.fun)(this, &l_resEvt_[Q_EMPTY_SIG]);
+    } while (r == Q_RET_SUPER);
+    cfg->len = n;
+}
+#endif // def QASM_ACTIVE_CONFIG
+
 //............................................................................
 bool QHsm::isIn(QStateHandler const stateHndl) noexcept {
     // this state machine must be in a stable state configuration
@@ -554,6 +743,23 @@ bool QHsm::isIn(QStateHandler const stateHndl) noexcept {
 
     bool inState = false; // assume that this HSM is NOT in 'stateHndl'
 
+#ifdef QASM_ACTIVE_CONFIG
+    // is the cached active configuration for the current state? (NOTE3)
+    QActiveConfig const * const cfg = activeConfig();
+    if ((cfg != nullptr) && (cfg->len != 0U)
+        && (cfg->state[0U].fun == m_state.fun))
+    {
+        // look up the configuration without calling any state handlers
+        for (std::size_t i = 0U; i < cfg->len; ++i) {
+            if (cfg->state[i].fun == stateHndl) { // do the states match?
+                inState = true;
+                break;
+            }
+        }
+        return inState; // NOTE: stable state configuration not disturbed
+    }
+#endif // def QASM_ACTIVE_CONFIG
+
     // scan the state hierarchy bottom-up
     QStateHandler s = m_state.fun;
     QState r;
@@ -581,6 +787,25 @@ QStateHandler QHsm::childState(QStateHandler const parentHndl) noexcept {
     // so it does NOT assume to be called in a stable state configuration
     // and also does NOT establish stable state configuration upon exit.
 
+#ifdef QASM_ACTIVE_CONFIG
+    // is the cached active configuration for the current state? (NOTE3)
+    QActiveConfig const * const cfg = activeConfig();
+    if ((cfg != nullptr) && (cfg->len != 0U)
+        && (cfg->state[0U].fun == m_state.fun))
+    {
+        // look up the configuration without calling any state handlers
+        std::size_t i = 0U;
+        while ((i < cfg->len) && (cfg->state[i].fun != parentHndl)) {
+            ++i;
+        }
+        // the parent must be in the active configuration
+        Q_ENSURE_LOCAL(890, i < cfg->len);
+
+        // the child of the parent (or the current state itself)
+        return cfg->state[(i > 0U) ? (i - 1U) : 0U].fun;
+    }
+#endif // def QASM_ACTIVE_CONFIG
+
 #ifndef Q_UNSAFE
     bool isFound = false; // assume the child state NOT found
 #endif
@@ -606,6 +831,61 @@ QStateHandler QHsm::childState(QStateHandler const parentHndl) noexcept {
     return child;
 }
 
+#ifdef QHSM_SIG_TABLES
+//............................................................................
+void QHsm::addSigTable(QSigTable const * const tbl) noexcept {
+    // the table must be valid
+    Q_REQUIRE_LOCAL(950, (tbl != nullptr)
+        && (tbl->state != nullptr) && (tbl->super != nullptr)
+        && ((tbl->act != nullptr) || (tbl->len == 0U)));
+
+#ifndef Q_UNSAFE
+    // find the superstate of the state in this state machine,
+    // preserving 'm_temp' (the initial tran. or the stable configuration)
+    QAsmAttr const temp = m_temp;
+    QState const r = (*tbl->state)(this, &l_resEvt_[Q_EMPTY_SIG]);
+    QStateHandler const super = m_temp.fun;
+    m_temp = temp;
+
+    // the superstate in the table must match the state handler,
+    // because dispatch() skips to the superstate from the table
+    Q_REQUIRE_LOCAL(960, (r == Q_RET_SUPER) && (super == tbl->super));
+#endif
+
+    // find the table or a free slot (linear probing)
+    std::size_t i = sigTableIdx_(tbl->state);
+    while ((l_sigTbl_[i] != nullptr) && (l_sigTbl_[i] != tbl)) {
+        // a different table must not be registered for the same state
+        Q_REQUIRE_LOCAL(970, l_sigTbl_[i]->state != tbl->state);
+
+        i = (i + 1U) % QHSM_SIG_TABLES;
+    }
+    if (l_sigTbl_[i] == nullptr) { // not registered by another instance?
+        // the registry must keep one slot free (see QHSM_SIG_TABLES)
+        Q_REQUIRE_LOCAL(980, l_sigTblNum_ < (QHSM_SIG_TABLES - 1U));
+
+        l_sigTbl_[i] = tbl;
+        ++l_sigTblNum_;
+    }
+
+    m_sigTbls = true; // dispatch() will look up the tables for this SM
+}
+
+//............................................................................
+//! @private @memberof QHsm
+QSigTable const *QHsm::findSigTable_(QStateHandler const s) noexcept {
+    // NOTE: the registry is not modified after the startup (NOTE2),
+    // so no critical section is needed
+    std::size_t i = sigTableIdx_(s);
+    QSigTable const *tbl = l_sigTbl_[i];
+    while ((tbl != nullptr) && (tbl->state != s)) {
+        i = (i + 1U) % QHSM_SIG_TABLES;
+        tbl = l_sigTbl_[i]; // terminates, because one slot is always free
+    }
+    return tbl;
+}
+#endif // def QHSM_SIG_TABLES
+
 //............................................................................
 QStateHandler QHsm::getStateHandler() const noexcept {
     // NOTE: this function does NOT apply critical section, so it can
@@ -613,4 +893,129 @@ QStateHandler QHsm::getStateHandler() const noexcept {
     return m_state.fun; // public "getter" to the state handler (function)
 }
 
+#ifdef QHSM_TRAN_CACHE
+//............................................................................
+QTranCache::QTranCache(
+    Entry * const sto,
+    std::uint_fast16_t const len) noexcept
+  : m_sto(sto),
+    m_len(len)
+{
+    // the cache storage must be provided
+    Q_REQUIRE_LOCAL(900, (sto != nullptr) && (len > 0U));
+
+    for (std::uint_fast16_t i = 0U; i < len; ++i) {
+        sto[i].src = nullptr; // all entries unused
+    }
+}
+
+//............................................................................
+QTranCache::Entry *QTranCache::slot_(
+    QStateHandler const s,
+    QStateHandler const t) const noexcept
+{
+    QAsmAttr src;
+    QAsmAttr trg;
+    src.fun = s;
+    trg.fun = t;
+    std::uintptr_t const key = src.uint ^ (trg.uint >> 3U) ^ (src.uint >> 9U);
+    return &m_sto[key % m_len]; // direct-mapped entry
+}
+#endif // def QHSM_TRAN_CACHE
+
 } // namespace QP
+
+//============================================================================
+// NOTE1:
+// With QHSM_TRAN_CACHE defined in "qp_config.hpp", a QHsm subclass can opt
+// into caching its transition paths by overriding tranCache() to return
+// a QTranCache owned by the instance, for example:
+//
+//     class Blinky : public QP::QActive {
+//         ...
+//         QP::QTranCache::Entry m_cacheSto[16];
+//         QP::QTranCache m_cache {&m_cacheSto[0], Q_DIM(m_cacheSto)};
+//
+//         QP::QTranCache *tranCache() noexcept override {
+//             return &m_cache;
+//         }
+//     };
+//
+// The first time a transition from a given source to a given target is
+// taken, the states to exit (from the source up to the LCA) and the states
+// to enter (from the LCA down to the target) are discovered with the
+// Q_EMPTY_SIG superstate queries and stored in the cache. Afterwards, the
+// transition only executes the exit and entry actions from the cache.
+// This is valid because the superstate relations must be free of side
+// effects. The cache is direct-mapped, so a conflicting transition simply
+// replaces the entry, and it uses only the storage provided in the ctor.
+//
+// The cache is filled and read during the RTC step WITHOUT any locking.
+// A per-instance cache is therefore safe wherever the state machine itself
+// is safe. A cache must NOT be shared among state machines that can run
+// concurrently (e.g., active objects in the POSIX ports, each running in
+// its own thread), because a cache miss in one of them rewrites an entry
+// that another one might be replaying. Sharing one cache is safe only
+// among state machines dispatched from the same thread (e.g., the
+// orthogonal components of one active object or the members of one
+// QHsmArray).
+//
+// NOTE2:
+// With QHSM_SIG_TABLES defined in "qp_config.hpp", a QHsm state can be
+// given a dense signal-to-action table (QSigTable). The actions are
+// ordinary state-handler functions declared with Q_STATE_DECL()/
+// Q_STATE_DEF(), each handling one signal in the state (e.g., return
+// tran(&target)), for example:
+//
+//     static QP::QStateHandler const l_onAct[MAX_SIG] = {
+//         nullptr, nullptr, nullptr, nullptr, // reserved signals
+//         Q_STATE_CAST(&Blinky::on_TIMEOUT),  // TIMEOUT_SIG
+//         ...
+//     };
+//     static QP::QSigTable const l_onTbl = {
+//         Q_STATE_CAST(&Blinky::on), Q_STATE_CAST(&Blinky::active),
+//         &l_onAct[0], Q_DIM(l_onAct)
+//     };
+//     ...
+//     Blinky::Blinky() : QActive(Q_STATE_CAST(&Blinky::initial)) {
+//         addSigTable(&l_onTbl);
+//     }
+//
+// Every state machine instance that should use the tables registers them
+// with addSigTable() (in the constructor or in the top-most initial tran.,
+// before QF::run()). The table is added to the global registry only once,
+// and the registry is not modified afterwards. addSigTable() also asserts
+// that the 'super' in the table matches the superstate reported by the
+// state handler, because dispatch() relies on it.
+//
+// QHsm::dispatch() then calls the action directly instead of the state
+// handler. If the state does not handle the signal, dispatch() moves on
+// to the superstate from the table, without calling any handlers. The state
+// handler itself is still used for the entry/exit actions, the initial
+// transition, and the superstate, while the user signals are handled only
+// by the table. States without a registered table are handled as usual.
+// State machines that registered no tables do not look up the registry at
+// all, so they dispatch at the same cost as without QHSM_SIG_TABLES.
+//
+// NOTE3:
+// With QASM_ACTIVE_CONFIG defined in "qp_config.hpp", a state machine
+// (QHsm or QMsm) can opt into caching its active state configuration by
+// overriding activeConfig() to return a QActiveConfig owned by the
+// instance, for example:
+//
+//     class Blinky : public QP::QActive {
+//         ...
+//         mutable QP::QActiveConfig m_config;
+//
+//         QP::QActiveConfig *activeConfig() const noexcept override {
+//             return &m_config;
+//         }
+//     };
+//
+// The configuration is recorded at the end of every RTC step that changed
+// the state, so isIn() and childState() can then look it up without calling
+// the state handlers. The storage is declared 'mutable', because the cache
+// is read also from the const QMsm::childStateObj(). State machines that
+// do not override activeConfig() keep the size they have without
+// QASM_ACTIVE_CONFIG and pay only the virtual call after the transitions.
+//
@@ -170,6 +170,10 @@ void QMsm::init(
 
     QS_TOP_INIT_(QS_QEP_INIT_TRAN, m_state.obj->stateHandler);
 
+#ifdef QASM_ACTIVE_CONFIG
+    updateConfig_(); // refresh the cached active configuration
+#endif
+
 #ifndef Q_UNSAFE
     // establish stable state configuration at the end of RTC step
     m_temp.uint = dis_update<std::uintptr_t>(m_state.uint);
@@ -263,6 +267,9 @@ void QMsm::dispatch(
         }
 
         QS_TRAN_END_(QS_QEP_TRAN, ts->stateHandler, s->stateHandler);
+#ifdef QASM_ACTIVE_CONFIG
+        updateConfig_(); // refresh the cached active configuration
+#endif
     }
     else {
         Q_ERROR_LOCAL(360); // last action handler returned impossible value
@@ -389,9 +396,46 @@ QMState const * QMsm::topQMState() noexcept {
     // return the top state (object pointer)
     return &l_msm_top_s;
 }
+#ifdef QASM_ACTIVE_CONFIG
+//............................................................................
+void QMsm::updateConfig_() noexcept {
+    QActiveConfig * const cfg = activeConfig();
+    if (cfg == nullptr) { // this SM does not cache its configuration?
+        return;
+    }
+
+    // record the current state and all its superstates
+    std::uint8_t n = 0U;
+    QMState const *s = m_state.obj;
+    while ((s != nullptr) && (n < cfg->state.size())) {
+        cfg->state[n].obj = s;
+        ++n;
+        s = s->superstate; // advance to the superstate
+    }
+    // the configuration is known only if the whole chain fits
+    cfg->len = (s == nullptr) ? n : 0U;
+}
+#endif // def QASM_ACTIVE_CONFIG
+
 //............................................................................
 bool QMsm::isIn(QStateHandler const stateHndl) noexcept {
     bool inState = false; // assume that this SM is not in 'state'
+
+#ifdef QASM_ACTIVE_CONFIG
+    // is the cached active configuration for the current state?
+    QActiveConfig const * const cfg = activeConfig();
+    if ((cfg != nullptr) && (cfg->len != 0U)
+        && (cfg->state[0U].obj == m_state.obj))
+    {
+        for (std::size_t i = 0U; i < cfg->len; ++i) {
+            if (cfg->state[i].obj->stateHandler == stateHndl) { // match?
+                inState = true;
+                break;
+            }
+        }
+        return inState;
+    }
+#endif // def QASM_ACTIVE_CONFIG
     QMState const *s = m_state.obj;
     while (s != nullptr) {
         if (s->stateHandler == stateHndl) { // match found?
@@ -408,6 +452,23 @@ bool QMsm::isIn(QStateHandler const stateHndl) noexcept {
 QMState const * QMsm::childStateObj(QMState const * const parentHndl)
     const noexcept
 {
+#ifdef QASM_ACTIVE_CONFIG
+    // is the cached active configuration for the current state?
+    QActiveConfig const * const cfg = activeConfig();
+    if ((cfg != nullptr) && (cfg->len != 0U)
+        && (cfg->state[0U].obj == m_state.obj))
+    {
+        std::size_t i = 0U;
+        while ((i < cfg->len) && (cfg->state[i].obj != parentHndl)) {
+            ++i;
+        }
+        // the parent must be in the active configuration
+        Q_ENSURE_LOCAL(890, i < cfg->len);
+
+        return cfg->state[(i > 0U) ? (i - 1U) : 0U].obj;
+    }
+#endif // def QASM_ACTIVE_CONFIG
+
     QMState const *s = m_state.obj; // start with current state
     QMState const *child = s;
     bool isFound = false; // assume the child NOT found
@@ -0,0 +1,139 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#define QP_IMPL             // this is QP implementation
+#include "qp_port.hpp"      // QP port
+#include "qp_pkg.hpp"       // QP package-scope interface
+#include "qsafe.h"          // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY                // QS software tracing enabled?
+    #include "qs_port.hpp"  // QS port
+    #include "qs_pkg.hpp"   // QS facilities for pre-defined trace records
+#else
+    #include "qs_dummy.hpp" // disable the QS software tracing
+#endif // Q_SPY
+#include "qtsm.hpp"         // compile-time (template) state machines
+
+// NOTE: QTsm state machines are implemented entirely in "qtsm.hpp".
+// This module only produces the predefined QS trace records for them,
+// because these records are available only inside the QP implementation.
+
+#ifdef Q_SPY
+
+//============================================================================
+namespace QP {
+
+//............................................................................
+void QTsmSpy::stateAct_(std::uint_fast8_t const rec,
+    void const * const obj, QStateHandler const state,
+    std::uint_fast8_t const qsId) noexcept
+{
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_BEGIN_PRE(rec, qsId)
+        QS_OBJ_PRE(obj);
+        QS_FUN_PRE(state);
+    QS_END_PRE()
+    QS_CRIT_EXIT();
+}
+//............................................................................
+void QTsmSpy::tranSeg_(std::uint_fast8_t const rec,
+    void const * const obj, QStateHandler const src,
+    QStateHandler const trg, std::uint_fast8_t const qsId) noexcept
+{
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_BEGIN_PRE(rec, qsId)
+        QS_OBJ_PRE(obj);
+        QS_FUN_PRE(src);
+        QS_FUN_PRE(trg);
+    QS_END_PRE()
+    QS_CRIT_EXIT();
+}
+//............................................................................
+void QTsmSpy::tranAct_(std::uint_fast8_t const rec, QSignal const sig,
+    void const * const obj, QStateHandler const state,
+    std::uint_fast8_t const qsId) noexcept
+{
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_BEGIN_PRE(rec, qsId)
+        QS_SIG_PRE(sig);
+        QS_OBJ_PRE(obj);
+        QS_FUN_PRE(state);
+    QS_END_PRE()
+    QS_CRIT_EXIT();
+}
+//............................................................................
+void QTsmSpy::tran0_(std::uint_fast8_t const rec, QSignal const sig,
+    void const * const obj, QStateHandler const state,
+    std::uint_fast8_t const qsId) noexcept
+{
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_BEGIN_PRE(rec, qsId)
+        QS_TIME_PRE();
+        QS_SIG_PRE(sig);
+        QS_OBJ_PRE(obj);
+        QS_FUN_PRE(state);
+    QS_END_PRE()
+    QS_CRIT_EXIT();
+}
+//............................................................................
+void QTsmSpy::topInit_(std::uint_fast8_t const rec,
+    void const * const obj, QStateHandler const trg,
+    std::uint_fast8_t const qsId) noexcept
+{
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_BEGIN_PRE(rec, qsId)
+        QS_TIME_PRE();
+        QS_OBJ_PRE(obj);
+        QS_FUN_PRE(trg);
+    QS_END_PRE()
+    QS_CRIT_EXIT();
+}
+//............................................................................
+void QTsmSpy::tranEnd_(std::uint_fast8_t const rec, QSignal const sig,
+    void const * const obj, QStateHandler const src,
+    QStateHandler const trg, std::uint_fast8_t const qsId) noexcept
+{
+    QS_CRIT_STAT
+    QS_CRIT_ENTRY();
+    QS_BEGIN_PRE(rec, qsId)
+        QS_TIME_PRE();
+        QS_SIG_PRE(sig);
+        QS_OBJ_PRE(obj);
+        QS_FUN_PRE(src);
+        QS_FUN_PRE(trg);
+    QS_END_PRE()
+    QS_CRIT_EXIT();
+}
+
+} // namespace QP
+
+#endif // def Q_SPY
@@ -62,20 +62,50 @@ void QEvt_refCtr_inc_(QEvt const * const me) noexcept {
     Q_REQUIRE_INCRIT(200, me->refCtr_ < (QF_MAX_ACTIVE + QF_MAX_ACTIVE));
 
     QEvt * const mut_me = const_cast<QEvt *>(me); // cast 'const' away
+#ifndef QEVT_REFCTR_ATOMIC
     ++mut_me->refCtr_;
+#else
+    // a new reference can only be made from an existing one
+    mut_me->refCtr_.fetch_add(1U, std::memory_order_relaxed);
+#endif
+}
+//............................................................................
+void QEvt_refCtr_incEvt_(QEvt const * const me) noexcept {
+    // NOTE: this function must be called inside QF_EVT_CRIT_ENTRY_(),
+    // which might not establish a critical section (see Q_REQUIRE_EVT_)
+
+    // the event reference count must not exceed the number of AOs
+    // in the system plus each AO possibly holding one event reference
+    Q_REQUIRE_EVT_(210, me->refCtr_ < (QF_MAX_ACTIVE + QF_MAX_ACTIVE));
+
+    QEvt * const mut_me = const_cast<QEvt *>(me); // cast 'const' away
+#ifndef QEVT_REFCTR_ATOMIC
+    ++mut_me->refCtr_;
+#else
+    // a new reference can only be made from an existing one
+    mut_me->refCtr_.fetch_add(1U, std::memory_order_relaxed);
+#endif
 }
 //............................................................................
 void QEvt_refCtr_dec_(QEvt const * const me) noexcept {
     // NOTE: this function must be called inside a critical section
     QEvt * const mut_me = const_cast<QEvt *>(me); // cast 'const' away
+#ifndef QEVT_REFCTR_ATOMIC
     --mut_me->refCtr_;
+#else
+    mut_me->refCtr_.fetch_sub(1U, std::memory_order_release);
+#endif
 }
 
 //----------------------------------------------------------------------------
 QAsm::QAsm() noexcept // default QAsm ctor
   : m_state(),
     m_temp ()
-{}
+{
+#ifdef QHSM_SIG_TABLES
+    m_sigTbls = false; // no signal tables (see QHsm::addSigTable())
+#endif
+}
 //............................................................................
 QState QAsm::top(void * const me, QEvt const * const e) noexcept {
     Q_UNUSED_PAR(me);
@@ -37,6 +37,9 @@
     #include "qs_dummy.hpp" // disable the QS software tracing
 #endif // Q_SPY
 
+// the QP port provides its own AO event queue (e.g., lock-free MPSC queue)?
+#ifndef QACTIVE_EQUEUE_MPSC
+
 //============================================================================
 // unnamed namespace for local definitions with internal linkage
 namespace {
@@ -60,7 +63,7 @@ bool QActive::postx_(
 #endif // def Q_UTEST
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QACTIVE_EQUEUE_CRIT_ENTRY_(this);
 
     // the event to post must not be NULL
     Q_REQUIRE_INCRIT(100, e != nullptr);
@@ -76,13 +79,15 @@ bool QActive::postx_(
 
 #if (QF_MAX_EPOOL > 0U)
         if (e->poolNum_ != 0U) { // is it a mutable event?
+            QF_EVT_LOCK_(e);
             QEvt_refCtr_inc_(e); // increment the reference counter
+            QF_EVT_UNLOCK_(e);
         }
 #endif // (QF_MAX_EPOOL > 0U)
 
         postFIFO_(e, sender);
 
-        QF_CRIT_EXIT();
+        QACTIVE_EQUEUE_CRIT_EXIT_(this);
 #ifdef Q_UTEST
         if (QS_LOC_CHECK_(m_prio)) {
             QS::onTestPost(sender, this, e, true); // QUTest callback
@@ -100,7 +105,7 @@ bool QActive::postx_(
             QS_EQC_PRE(margin);  // margin requested
         QS_END_PRE()
 
-        QF_CRIT_EXIT();
+        QACTIVE_EQUEUE_CRIT_EXIT_(this);
 
 #ifdef Q_UTEST
         if (QS_LOC_CHECK_(m_prio)) {
@@ -116,6 +121,104 @@ bool QActive::postx_(
     return status;
 }
 
+//............................................................................
+bool QActive::postBatchx_(
+    QEvt const * const * const evts,
+    std::uint_fast16_t const n,
+    std::uint_fast16_t const margin,
+    void const * const sender) noexcept
+{
+#ifdef Q_UTEST // test?
+#if (Q_UTEST != 0) // testing QP-stub?
+    if (m_temp.fun == Q_STATE_CAST(0)) { // QActiveDummy?
+        bool status = true;
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            status = static_cast<QActiveDummy *>(this)->fakePost(
+                evts[i], margin, sender) && status;
+        }
+        return status;
+    }
+#endif // (Q_UTEST != 0)
+#endif // def Q_UTEST
+
+    QF_CRIT_STAT
+    QACTIVE_EQUEUE_CRIT_ENTRY_(this);
+
+    // the events to post must be provided
+    Q_REQUIRE_INCRIT(150, (evts != nullptr) && (n > 0U));
+
+    QEQueueCtr const nFree = m_eQueue.m_nFree; // get member into temporary
+
+    // all-or-nothing: the queue must accommodate all n events (plus margin)
+    bool status = (margin == QF::NO_MARGIN)
+        ? true
+        : (static_cast<std::uint_fast16_t>(nFree) >= (n + margin));
+    if (status) { // should try to post the events?
+
+        // the queue must have free slots for all the events
+        Q_ASSERT_INCRIT(160, static_cast<std::uint_fast16_t>(nFree) >= n);
+
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            QEvt const * const e = evts[i];
+
+            // the event to post must not be NULL
+            Q_ASSERT_INCRIT(170, e != nullptr);
+
+#if (QF_MAX_EPOOL > 0U)
+            if (e->poolNum_ != 0U) { // is it a mutable event?
+                QF_EVT_LOCK_(e);
+                QEvt_refCtr_inc_(e); // increment the reference counter
+                QF_EVT_UNLOCK_(e);
+            }
+#endif // (QF_MAX_EPOOL > 0U)
+
+            // NOTE: only the first event posted to an empty queue signals
+            // the queue, so the whole batch produces a single wakeup
+            postFIFO_(e, sender);
+        }
+
+        QACTIVE_EQUEUE_CRIT_EXIT_(this);
+#ifdef Q_UTEST
+        if (QS_LOC_CHECK_(m_prio)) {
+            for (std::uint_fast16_t i = 0U; i < n; ++i) {
+                QS::onTestPost(sender, this, evts[i], true); // QUTest callback
+            }
+        }
+#endif // def Q_UTEST
+    }
+    else { // events cannot be posted, but it is OK
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            QS_BEGIN_PRE(QS_QF_ACTIVE_POST_ATTEMPT, m_prio)
+                QS_TIME_PRE();       // timestamp
+                QS_OBJ_PRE(sender);  // the sender object
+                QS_SIG_PRE(evts[i]->sig); // the signal of the event
+                QS_OBJ_PRE(this);    // this active object (recipient)
+                QS_2U8_PRE(evts[i]->poolNum_, evts[i]->refCtr_);
+                QS_EQC_PRE(nFree);   // # free entries
+                QS_EQC_PRE(margin);  // margin requested
+            QS_END_PRE()
+        }
+
+        QACTIVE_EQUEUE_CRIT_EXIT_(this);
+
+#ifdef Q_UTEST
+        if (QS_LOC_CHECK_(m_prio)) {
+            for (std::uint_fast16_t i = 0U; i < n; ++i) {
+                QS::onTestPost(sender, this, evts[i], status); // QUTEst
+            }
+        }
+#endif // def Q_USTEST
+
+#if (QF_MAX_EPOOL > 0U)
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            QF::gc(evts[i]); // recycle the events to avoid a leak
+        }
+#endif // (QF_MAX_EPOOL > 0U)
+    }
+
+    return status;
+}
+
 //............................................................................
 void QActive::postLIFO(QEvt const * const e) noexcept {
 #ifdef Q_UTEST // test?
@@ -128,7 +231,7 @@ void QActive::postLIFO(QEvt const * const e) noexcept {
 #endif // def Q_UTEST
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QACTIVE_EQUEUE_CRIT_ENTRY_(this);
 
     // the event to post must be be valid (which includes not NULL)
     Q_REQUIRE_INCRIT(200, e != nullptr);
@@ -139,7 +242,9 @@ void QActive::postLIFO(QEvt const * const e) noexcept {
     Q_REQUIRE_INCRIT(230, nFree != 0U);
 
     if (e->poolNum_ != 0U) { // is it a mutable event?
+        QF_EVT_LOCK_(e);
         QEvt_refCtr_inc_(e); // increment the reference counter
+        QF_EVT_UNLOCK_(e);
     }
 
     --nFree; // one free entry just used up
@@ -162,9 +267,9 @@ void QActive::postLIFO(QEvt const * const e) noexcept {
     // as producing the #QS_QF_ACTIVE_POST trace record, which are:
     // the local filter for this AO ('m_prio') is set
     if (QS_LOC_CHECK_(m_prio)) {
-        QF_CRIT_EXIT();
+        QACTIVE_EQUEUE_CRIT_EXIT_(this);
         QS::onTestPost(nullptr, this, e, true);
-        QF_CRIT_ENTRY();
+        QACTIVE_EQUEUE_CRIT_ENTRY_(this);
     }
 #endif // def Q_UTEST
 
@@ -184,13 +289,13 @@ void QActive::postLIFO(QEvt const * const e) noexcept {
         QACTIVE_EQUEUE_SIGNAL_(this); // signal the event queue
     }
 
-    QF_CRIT_EXIT();
+    QACTIVE_EQUEUE_CRIT_EXIT_(this);
 }
 
 //............................................................................
 QEvt const * QActive::get_() noexcept {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QACTIVE_EQUEUE_CRIT_ENTRY_(this);
 
     // wait for event to arrive directly (depends on QP port)
     // NOTE: might use assertion-IDs 400-409
@@ -246,11 +351,85 @@ QEvt const * QActive::get_() noexcept {
         QS_END_PRE()
     }
 
-    QF_CRIT_EXIT();
+    QACTIVE_EQUEUE_CRIT_EXIT_(this);
 
     return e;
 }
 
+#ifdef QF_DISPATCH_QUOTA
+//............................................................................
+std::uint_fast16_t QActive::getBatch_(
+    QEvt const ** const evts,
+    std::uint_fast16_t const max) noexcept
+{
+    QF_CRIT_STAT
+    QACTIVE_EQUEUE_CRIT_ENTRY_(this);
+
+    // wait for event to arrive directly (depends on QP port)
+    // NOTE: might use assertion-IDs 400-409
+    QACTIVE_EQUEUE_WAIT_(this);
+
+    QEvt const *e = m_eQueue.m_frontEvt.e;
+
+    // the queue must NOT be empty and the batch must be in range
+    Q_REQUIRE_INCRIT(380, (e != nullptr)
+        && (0U < max) && (max <= QF_DISPATCH_QUOTA));
+
+    // remove up to 'max' events in one critical section, see NOTE1
+    QEQueueCtr nFree = m_eQueue.m_nFree; // get member into temporary
+    QEQueueCtr tail  = m_eQueue.m_tail;  // get member into temporary
+    std::uint_fast16_t n = 0U;
+    do {
+        evts[n] = e;
+        ++n;
+        ++nFree; // one more free event in the queue
+
+        if (nFree <= m_eQueue.m_end) { // any events in the ring buffer?
+
+            QS_BEGIN_PRE(QS_QF_ACTIVE_GET, m_prio)
+                QS_TIME_PRE();       // timestamp
+                QS_SIG_PRE(e->sig);  // the signal of this event
+                QS_OBJ_PRE(this);    // this active object
+                QS_2U8_PRE(e->poolNum_, e->refCtr_);
+                QS_EQC_PRE(nFree);   // # free entries
+            QS_END_PRE()
+
+            // remove event from the tail
+            e = m_eQueue.m_ring[tail].e;
+
+            // the event queue must not be empty (frontEvt != NULL)
+            Q_ASSERT_INCRIT(350, e != nullptr);
+
+            if (tail == 0U) { // need to wrap the tail?
+                tail = m_eQueue.m_end;
+            }
+            --tail; // advance the tail (counter-clockwise)
+        }
+        else {
+            // all entries in the queue must be free (+1 for fronEvt)
+            Q_ASSERT_INCRIT(370, nFree == (m_eQueue.m_end + 1U));
+
+            QS_BEGIN_PRE(QS_QF_ACTIVE_GET_LAST, m_prio)
+                QS_TIME_PRE();       // timestamp
+                QS_SIG_PRE(e->sig);  // the signal of this event
+                QS_OBJ_PRE(this);    // this active object
+                QS_2U8_PRE(e->poolNum_, e->refCtr_);
+            QS_END_PRE()
+
+            e = nullptr; // queue becomes empty
+        }
+    } while ((e != nullptr) && (n < max));
+
+    m_eQueue.m_frontEvt.e = e; // update the original
+    m_eQueue.m_nFree = nFree;  // update the original
+    m_eQueue.m_tail  = tail;   // update the original
+
+    QACTIVE_EQUEUE_CRIT_EXIT_(this);
+
+    return n;
+}
+#endif // def QF_DISPATCH_QUOTA
+
 //............................................................................
 void QActive::postFIFO_(
     QEvt const * const e,
@@ -307,7 +486,7 @@ void QActive::postFIFO_(
 }
 
 //............................................................................
-std::uint16_t QActive::getQueueUse(std::uint_fast8_t const prio) noexcept {
+std::uint16_t QActive::getQueueUse(QPrio const prio) noexcept {
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
 
@@ -322,14 +501,18 @@ std::uint16_t QActive::getQueueUse(std::uint_fast8_t const prio) noexcept {
         Q_REQUIRE_INCRIT(510, a != nullptr);
 
         // NOTE: QEQueue_getUse() does NOT apply crit.sect. internally
+        QACTIVE_EQUEUE_LOCK_(a);
         nUse = a->m_eQueue.getUse();
+        QACTIVE_EQUEUE_UNLOCK_(a);
     }
     else { // special case of prio==0U: use of all AO event queues
-        for (std::uint_fast8_t p = QF_MAX_ACTIVE; p > 0U; --p) {
+        for (QPrio p = QF_MAX_ACTIVE; p > 0U; --p) {
             QActive const * const a = QActive_registry_[p];
             if (a != nullptr) { // is the AO registered?
                 // NOTE: QEQueue::getUse() does NOT apply crit.sect. internally
+                QACTIVE_EQUEUE_LOCK_(a);
                 nUse += a->m_eQueue.getUse();
+                QACTIVE_EQUEUE_UNLOCK_(a);
             }
         }
     }
@@ -340,7 +523,7 @@ std::uint16_t QActive::getQueueUse(std::uint_fast8_t const prio) noexcept {
 }
 
 //............................................................................
-std::uint16_t QActive::getQueueFree(std::uint_fast8_t const prio) noexcept {
+std::uint16_t QActive::getQueueFree(QPrio const prio) noexcept {
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
 
@@ -351,15 +534,17 @@ std::uint16_t QActive::getQueueFree(std::uint_fast8_t const prio) noexcept {
     Q_REQUIRE_INCRIT(610, a != nullptr);
 
     // NOTE: critical section prevents asynchronous change of the free count
+    QACTIVE_EQUEUE_LOCK_(a);
     std::uint16_t const nFree =
         static_cast<std::uint16_t>(a->m_eQueue.m_nFree);
+    QACTIVE_EQUEUE_UNLOCK_(a);
     QF_CRIT_EXIT();
 
     return nFree;
 }
 
 //............................................................................
-std::uint16_t QActive::getQueueMin(std::uint_fast8_t const prio) noexcept {
+std::uint16_t QActive::getQueueMin(QPrio const prio) noexcept {
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
 
@@ -371,7 +556,9 @@ std::uint16_t QActive::getQueueMin(std::uint_fast8_t const prio) noexcept {
     Q_REQUIRE_INCRIT(710, a != nullptr);
 
     // NOTE: critical section prevents asynchronous change of the min count
+    QACTIVE_EQUEUE_LOCK_(a);
     std::uint16_t const nMin = static_cast<std::uint16_t>(a->m_eQueue.m_nMin);
+    QACTIVE_EQUEUE_UNLOCK_(a);
 
     QF_CRIT_EXIT();
 
@@ -398,14 +585,14 @@ void QTicker::init(
     Q_UNUSED_PAR(qsId);
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QACTIVE_EQUEUE_CRIT_ENTRY_(this);
 
     // instead of the top-most initial transition, QTicker initializes
     // the super.eQueue member inherited from QActive and reused
     // to count the number of tick events posted to this QTicker.
     // see also: QTicker_trig_()
     m_eQueue.m_tail = 0U;
-    QF_CRIT_EXIT();
+    QACTIVE_EQUEUE_CRIT_EXIT_(this);
 }
 
 //............................................................................
@@ -417,7 +604,7 @@ void QTicker::dispatch(
     Q_UNUSED_PAR(qsId);
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QACTIVE_EQUEUE_CRIT_ENTRY_(this);
 
     // get members into temporaries
     QEQueueCtr nTicks = m_eQueue.m_tail;
@@ -428,7 +615,7 @@ void QTicker::dispatch(
 
     m_eQueue.m_tail = 0U; // clear # ticks
 
-    QF_CRIT_EXIT();
+    QACTIVE_EQUEUE_CRIT_EXIT_(this);
 
     // instead of dispatching the event, QTicker calls QTimeEvt_tick_()
     // processing for the number of times indicated in eQueue.tail.
@@ -447,7 +634,7 @@ void QTicker::trig_(void const * const sender) noexcept {
     static constexpr QEvt tickEvt(0U);
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QACTIVE_EQUEUE_CRIT_ENTRY_(this);
 
     QEQueueCtr nTicks = m_eQueue.m_tail; // get member into temporary
 
@@ -481,9 +668,24 @@ void QTicker::trig_(void const * const sender) noexcept {
         QS_EQC_PRE(0U);     // min # free entries
     QS_END_PRE()
 
-    QF_CRIT_EXIT();
+    QACTIVE_EQUEUE_CRIT_EXIT_(this);
 }
 
 #endif // (QF_MAX_TICK_RATE > 0U)
 
 } // namespace QP
+
+#endif // ndef QACTIVE_EQUEUE_MPSC
+
+//============================================================================
+// NOTE1:
+// With QF_DISPATCH_QUOTA defined in "qp_config.hpp", the QV kernel and the
+// POSIX ports remove up to QF_DISPATCH_QUOTA events from the queue of the
+// scheduled AO in one critical section (QActive::getBatch_()), dispatch
+// them back to back and then garbage-collect them together (QF::gcBatch_()).
+// This amortizes the scheduling and locking overhead under bursty load, but
+// a higher-priority AO becoming ready in the meantime must wait until the
+// whole batch is processed. Also, the events removed in one batch are
+// processed before an event that the AO posts to itself with postLIFO()
+// (e.g., QActive::recall()) while processing the batch.
+//
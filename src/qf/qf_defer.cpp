@@ -89,7 +89,7 @@ bool QActive::recall(QEQueue * const eq) noexcept {
         postLIFO(e);
 
         QF_CRIT_STAT
-        QF_CRIT_ENTRY();
+        QF_EVT_CRIT_ENTRY_(e);
 
         if (e->poolNum_ != 0U) { // mutable event?
 
@@ -97,7 +97,7 @@ bool QActive::recall(QEQueue * const eq) noexcept {
             // at least twice: once in the deferred event queue (eq->get()
             // did NOT decrement the reference counter) and once in the
             // AO's event queue.
-            Q_ASSERT_INCRIT(210, e->refCtr_ >= 2U);
+            Q_ASSERT_EVT_(210, e->refCtr_ >= 2U);
 
             // decrement the reference counter once, to account for removing
             // the event from the deferred queue.
@@ -112,7 +112,7 @@ bool QActive::recall(QEQueue * const eq) noexcept {
             QS_2U8_PRE(e->poolNum_, e->refCtr_);
         QS_END_PRE()
 
-        QF_CRIT_EXIT();
+        QF_EVT_CRIT_EXIT_(e);
 
         recalled = true; // success
     }
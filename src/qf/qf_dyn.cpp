@@ -77,6 +77,22 @@ void poolInit(
     // perform the port-dependent initialization of the event-pool
     QF_EPOOL_INIT_(priv_.ePool_[poolNum], poolSto, poolSize, evtSize);
 
+#ifdef QF_EPOOL_LUT_SIZE
+    // map the size classes not served by the smaller pools yet, see NOTE1
+    QF_CRIT_ENTRY();
+    std::uint_fast16_t const blockSize =
+        QF_EPOOL_EVENT_SIZE_(priv_.ePool_[poolNum]);
+    for (std::uint_fast16_t i = 0U;
+         (i < QF_EPOOL_LUT_SIZE) && ((i * QF_EPOOL_LUT_GRANULE) <= blockSize);
+         ++i)
+    {
+        if (priv_.poolLut_[i] == 0U) { // size class not served yet?
+            priv_.poolLut_[i] = static_cast<std::uint8_t>(poolNum + 1U);
+        }
+    }
+    QF_CRIT_EXIT();
+#endif // def QF_EPOOL_LUT_SIZE
+
 #ifdef Q_SPY
     // generate the QS object-dictionary entry for the initialized pool
     {
@@ -128,13 +144,17 @@ std::uint16_t getPoolUse(std::uint_fast8_t const poolNum) noexcept {
     std::uint16_t nUse = 0U;
     if (poolNum > 0U) { // event pool number provided?
         // set event pool use from the port-dependent operation
+        QF_MEM_LOCK_(&priv_.ePool_[poolNum - 1U]);
         nUse = QF_EPOOL_USE_(&priv_.ePool_[poolNum - 1U]);
+        QF_MEM_UNLOCK_(&priv_.ePool_[poolNum - 1U]);
     }
     else { // special case of poolNum==0
         // calculate the sum of used entries in all event pools
         for (std::uint_fast8_t pool = priv_.maxPool_; pool > 0U; --pool) {
             // add the event pool use from the port-dependent operation
+            QF_MEM_LOCK_(&priv_.ePool_[pool - 1U]);
             nUse += QF_EPOOL_USE_(&priv_.ePool_[pool - 1U]);
+            QF_MEM_UNLOCK_(&priv_.ePool_[pool - 1U]);
         }
     }
 
@@ -160,7 +180,9 @@ std::uint16_t getPoolFree(std::uint_fast8_t const poolNum) noexcept {
     // the poolNum paramter must be in range
     Q_REQUIRE_INCRIT(420, (0U < poolNum) && (poolNum <= maxPool));
 #endif
+    QF_MEM_LOCK_(&priv_.ePool_[poolNum - 1U]);
     std::uint16_t const nFree = QF_EPOOL_FREE_(&priv_.ePool_[poolNum - 1U]);
+    QF_MEM_UNLOCK_(&priv_.ePool_[poolNum - 1U]);
 
     QF_CRIT_EXIT();
 
@@ -185,7 +207,9 @@ std::uint16_t getPoolMin(std::uint_fast8_t const poolNum) noexcept {
     Q_REQUIRE_INCRIT(520, (0U < poolNum) && (poolNum <= maxPool));
 #endif
     // call port-specific operation for the minimum of free blocks so far
+    QF_MEM_LOCK_(&priv_.ePool_[poolNum - 1U]);
     std::uint16_t const nMin = QF_EPOOL_MIN_(&priv_.ePool_[poolNum - 1U]);
+    QF_MEM_UNLOCK_(&priv_.ePool_[poolNum - 1U]);
 
     QF_CRIT_EXIT();
 
@@ -194,11 +218,26 @@ std::uint16_t getPoolMin(std::uint_fast8_t const poolNum) noexcept {
 #endif // QF_EPOOL_MIN_
 
 //............................................................................
-QEvt * newX_(
-    std::uint_fast16_t const evtSize,
-    std::uint_fast16_t const margin,
-    QSignal const sig) noexcept
+// find the (1-based) number of the smallest event pool that fits 'evtSize'
+static std::uint_fast8_t findPool_(
+    std::uint_fast16_t const evtSize) noexcept;
+static std::uint_fast8_t findPool_(
+    std::uint_fast16_t const evtSize) noexcept
 {
+#ifdef QF_EPOOL_LUT_SIZE
+    std::uint_fast16_t const sizeClass = sizeClass_(evtSize);
+    if (sizeClass < QF_EPOOL_LUT_SIZE) { // size class in the table?
+        // NOTE: the table is complete before any allocation, see NOTE1
+        std::uint_fast8_t const poolNum = priv_.poolLut_[sizeClass];
+
+        // event pool must be found, which means that the reqeusted event
+        // size fits in one of the initialized pools
+        Q_ASSERT_LOCAL(620, poolNum != 0U);
+
+        return poolNum;
+    }
+#endif // def QF_EPOOL_LUT_SIZE
+
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
 
@@ -220,10 +259,30 @@ QEvt * newX_(
     // fits in one of the initialized pools
     Q_ASSERT_INCRIT(620, poolNum < maxPool);
 
-    ++poolNum; // convert to 1-based poolNum
-
     QF_CRIT_EXIT();
 
+    return poolNum + 1U; // convert to 1-based poolNum
+}
+
+//............................................................................
+// allocate an event from the given (1-based) event pool
+static QEvt * newFromPool_(
+    std::uint_fast8_t const poolNum,
+    std::uint_fast16_t const evtSize,
+    std::uint_fast16_t const margin,
+    QSignal const sig) noexcept;
+static QEvt * newFromPool_(
+    std::uint_fast8_t const poolNum,
+    std::uint_fast16_t const evtSize,
+    std::uint_fast16_t const margin,
+    QSignal const sig) noexcept
+{
+#ifndef Q_SPY
+    Q_UNUSED_PAR(evtSize);
+#endif
+
+    QF_CRIT_STAT
+
     // get event e (port-dependent)...
     QEvt *e;
 #ifdef Q_SPY
@@ -273,64 +332,251 @@ QEvt * newX_(
 }
 
 //............................................................................
-void gc(QEvt const * const e) noexcept {
+QEvt * newX_(
+    std::uint_fast16_t const evtSize,
+    std::uint_fast16_t const margin,
+    QSignal const sig) noexcept
+{
+    return newFromPool_(findPool_(evtSize), evtSize, margin, sig);
+}
+
+#ifdef QF_EPOOL_LUT_SIZE
+//............................................................................
+QEvt * newClassX_(
+    std::uint_fast16_t const sizeClass,
+    std::uint_fast16_t const evtSize,
+    std::uint_fast16_t const margin,
+    QSignal const sig) noexcept
+{
+    // the size class must be in the table (resolved at compile time)
+    Q_REQUIRE_LOCAL(660, sizeClass < QF_EPOOL_LUT_SIZE);
+
+    // NOTE: the table is complete before any allocation, see NOTE1
+    std::uint_fast8_t const poolNum = priv_.poolLut_[sizeClass];
+
+    // event pool must be found, which means that the reqeusted event size
+    // fits in one of the initialized pools
+    Q_ASSERT_LOCAL(620, poolNum != 0U);
+
+    return newFromPool_(poolNum, evtSize, margin, sig);
+}
+#endif // def QF_EPOOL_LUT_SIZE
+
+//............................................................................
+bool newBatchX_(
+    QEvt ** const evts,
+    std::uint_fast16_t const n,
+    std::uint_fast16_t const evtSize,
+    std::uint_fast16_t const margin,
+    QSignal const sig) noexcept
+{
+    // the storage for the events must be provided
+    Q_REQUIRE_LOCAL(640, (evts != nullptr) && (n > 0U));
+
+    std::uint_fast8_t const poolNum = findPool_(evtSize);
+
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+
+    // get all n events at once or none (port-dependent)...
+    // NOTE: the events are delivered straight into the caller's array
+    std::uint_fast16_t nGot;
+#ifdef Q_SPY
+    QF_EPOOL_GET_BATCH_(priv_.ePool_[poolNum - 1U], evts, n,
+                  ((margin != NO_MARGIN) ? margin : 0U),
+                  static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum, nGot);
+#else
+    QF_EPOOL_GET_BATCH_(priv_.ePool_[poolNum - 1U], evts, n,
+                  ((margin != NO_MARGIN) ? margin : 0U), 0U, nGot);
+#endif
+
+    bool const status = (nGot == n);
+    if (status) { // were all n events allocated?
+        for (std::uint_fast16_t i = 0U; i < n; ++i) {
+            QEvt * const e = evts[i];
+            e->sig      = static_cast<QSignal>(sig); // set the signal
+            e->poolNum_ = poolNum;
+            e->refCtr_  = 0U; // reference count starts at 0
+
+            QS_CRIT_ENTRY();
+            QS_BEGIN_PRE(QS_QF_NEW,
+                    static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum)
+                QS_TIME_PRE();        // timestamp
+                QS_EVS_PRE(evtSize);  // the size of the event
+                QS_SIG_PRE(sig);      // the signal of the event
+            QS_END_PRE()
+            QS_CRIT_EXIT();
+        }
+    }
+    else { // not all events could be allocated (all-or-nothing)
+
+        // return a partial batch back to the pool, which can happen only
+        // with the one-by-one QF_EPOOL_GET_BATCH_() (see qp_pkg.hpp)
+        for (std::uint_fast16_t i = 0U; i < nGot; ++i) {
+#ifdef Q_SPY
+            QF_EPOOL_PUT_(priv_.ePool_[poolNum - 1U], evts[i],
+                static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum);
+#else
+            QF_EPOOL_PUT_(priv_.ePool_[poolNum - 1U], evts[i], 0U);
+#endif
+        }
+
+        QF_CRIT_ENTRY();
+        // This assertion means that the event allocation failed,
+        // and this failure cannot be tolerated. The most frequent
+        // reason is an event leak in the application.
+        Q_ASSERT_INCRIT(650, margin != NO_MARGIN);
+
+        QS_BEGIN_PRE(QS_QF_NEW_ATTEMPT,
+                static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum)
+            QS_TIME_PRE();        // timestamp
+            QS_EVS_PRE(evtSize);  // the size of the event
+            QS_SIG_PRE(sig);      // the signal of the event
+        QS_END_PRE()
+
+        QF_CRIT_EXIT();
+    }
+
+    return status;
+}
+
+//............................................................................
+// release one reference to the event 'e' and return the number of the pool,
+// to which 'e' must be recycled (or 0, if 'e' is not garbage yet)
+static std::uint_fast8_t release_(QEvt const * const e) noexcept;
+static std::uint_fast8_t release_(QEvt const * const e) noexcept {
+    // NOTE: with QEVT_REFCTR_ATOMIC (outside the Spy build) the following
+    // critical section is empty, so the immutable events are not locked
+    QF_CRIT_STAT
+    QF_EVT_CRIT_ENTRY_(e);
 
     // the collected event must be valid
-    Q_REQUIRE_INCRIT(700, e != nullptr);
+    Q_REQUIRE_EVT_(700, e != nullptr);
 
     std::uint8_t const poolNum = static_cast<std::uint8_t>(e->poolNum_);
     if (poolNum != 0U) { // is it a pool event (mutable)?
 
-        if (e->refCtr_ > 1U) { // isn't this the last reference?
+#ifndef QEVT_REFCTR_ATOMIC
+        std::uint_fast16_t const refCtr = e->refCtr_;
+#else
+        // atomically decrement the ref counter and get its previous value,
+        // so that exactly one of the concurrent gc() calls recycles 'e'
+        // NOTE: casting 'const' away is legit because 'e' is a pool event
+        std::uint_fast16_t const refCtr =
+            const_cast<QEvt *>(e)->refCtr_.fetch_sub(
+                1U, std::memory_order_acq_rel);
+#endif
+
+        if (refCtr > 1U) { // isn't this the last reference?
 
             QS_BEGIN_PRE(QS_QF_GC_ATTEMPT,
                     static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum)
                 QS_TIME_PRE();       // timestamp
                 QS_SIG_PRE(e->sig);  // the signal of the event
-                QS_2U8_PRE(poolNum, e->refCtr_);
+                QS_2U8_PRE(poolNum, refCtr);
             QS_END_PRE()
 
+#ifndef QEVT_REFCTR_ATOMIC
             QEvt_refCtr_dec_(e); // decrement the ref counter
+#endif
 
-            QF_CRIT_EXIT();
+            QF_EVT_CRIT_EXIT_(e);
+            return 0U; // not garbage yet
         }
         else { // this is the last reference to this event, recycle it
 #ifndef Q_UNSAFE
             std::uint8_t const maxPool = priv_.maxPool_;
 
             // the maximum count of initialized pools must be in configured range
-            Q_ASSERT_INCRIT(740, maxPool <= QF_MAX_EPOOL);
+            Q_ASSERT_EVT_(740, maxPool <= QF_MAX_EPOOL);
 
             // the event poolNum must be one one the initialized event pools
-            Q_ASSERT_INCRIT(750, poolNum <= maxPool);
+            Q_ASSERT_EVT_(750, poolNum <= maxPool);
 #endif
             QS_BEGIN_PRE(QS_QF_GC,
                     static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum)
                 QS_TIME_PRE();       // timestamp
                 QS_SIG_PRE(e->sig);  // the signal of the event
-                QS_2U8_PRE(poolNum, e->refCtr_);
+                QS_2U8_PRE(poolNum, refCtr);
             QS_END_PRE()
 
-            QF_CRIT_EXIT();
+            QF_EVT_CRIT_EXIT_(e);
+            return poolNum;
+        }
+    }
+    else {
+        QF_EVT_CRIT_EXIT_(e);
+        return 0U; // immutable event, never garbage
+    }
+}
 
-            // call port-specific operation to put the event to a given pool
-            // NOTE: casting 'const' away is legit because 'e' is a pool event
+//............................................................................
+void gc(QEvt const * const e) noexcept {
+    std::uint_fast8_t const poolNum = release_(e);
+    if (poolNum != 0U) { // is the event garbage?
+        // call port-specific operation to put the event to a given pool
+        // NOTE: casting 'const' away is legit because 'e' is a pool event
 #ifdef Q_SPY
-            QF_EPOOL_PUT_(priv_.ePool_[poolNum - 1U],
-                const_cast<QEvt*>(e),
-                static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum);
+        QF_EPOOL_PUT_(priv_.ePool_[poolNum - 1U],
+            const_cast<QEvt*>(e),
+            static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum);
 #else
-            QF_EPOOL_PUT_(priv_.ePool_[poolNum - 1U],
-                const_cast<QEvt*>(e), 0U);
+        QF_EPOOL_PUT_(priv_.ePool_[poolNum - 1U],
+            const_cast<QEvt*>(e), 0U);
 #endif
+    }
+}
+
+#ifdef QF_DISPATCH_QUOTA
+//............................................................................
+void gcBatch_(
+    QEvt const * const * const evts,
+    std::uint_fast16_t const n) noexcept
+{
+    // the batch must be in range
+    Q_REQUIRE_LOCAL(760, n <= QF_DISPATCH_QUOTA);
+
+    // release all events first and collect the garbage ones
+    void *garbage[QF_DISPATCH_QUOTA];
+    std::uint8_t poolOf[QF_DISPATCH_QUOTA];
+    std::uint_fast16_t nGarbage = 0U;
+    for (std::uint_fast16_t i = 0U; i < n; ++i) {
+        std::uint_fast8_t const poolNum = release_(evts[i]);
+        if (poolNum != 0U) { // is the event garbage?
+            // NOTE: casting 'const' away is legit for a pool event
+            garbage[nGarbage] = const_cast<QEvt *>(evts[i]);
+            poolOf[nGarbage]  = static_cast<std::uint8_t>(poolNum);
+            ++nGarbage;
         }
     }
-    else {
-        QF_CRIT_EXIT();
+
+    // recycle the garbage events in one batch per event pool
+    while (nGarbage > 0U) {
+        std::uint_fast8_t const poolNum = poolOf[0];
+        void *blocks[QF_DISPATCH_QUOTA];
+        std::uint_fast16_t nBlocks = 0U;
+        std::uint_fast16_t nLeft = 0U;
+        for (std::uint_fast16_t i = 0U; i < nGarbage; ++i) {
+            if (poolOf[i] == poolNum) {
+                blocks[nBlocks] = garbage[i];
+                ++nBlocks;
+            }
+            else { // keep for the next pass
+                garbage[nLeft] = garbage[i];
+                poolOf[nLeft]  = poolOf[i];
+                ++nLeft;
+            }
+        }
+#ifdef Q_SPY
+        QF_EPOOL_PUT_BATCH_(priv_.ePool_[poolNum - 1U], &blocks[0], nBlocks,
+            static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum);
+#else
+        QF_EPOOL_PUT_BATCH_(priv_.ePool_[poolNum - 1U], &blocks[0], nBlocks,
+            0U);
+#endif
+        nGarbage = nLeft;
     }
 }
+#endif // def QF_DISPATCH_QUOTA
 
 //............................................................................
 QEvt const * newRef_(
@@ -342,24 +588,24 @@ QEvt const * newRef_(
 #endif
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_EVT_CRIT_ENTRY_(e);
 
     // the referenced event must be valid
-    Q_REQUIRE_INCRIT(800, e != nullptr);
+    Q_REQUIRE_EVT_(800, e != nullptr);
 
     // the event reference count must not exceed the number of AOs
     // in the system plus each AO possibly holding one event reference
-    Q_REQUIRE_INCRIT(820, e->refCtr_ < (2U * QF_MAX_ACTIVE));
+    Q_REQUIRE_EVT_(820, e->refCtr_ < (2U * QF_MAX_ACTIVE));
 
     // the event ref must be valid
-    Q_REQUIRE_INCRIT(830, evtRef == nullptr);
+    Q_REQUIRE_EVT_(830, evtRef == nullptr);
 
     std::uint_fast8_t const poolNum = e->poolNum_;
 
     // the referenced event must be a pool event (not an immutable event)
-    Q_ASSERT_INCRIT(840, poolNum != 0U);
+    Q_ASSERT_EVT_(840, poolNum != 0U);
 
-    QEvt_refCtr_inc_(e); // increments the ref counter
+    QEvt_refCtr_incEvt_(e); // increments the ref counter
 
     QS_BEGIN_PRE(QS_QF_NEW_REF,
             static_cast<std::uint_fast8_t>(QS_ID_EP) + poolNum)
@@ -368,7 +614,7 @@ QEvt const * newRef_(
         QS_2U8_PRE(poolNum, e->refCtr_);
     QS_END_PRE()
 
-    QF_CRIT_EXIT();
+    QF_EVT_CRIT_EXIT_(e);
     Q_UNUSED_PAR(poolNum); // might be unused
 
     return e;
@@ -377,12 +623,12 @@ QEvt const * newRef_(
 //............................................................................
 void deleteRef_(QEvt const * const evtRef) noexcept {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_EVT_CRIT_ENTRY_(evtRef);
 
     QEvt const * const e = evtRef;
 
     // the referenced event must be valid
-    Q_REQUIRE_INCRIT(900, e != nullptr);
+    Q_REQUIRE_EVT_(900, e != nullptr);
 
 #ifdef Q_SPY
     std::uint8_t const poolNum = e->poolNum_;
@@ -395,7 +641,7 @@ void deleteRef_(QEvt const * const evtRef) noexcept {
     QS_END_PRE()
 #endif // def Q_SPY
 
-    QF_CRIT_EXIT();
+    QF_EVT_CRIT_EXIT_(evtRef);
 
 #if (QF_MAX_EPOOL > 0U)
     gc(e); // recycle the referenced event
@@ -406,3 +652,21 @@ void deleteRef_(QEvt const * const evtRef) noexcept {
 } // namespace QP
 
 #endif // (QF_MAX_EPOOL > 0U) mutable events configured
+
+//============================================================================
+// NOTE1:
+// With QF_EPOOL_LUT_SIZE defined in "qp_config.hpp", the event pool for
+// a given event size is found in constant time by the size-class lookup
+// table QF::priv_.poolLut_[] instead of scanning the pools. The size class
+// of an event is its size rounded up to QF_EPOOL_LUT_GRANULE bytes, and
+// the table maps every size class to the smallest pool whose blocks fit
+// it (events larger than the table covers still use the scan). The table
+// is filled by QF::poolInit(), which must be called for all pools before
+// the first event allocation, so the allocations read the table without
+// a critical section. For the q_new<evtT_>() template, the size class is
+// resolved at compile time from sizeof(evtT_) (QF::newClassX_()).
+//
+// Block sizes that are multiples of QF_EPOOL_LUT_GRANULE are mapped
+// exactly. Other block sizes are still safe, but some events that would
+// fit in such a pool are allocated from the next larger pool.
+//
@@ -61,7 +61,7 @@ void QMPool::init(
     std::uint_fast16_t const blockSize) noexcept
 {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_MEM_CRIT_ENTRY_(this);
 
     // the pool storage must be provided
     Q_REQUIRE_INCRIT(100, poolSto != nullptr);
@@ -114,7 +114,7 @@ void QMPool::init(
     pfb[1] = pfb[0]; // update Duplicate Storage (NOT inverted)
 #endif
 
-    QF_CRIT_EXIT();
+    QF_MEM_CRIT_EXIT_(this);
 }
 
 //............................................................................
@@ -122,13 +122,112 @@ void * QMPool::get(
     std::uint_fast16_t const margin,
     std::uint_fast8_t const qsId) noexcept
 {
+    QF_CRIT_STAT
+    QF_MEM_CRIT_ENTRY_(this);
+
+    void * const block = get_(margin, qsId);
+
+    QF_MEM_CRIT_EXIT_(this);
+
+    return block; // return the block or nullptr
+}
+
+//............................................................................
+void QMPool::put(
+    void * const block,
+    std::uint_fast8_t const qsId) noexcept
+{
+    QF_CRIT_STAT
+    QF_MEM_CRIT_ENTRY_(this);
+
+    put_(block, qsId);
+
+    QF_MEM_CRIT_EXIT_(this);
+}
+
+//............................................................................
+template<typename T_>
+std::uint_fast16_t QMPool::getBatch(
+    T_ * * const blocks,
+    std::uint_fast16_t const n,
+    std::uint_fast16_t const margin,
+    std::uint_fast8_t const qsId) noexcept
+{
+    QF_CRIT_STAT
+    QF_MEM_CRIT_ENTRY_(this);
+
+    // the storage for the blocks must be provided
+    Q_REQUIRE_INCRIT(500, (blocks != nullptr) || (n == 0U));
+
+    // all n blocks or none, see NOTE2
+    std::uint_fast16_t nGot = 0U;
+    if (static_cast<std::uint_fast32_t>(m_nFree)
+        >= (static_cast<std::uint_fast32_t>(n) + margin))
+    {
+        for (; nGot < n; ++nGot) {
+            // cannot fail, because the number of free blocks was checked
+            blocks[nGot] = static_cast<T_ *>(get_(0U, qsId));
+        }
+    }
+    else if (n != 0U) { // not enough free blocks above the margin
+        QS_BEGIN_PRE(QS_QF_MPOOL_GET_ATTEMPT, qsId)
+            QS_TIME_PRE();         // timestamp
+            QS_OBJ_PRE(this);      // this memory pool
+            QS_MPC_PRE(m_nFree);   // # free blocks in the pool
+            QS_MPC_PRE(margin);    // the requested margin
+        QS_END_PRE()
+    }
+    else {
+        // nothing to get
+    }
+
+    QF_MEM_CRIT_EXIT_(this);
+
+    return nGot; // n or 0
+}
+
+// the only instantiations of QMPool::getBatch()
+template std::uint_fast16_t QMPool::getBatch<void>(
+    void * * const blocks,
+    std::uint_fast16_t const n,
+    std::uint_fast16_t const margin,
+    std::uint_fast8_t const qsId) noexcept;
+template std::uint_fast16_t QMPool::getBatch<QEvt>(
+    QEvt * * const blocks,
+    std::uint_fast16_t const n,
+    std::uint_fast16_t const margin,
+    std::uint_fast8_t const qsId) noexcept;
+
+//............................................................................
+void QMPool::putBatch(
+    void * const * const blocks,
+    std::uint_fast16_t const n,
+    std::uint_fast8_t const qsId) noexcept
+{
+    QF_CRIT_STAT
+    QF_MEM_CRIT_ENTRY_(this);
+
+    // the blocks to return must be provided
+    Q_REQUIRE_INCRIT(600, (blocks != nullptr) || (n == 0U));
+
+    // return all n blocks in a single critical section
+    for (std::uint_fast16_t i = 0U; i < n; ++i) {
+        put_(blocks[i], qsId);
+    }
+
+    QF_MEM_CRIT_EXIT_(this);
+}
+
+//............................................................................
+void * QMPool::get_(
+    std::uint_fast16_t const margin,
+    std::uint_fast8_t const qsId) noexcept
+{
+    // NOTE: this helper function is called *inside* critical section
 #ifndef Q_SPY
     Q_UNUSED_PAR(qsId);
 #endif
 
-    QF_CRIT_STAT
-    QF_CRIT_ENTRY();
-
     // get members into temporaries
     void * *pfb     = m_freeHead; // pointer to free block
     QMPoolCtr nFree = m_nFree;    // get member into temporary
@@ -191,25 +290,21 @@ void * QMPool::get(
         QS_END_PRE()
     }
 
-    QF_CRIT_EXIT();
-
     return static_cast<void *>(pfb); // return the block or nullptr
 }
 
 //............................................................................
-void QMPool::put(
+void QMPool::put_(
     void * const block,
     std::uint_fast8_t const qsId) noexcept
 {
+    // NOTE: this helper function is called *inside* critical section
 #ifndef Q_SPY
     Q_UNUSED_PAR(qsId);
 #endif
 
     void * * const pfb = static_cast<void * *>(block); // ptr to free block
 
-    QF_CRIT_STAT
-    QF_CRIT_ENTRY();
-
     // the block returned to the pool must be valid
     Q_REQUIRE_INCRIT(400, pfb != nullptr);
 
@@ -243,8 +338,6 @@ void QMPool::put(
         QS_OBJ_PRE(this);      // this memory pool
         QS_MPC_PRE(nFree);     // the # free blocks in the pool
     QS_END_PRE()
-
-    QF_CRIT_EXIT();
 }
 
 //............................................................................
@@ -282,3 +375,11 @@ QMPoolSize QMPool::getBlockSize() const noexcept {
 // The second location pfb[1] is used in SafeQP as the redundant Duplicate
 // Storage (NOT inverted) for the link at pfb[0]. Therefore, the minimum
 // number of void* pointers (void * data type) inside a memory block is 2.
+//
+// NOTE2:
+// QMPool::getBatch() is all-or-nothing: it checks the number of free blocks
+// against n + margin once, before taking any block, so a failed batch
+// allocation does not disturb the pool (the minimum of free blocks or the
+// QS trace) with blocks that would have to be returned again. The blocks
+// are stored with the type of the caller's array (void* or QEvt*), so the
+// array is never accessed through a pointer of a different type.
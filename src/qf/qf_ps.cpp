@@ -84,7 +84,7 @@ void QActive::publish_(
 #endif
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_PS_CRIT_ENTRY_();
 
     // the published event must be valid
     Q_REQUIRE_INCRIT(200, e != nullptr);
@@ -111,10 +111,12 @@ void QActive::publish_(
         // end of the function decrements the reference counter and recycles
         // the event if the counter drops to zero. This covers the case when
         // event was published without any subscribers.
+        QF_EVT_LOCK_(e);
         QEvt_refCtr_inc_(e);
+        QF_EVT_UNLOCK_(e);
     }
 
-    QF_CRIT_EXIT();
+    QF_PS_CRIT_EXIT_();
 
     if (subscrSet.notEmpty()) { // any subscribers?
         multicast_(&subscrSet, e, sender); // multicast to all
@@ -139,7 +141,7 @@ void QActive::multicast_(
 #endif
 
     // highest-prio subscriber ('subscrSet' guaranteed to be NOT empty)
-    std::uint8_t p = static_cast<std::uint8_t>(subscrSet->findMax());
+    QPrio p = static_cast<QPrio>(subscrSet->findMax());
 
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
@@ -171,7 +173,7 @@ void QActive::multicast_(
         }
 
         // find the next highest-prio subscriber
-        p = static_cast<std::uint8_t>(subscrSet->findMax());
+        p = static_cast<QPrio>(subscrSet->findMax());
 
         QF_CRIT_ENTRY();
 
@@ -189,9 +191,9 @@ void QActive::multicast_(
 //............................................................................
 void QActive::subscribe(QSignal const sig) const noexcept {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_PS_CRIT_ENTRY_();
 
-    std::uint8_t const p = m_prio;
+    QPrio const p = m_prio;
 
     // the AO's prio. must be in range
     Q_REQUIRE_INCRIT(420, (0U < p) && (p <= QF_MAX_ACTIVE));
@@ -214,15 +216,15 @@ void QActive::subscribe(QSignal const sig) const noexcept {
     // insert the AO's prio. into the subscriber set for the signal
     QActive_subscrList_[sig].m_set.insert(p);
 
-    QF_CRIT_EXIT();
+    QF_PS_CRIT_EXIT_();
 }
 
 //............................................................................
 void QActive::unsubscribe(QSignal const sig) const noexcept {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_PS_CRIT_ENTRY_();
 
-    std::uint8_t const p = m_prio;
+    QPrio const p = m_prio;
 
     // the AO's prio. must be in range
     Q_REQUIRE_INCRIT(520, (0U < p) && (p <= QF_MAX_ACTIVE));
@@ -243,15 +245,15 @@ void QActive::unsubscribe(QSignal const sig) const noexcept {
     // remove the AO's prio. from the subscriber set for the signal
     QActive_subscrList_[sig].m_set.remove(p);
 
-    QF_CRIT_EXIT();
+    QF_PS_CRIT_EXIT_();
 }
 
 //............................................................................
 void QActive::unsubscribeAll() const noexcept {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_PS_CRIT_ENTRY_();
 
-    std::uint8_t const p = m_prio;
+    QPrio const p = m_prio;
 
     // the AO's prio. must be in range
     Q_REQUIRE_INCRIT(620, (0U < p) && (p <= QF_MAX_ACTIVE));
@@ -264,14 +266,14 @@ void QActive::unsubscribeAll() const noexcept {
     // the maximum of published signals must not overlap the reserved signals
     Q_REQUIRE_INCRIT(670, maxPubSig >= static_cast<QSignal>(Q_USER_SIG));
 
-    QF_CRIT_EXIT();
+    QF_PS_CRIT_EXIT_();
 
     // remove this AO's prio. from subscriber lists of all published signals
     for (QSignal sig = static_cast<QSignal>(Q_USER_SIG);
          sig < maxPubSig;
          ++sig)
     {
-        QF_CRIT_ENTRY();
+        QF_PS_CRIT_ENTRY_();
 
         if (QActive_subscrList_[sig].m_set.hasElement(p)) {
             // remove the AO's prio. from the subscriber set for the signal
@@ -283,7 +285,7 @@ void QActive::unsubscribeAll() const noexcept {
                 QS_OBJ_PRE(this); // this active object
             QS_END_PRE()
         }
-        QF_CRIT_EXIT();
+        QF_PS_CRIT_EXIT_();
 
         QF_CRIT_EXIT_NOP(); // prevent merging critical sections
     }
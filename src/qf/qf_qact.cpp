@@ -62,6 +62,9 @@ QActive::QActive(QStateHandler const initial) noexcept
     // so the following initiaization is identical as in QHsm ctor:
     m_state.fun = Q_STATE_CAST(&top);
     m_temp.fun  = initial;
+#ifdef QACTIVE_STATIC_DISPATCH
+    m_dispatch  = &dispatchVirtual_; // unless bound by QActiveCRTP
+#endif
 }
 
 //............................................................................
@@ -83,16 +86,16 @@ void QActive::register_() noexcept {
     Q_REQUIRE_INCRIT(130, m_prio <= m_pthre);
 
 #ifndef Q_UNSAFE
-    std::uint8_t prev_thre = m_pthre;
-    std::uint8_t next_thre = m_pthre;
+    QPrio prev_thre = m_pthre;
+    QPrio next_thre = m_pthre;
 
-    for (std::uint8_t p = m_prio - 1U; p > 0U; --p) {
+    for (QPrio p = m_prio - 1U; p > 0U; --p) {
         if (QActive_registry_[p] != nullptr) {
             prev_thre = QActive_registry_[p]->m_pthre;
             break;
         }
     }
-    for (std::uint8_t p = m_prio + 1U; p <= QF_MAX_ACTIVE; ++p) {
+    for (QPrio p = m_prio + 1U; p <= QF_MAX_ACTIVE; ++p) {
         if (QActive_registry_[p] != nullptr) {
             next_thre = QActive_registry_[p]->m_pthre;
             break;
@@ -117,7 +120,7 @@ void QActive::unregister_() noexcept {
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
 
-    std::uint8_t const p = m_prio; // put AO's prio. in a temporary
+    QPrio const p = m_prio; // put AO's prio. in a temporary
 
     // AO's prio. must be in range
     Q_REQUIRE_INCRIT(210, (0U < p) && (p <= QF_MAX_ACTIVE));
@@ -156,8 +159,25 @@ QStateHandler QActive::childState(QStateHandler const parentHandler) noexcept {
     // delegate to the QHsm class
     return reinterpret_cast<QHsm *>(this)->QHsm::childState(parentHandler);
 }
+#ifdef QHSM_SIG_TABLES
 //............................................................................
-QActive* QActive::fromRegistry(std::uint_fast8_t const prio) {
+void QActive::addSigTable(QSigTable const * const tbl) noexcept {
+    // delegate to the QHsm class
+    reinterpret_cast<QHsm *>(this)->QHsm::addSigTable(tbl);
+}
+#endif // def QHSM_SIG_TABLES
+#ifdef QACTIVE_STATIC_DISPATCH
+//............................................................................
+void QActive::dispatchVirtual_(QActive * const act,
+    QEvt const * const * const evts, std::uint_fast16_t const n)
+{
+    for (std::uint_fast16_t i = 0U; i < n; ++i) {
+        act->dispatch(evts[i], act->m_prio); // virtual call
+    }
+}
+#endif // def QACTIVE_STATIC_DISPATCH
+//............................................................................
+QActive* QActive::fromRegistry(QPrio const prio) {
     // return the hidden (package scope) registry entry
     return QActive_registry_[prio];
 }
@@ -204,6 +224,8 @@ std::uint_fast8_t QF_LOG2(QP::QPSetBits const bitmask) noexcept {
 #endif // ndef QF_LOG2
 
 //----------------------------------------------------------------------------
+#if (QF_MAX_ACTIVE <= 64U)
+
 void QPSet::setEmpty() noexcept {
     m_bits0 = 0U; // clear bitmask for elements 1..32
 #if (QF_MAX_ACTIVE > 32U)
@@ -281,4 +303,81 @@ std::uint_fast8_t QPSet::findMax() const noexcept {
 #endif
 }
 
+#else // hierarchical QPSet for more than 64 elements, see NOTE1
+
+//............................................................................
+void QPSet::setEmpty() noexcept {
+    m_summary = 0U; // no leaf bitmask is in use
+    for (std::uint_fast8_t k = 0U; k < QPSET_LEAVES; ++k) {
+        m_leaf[k] = 0U;
+    }
+}
+//............................................................................
+bool QPSet::isEmpty() const noexcept {
+    return (m_summary == 0U); // the summary covers all leaves
+}
+//............................................................................
+bool QPSet::notEmpty() const noexcept {
+    return (m_summary != 0U); // the summary covers all leaves
+}
+//............................................................................
+bool QPSet::hasElement(std::uint_fast16_t const n) const noexcept {
+    return (m_leaf[(n - 1U) >> 5U]
+            & (static_cast<QPSetBits>(1U) << ((n - 1U) & 0x1FU))) != 0U;
+}
+//............................................................................
+void QPSet::insert(std::uint_fast16_t const n) noexcept {
+    std::uint_fast8_t const k = static_cast<std::uint_fast8_t>((n - 1U) >> 5U);
+    m_leaf[k] = (m_leaf[k]
+                 | (static_cast<QPSetBits>(1U) << ((n - 1U) & 0x1FU)));
+    m_summary = (m_summary | (static_cast<QPSetBits>(1U) << k));
+}
+//............................................................................
+void QPSet::remove(std::uint_fast16_t const n) noexcept {
+    std::uint_fast8_t const k = static_cast<std::uint_fast8_t>((n - 1U) >> 5U);
+    m_leaf[k] = (m_leaf[k]
+                 & ~(static_cast<QPSetBits>(1U) << ((n - 1U) & 0x1FU)));
+    if (m_leaf[k] == 0U) { // the leaf became empty?
+        m_summary = (m_summary & ~(static_cast<QPSetBits>(1U) << k));
+    }
+}
+//............................................................................
+std::uint_fast16_t QPSet::findMax() const noexcept {
+    // NOTE: the set must not be empty (the same as for QPSet <= 64)
+    std::uint_fast8_t const k =
+        static_cast<std::uint_fast8_t>(QF_LOG2(m_summary) - 1U);
+    return static_cast<std::uint_fast16_t>(
+        (static_cast<std::uint_fast16_t>(k) << 5U) + QF_LOG2(m_leaf[k]));
+}
+
+#endif // (QF_MAX_ACTIVE > 64U)
+
 } // namespace QP
+
+//============================================================================
+// NOTE1:
+// For QF_MAX_ACTIVE above 64, QPSet is a two-level bitmap: up to 32 leaf
+// bitmasks of 32 elements each and a single summary bitmask, in which bit
+// k-1 is set when the leaf k-1 holds at least one element. Insertion and
+// removal touch one leaf and the summary, and findMax() takes just two
+// QF_LOG2() operations (count-leading-zeros on CPUs that provide it),
+// regardless of the number of elements (up to 1024).
+//
+// NOTE2:
+// With QACTIVE_STATIC_DISPATCH, the kernels and ports hand the events to
+// an AO through the per-AO dispatch handler m_dispatch (a whole batch of
+// events at a time with QF_DISPATCH_QUOTA) instead of the virtual call
+// QAsm::dispatch() per event. By default, the handler is dispatchVirtual_(),
+// which just makes the virtual calls. An AO derived from QActiveCRTP<AO_>
+// (or QTActive<AO_> from "qtsm.hpp") binds the handler dispatchStatic_<AO_>,
+// which calls AO_::dispatch() non-virtually, so that the compiler can
+// inline the state machine into the dispatch loop.
+//
+// The gain depends on AO_::dispatch() being visible to the compiler. For
+// QTActive<AO_>, dispatch() is a template defined inline in "qtsm.hpp",
+// so the whole state machine can be inlined. For a plain QHsm/QMsm AO, the
+// non-virtual call still ends in the out-of-line QHsm/QMsm::dispatch(), so
+// the only saving is the vtable load per event, which is lost in the
+// noise. QActiveCRTP<AO_> therefore static_asserts that AO_ declares its
+// own dispatch(), and such AOs should keep the default dispatchVirtual_().
+//
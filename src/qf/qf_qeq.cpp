@@ -107,7 +107,9 @@ bool QEQueue::post(
 
 #if (QF_MAX_EPOOL > 0U)
         if (e->poolNum_ != 0U) { // is it a mutable event?
+            QF_EVT_LOCK_(e);
             QEvt_refCtr_inc_(e); // increment the reference counter
+            QF_EVT_UNLOCK_(e);
         }
 #endif // (QF_MAX_EPOOL > 0U)
 
@@ -181,7 +183,9 @@ void QEQueue::postLIFO(
     Q_REQUIRE_INCRIT(230, nFree != 0U);
 
     if (e->poolNum_ != 0U) { // is it a mutable event?
+        QF_EVT_LOCK_(e);
         QEvt_refCtr_inc_(e); // increment the reference counter
+        QF_EVT_UNLOCK_(e);
     }
 
     --nFree; // one free entry just used up
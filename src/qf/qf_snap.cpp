@@ -0,0 +1,493 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#define QP_IMPL             // this is QP implementation
+#include "qp_port.hpp"      // QP port
+#include "qp_pkg.hpp"       // QP package-scope interface
+#include "qsafe.h"          // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY                // QS software tracing enabled?
+    #include "qs_port.hpp"  // QS port
+    #include "qs_pkg.hpp"   // QS facilities for pre-defined trace records
+#else
+    #include "qs_dummy.hpp" // disable the QS software tracing
+#endif // Q_SPY
+
+#ifdef QACTIVE_SNAPSHOT
+
+#include <cstring>          // std::memcpy()
+
+//============================================================================
+// unnamed namespace for local definitions with internal linkage
+namespace {
+Q_DEFINE_THIS_MODULE("qf_snap")
+
+// snapshot format identifier ('QSN1')
+constexpr std::uint32_t SNAP_MAGIC {0x51534E31U};
+
+// static event not identified by any time event te[] passed by the caller
+constexpr std::uint8_t SNAP_NO_TE {0xFFU};
+
+// size of the stored time event (counter and interval)
+constexpr std::size_t TE_SIZE {2U * sizeof(std::uint32_t)};
+
+//............................................................................
+// reference point for the addresses of the state handlers, state objects
+// and static events, which are stored as offsets, see NOTE1
+std::uintptr_t snapAnchor() noexcept {
+    return reinterpret_cast<std::uintptr_t>(&QP::QAsm::top);
+}
+//............................................................................
+// identifier of the executable image (distance between code and data)
+std::uint32_t snapImageId() noexcept {
+    return static_cast<std::uint32_t>(
+        reinterpret_cast<std::uintptr_t>(&QP::QF::priv_) - snapAnchor());
+}
+
+//............................................................................
+// sequential writer into the snapshot buffer
+class SnapOut {
+public:
+    SnapOut(std::uint8_t * const buf, std::size_t const size) noexcept
+      : m_buf(buf), m_size(size), m_len(0U), m_ok(true)
+    {}
+    void put(void const * const src, std::size_t const n) noexcept {
+        if (m_ok && (n <= (m_size - m_len))) {
+            std::memcpy(&m_buf[m_len], src, n);
+            m_len += n;
+        }
+        else {
+            m_ok = false; // the buffer is too small
+        }
+    }
+    template<typename T_>
+    void put(T_ const v) noexcept {
+        put(&v, sizeof(v));
+    }
+    std::uint8_t *cursor() noexcept {
+        return &m_buf[m_len];
+    }
+    std::size_t room() const noexcept {
+        return m_ok ? (m_size - m_len) : 0U;
+    }
+    void skip(std::size_t const n) noexcept {
+        if (n <= room()) {
+            m_len += n;
+        }
+        else {
+            m_ok = false;
+        }
+    }
+    std::size_t len() const noexcept {
+        return m_ok ? m_len : 0U;
+    }
+private:
+    std::uint8_t * const m_buf;
+    std::size_t const m_size;
+    std::size_t m_len;
+    bool m_ok;
+};
+
+//............................................................................
+// sequential reader of the snapshot buffer
+class SnapIn {
+public:
+    SnapIn(std::uint8_t const * const buf, std::size_t const len) noexcept
+      : m_buf(buf), m_len(len), m_pos(0U), m_ok(true)
+    {}
+    void get(void * const dst, std::size_t const n) noexcept {
+        if (m_ok && (n <= (m_len - m_pos))) {
+            std::memcpy(dst, &m_buf[m_pos], n);
+            m_pos += n;
+        }
+        else {
+            m_ok = false; // truncated snapshot
+        }
+    }
+    template<typename T_>
+    T_ get() noexcept {
+        T_ v {};
+        get(&v, sizeof(v));
+        return v;
+    }
+    std::uint8_t const *skip(std::size_t const n) noexcept {
+        std::uint8_t const * const p = &m_buf[m_pos];
+        if (m_ok && (n <= (m_len - m_pos))) {
+            m_pos += n;
+        }
+        else {
+            m_ok = false;
+        }
+        return p;
+    }
+    bool atEnd() const noexcept {
+        return m_ok && (m_pos == m_len);
+    }
+private:
+    std::uint8_t const * const m_buf;
+    std::size_t const m_len;
+    std::size_t m_pos;
+    bool m_ok;
+};
+
+//............................................................................
+// size of the parameters of the events allocated from the pool poolNum
+std::size_t snapParSize(std::uint_fast8_t const poolNum) noexcept {
+#if (QF_MAX_EPOOL > 0U)
+    return static_cast<std::size_t>(
+        QF_EPOOL_EVENT_SIZE_(QP::QF::priv_.ePool_[poolNum - 1U]))
+        - sizeof(QP::QEvt);
+#else
+    Q_UNUSED_PAR(poolNum);
+    return 0U;
+#endif
+}
+
+} // unnamed namespace
+
+//============================================================================
+namespace QP {
+
+//............................................................................
+std::size_t QActive::snapshot(
+    std::uint8_t * const buf,
+    std::size_t const size,
+    QTimeEvt const * const * const te,
+    std::uint_fast8_t const nTe) noexcept
+{
+    Q_REQUIRE_LOCAL(100, (buf != nullptr)
+        && ((nTe == 0U) || (te != nullptr)));
+
+    SnapOut out(buf, size);
+    out.put(SNAP_MAGIC);
+    out.put(static_cast<std::uint32_t>(0U)); // length (updated at the end)
+    out.put(snapImageId());
+
+    // the current state (called from the AO thread, see NOTE2)
+    out.put(static_cast<std::uint64_t>(m_state.uint - snapAnchor()));
+
+    // the extended state provided by the subclass
+    std::uint8_t * const extLenPtr = out.cursor();
+    out.skip(sizeof(std::uint16_t));
+    std::size_t const room = out.room();
+    std::size_t const extLen = snapshotExt(out.cursor(), room);
+    if ((extLen <= room) && (extLen <= 0xFFFFU)) {
+        out.skip(extLen);
+    }
+    else {
+        out.skip(room + 1U); // the buffer is too small
+    }
+
+    // the time events of this AO
+    out.put(static_cast<std::uint8_t>(nTe));
+    for (std::uint_fast8_t i = 0U; i < nTe; ++i) {
+        // the time events must belong to this AO
+        Q_REQUIRE_LOCAL(110, te[i]->getAct() == this);
+#ifdef QF_TIMEEVT_TICKLESS
+        if (QTickless::isDeadline(*te[i])) { // not in ticks? (NOTE2)
+            return 0U; // cannot be captured
+        }
+#endif
+        out.put(static_cast<std::uint32_t>(te[i]->getCtr()));
+        out.put(static_cast<std::uint32_t>(te[i]->getInterval()));
+    }
+
+    // the events in the queue (in the order of retrieval)
+    std::uint8_t * const nEvtPtr = out.cursor();
+    out.skip(sizeof(std::uint16_t));
+    std::uint16_t nEvt = 0U;
+
+    QF_CRIT_STAT
+    QACTIVE_EQUEUE_CRIT_ENTRY_(this);
+
+#ifndef QACTIVE_EQUEUE_MPSC
+    std::uint_fast16_t nUse = 0U;
+    if (m_eQueue.m_frontEvt.e != nullptr) { // not empty?
+        nUse = static_cast<std::uint_fast16_t>(
+            (m_eQueue.m_end + 1U) - m_eQueue.m_nFree);
+    }
+    QEQueueCtr idx = m_eQueue.m_tail;
+#else
+    std::uint_fast16_t const nUse = m_eQueue.getUse();
+    QEQueueCtr idx = m_eQueue.m_head;
+#endif
+    for (std::uint_fast16_t k = 0U; k < nUse; ++k) {
+        QEvt const *e;
+#ifndef QACTIVE_EQUEUE_MPSC
+        if (k == 0U) {
+            e = m_eQueue.m_frontEvt.e;
+        }
+        else {
+            e = m_eQueue.m_ring[idx].e;
+            idx = (idx == 0U) ? m_eQueue.m_end : idx;
+            --idx; // counter-clockwise (see QActive::get_())
+        }
+#else
+        QEvtPtr * const slot = m_eQueue.slot_(idx);
+        e = __atomic_load_n(&slot->e, __ATOMIC_ACQUIRE);
+        if (e == nullptr) { // slot reserved, but not published yet?
+            break; // the post has not completed yet (NOTE2)
+        }
+        if (m_eQueue.m_end != 0U) {
+            idx = (idx < m_eQueue.m_end) ? static_cast<QEQueueCtr>(idx + 1U)
+                                         : 0U;
+        }
+#endif
+        out.put(static_cast<std::uint16_t>(e->sig));
+        std::uint8_t const poolNum = static_cast<std::uint8_t>(e->poolNum_);
+        out.put(poolNum);
+        if (poolNum != 0U) { // dynamic event? store the parameters
+            std::size_t const parSize = snapParSize(poolNum);
+            out.put(static_cast<std::uint16_t>(parSize));
+            out.put(reinterpret_cast<std::uint8_t const *>(e)
+                    + sizeof(QEvt), parSize);
+        }
+        else { // static event (e.g., one of the time events te[])
+            std::uint8_t i = 0U;
+            while ((i < nTe) && (static_cast<QEvt const *>(te[i]) != e)) {
+                ++i;
+            }
+            if (i < nTe) {
+                out.put(i);
+            }
+            else {
+                out.put(SNAP_NO_TE);
+                out.put(static_cast<std::uint64_t>(
+                    reinterpret_cast<std::uintptr_t>(e) - snapAnchor()));
+            }
+        }
+        ++nEvt;
+    }
+
+    QACTIVE_EQUEUE_CRIT_EXIT_(this);
+
+    std::size_t const len = out.len();
+    if (len != 0U) { // snapshot complete?
+        std::uint16_t const extLen16 = static_cast<std::uint16_t>(extLen);
+        std::memcpy(extLenPtr, &extLen16, sizeof(extLen16));
+        std::memcpy(nEvtPtr, &nEvt, sizeof(nEvt));
+        std::uint32_t const len32 = static_cast<std::uint32_t>(len);
+        std::memcpy(&buf[sizeof(SNAP_MAGIC)], &len32, sizeof(len32));
+    }
+    return len;
+}
+
+//............................................................................
+bool QActive::restore(
+    std::uint8_t const * const buf,
+    std::size_t const len,
+    QTimeEvt * const * const te,
+    std::uint_fast8_t const nTe) noexcept
+{
+    Q_REQUIRE_LOCAL(200, (buf != nullptr)
+        && ((nTe == 0U) || (te != nullptr)));
+    // the AO must not run and its queue must be empty, see NOTE3
+    Q_REQUIRE_LOCAL(210, m_eQueue.isEmpty());
+
+    // validate the whole snapshot before changing anything...
+    SnapIn in(buf, len);
+    bool ok = (in.get<std::uint32_t>() == SNAP_MAGIC)
+              && (in.get<std::uint32_t>() == len)
+              && (in.get<std::uint32_t>() == snapImageId());
+    std::uint64_t const stateOff = in.get<std::uint64_t>();
+    std::uint16_t const extLen = in.get<std::uint16_t>();
+    std::uint8_t const * const ext = in.skip(extLen);
+    ok = ok && (in.get<std::uint8_t>() == nTe);
+    std::uint8_t const * const tes = in.skip(nTe * TE_SIZE);
+    std::uint16_t const nEvt = in.get<std::uint16_t>();
+    std::uint8_t const * const evts = in.skip(0U);
+#if (QF_MAX_EPOOL > 0U)
+    std::array<std::uint_fast16_t, QF_MAX_EPOOL> nNew {}; // # evts per pool
+#endif
+    for (std::uint_fast16_t k = 0U; ok && (k < nEvt); ++k) {
+        static_cast<void>(in.get<std::uint16_t>()); // signal
+        std::uint8_t const poolNum = in.get<std::uint8_t>();
+        if (poolNum != 0U) { // dynamic event?
+#if (QF_MAX_EPOOL > 0U)
+            ok = (poolNum <= QF::priv_.maxPool_)
+                 && (in.get<std::uint16_t>() == snapParSize(poolNum));
+            if (ok) {
+                static_cast<void>(in.skip(snapParSize(poolNum)));
+                ++nNew[poolNum - 1U];
+            }
+#else
+            ok = false;
+#endif
+        }
+        else {
+            std::uint8_t const i = in.get<std::uint8_t>();
+            if (i == SNAP_NO_TE) {
+                static_cast<void>(in.get<std::uint64_t>());
+            }
+            else {
+                ok = (i < nTe);
+            }
+        }
+    }
+    ok = ok && in.atEnd();
+
+    // ...the queue must have room for all the events...
+    ok = ok && (nEvt <= m_eQueue.getFree());
+
+#if (QF_MAX_EPOOL > 0U) && defined(QF_EPOOL_FREE_)
+    // ...the pools must have enough free blocks...
+    for (std::uint_fast8_t p = 0U; ok && (p < QF::priv_.maxPool_); ++p) {
+        ok = (nNew[p] <= QF::getPoolFree(p + 1U));
+    }
+#endif
+
+#ifdef QF_TIMEEVT_TICKLESS
+    // ...and no time event may be armed for a deadline (NOTE2)
+    for (std::uint_fast8_t i = 0U; ok && (i < nTe); ++i) {
+        ok = !QTickless::isDeadline(*te[i]);
+    }
+#endif
+    if (!ok) {
+        return false; // nothing restored
+    }
+
+    // the events (with a margin, so a failure does not assert)...
+    SnapIn ev(evts, len - static_cast<std::size_t>(evts - buf));
+    for (std::uint_fast16_t k = 0U; ok && (k < nEvt); ++k) {
+        QSignal const sig = static_cast<QSignal>(ev.get<std::uint16_t>());
+        std::uint8_t const poolNum = ev.get<std::uint8_t>();
+        QEvt const *e;
+        if (poolNum != 0U) { // dynamic event?
+            std::size_t const parSize = ev.get<std::uint16_t>();
+            QEvt * const de = QF::newX_(
+                static_cast<std::uint_fast16_t>(parSize + sizeof(QEvt)),
+                0U, sig);
+            if (de != nullptr) {
+                ev.get(reinterpret_cast<std::uint8_t *>(de) + sizeof(QEvt),
+                       parSize);
+            }
+            else {
+                ok = false; // the pool was depleted concurrently
+            }
+            e = de;
+        }
+        else {
+            std::uint8_t const i = ev.get<std::uint8_t>();
+            if (i == SNAP_NO_TE) {
+                e = reinterpret_cast<QEvt const *>(static_cast<std::uintptr_t>(
+                    snapAnchor() + ev.get<std::uint64_t>()));
+            }
+            else {
+                e = te[i];
+            }
+        }
+        if (ok) {
+            ok = postx_(e, 0U, this); // the event is recycled on failure
+        }
+    }
+
+    // ...and the extended state provided by the subclass
+    ok = ok && restoreExt(ext, extLen);
+
+    if (!ok) { // events not re-posted or extended state rejected?
+        // recycle the re-posted events (the queue was empty, NOTE3)
+        while (!m_eQueue.isEmpty()) {
+#ifndef QACTIVE_EQUEUE_MPSC
+            QF::gc(m_eQueue.get(m_prio));
+#else
+            QEQueueCtr nFree;
+            QF::gc(m_eQueue.take_(nFree));
+#endif
+        }
+        return false; // nothing restored
+    }
+
+    // the current state...
+    m_state.uint = static_cast<std::uintptr_t>(snapAnchor() + stateOff);
+#ifndef Q_UNSAFE
+    m_temp.uint = dis_update<std::uintptr_t>(m_state.uint);
+#endif
+#ifdef QASM_ACTIVE_CONFIG
+    QActiveConfig * const cfg = activeConfig();
+    if (cfg != nullptr) {
+        cfg->len = 0U; // the cached configuration is no longer valid
+    }
+#endif
+
+    // the time events
+    SnapIn tin(tes, nTe * TE_SIZE);
+    for (std::uint_fast8_t i = 0U; i < nTe; ++i) {
+        std::uint32_t const ctr = tin.get<std::uint32_t>();
+        std::uint32_t const interval = tin.get<std::uint32_t>();
+        static_cast<void>(te[i]->disarm());
+        if (ctr != 0U) { // the time event was armed?
+            te[i]->armX(ctr, interval);
+        }
+    }
+    return true;
+}
+
+} // namespace QP
+
+//============================================================================
+// NOTE1:
+// The snapshot stores the current state and the static events as offsets
+// from the QAsm::top() function, so the snapshot can be restored by the
+// same executable image even if it is loaded at a different address
+// (ASLR). A snapshot taken by a different build is rejected by restore().
+// The static events must be allocated statically (not on the stack or in
+// the heap), except the time events passed to snapshot() and restore().
+// The dynamic events are re-allocated from the same event pools and their
+// parameters are copied by value, so they must not contain pointers.
+//
+// NOTE2:
+// QActive::snapshot() must be called in the AO's own thread, e.g., in a
+// state handler performing an internal transition, so that the state and
+// the extended state don't change during the snapshot. The events posted
+// to the AO concurrently are included only if they arrive before the
+// queue is examined. With QACTIVE_EQUEUE_MPSC, a producer can have reserved
+// a slot without publishing its event yet. The snapshot then ends at that
+// slot, as if the queue were examined just before the reservation, because
+// waiting for the producer inside the critical section could block it.
+// The time events are captured as the remaining number of ticks and the
+// interval. A time event armed for a deadline (QTimeEvt::armAt()/armIn()
+// with QF_TIMEEVT_TICKLESS) has no tick count, so snapshot() returns 0 and
+// restore() returns false when any of te[] is armed that way.
+//
+// NOTE3:
+// QActive::restore() is called after QActive::start() and before QF::run()
+// (or in general, while the AO thread doesn't run), typically right after
+// start() has taken the top-most initial transition of the AO, whose queue
+// must still be empty. The time events te[] are disarmed and re-armed with
+// the captured counters, and the captured events are re-posted to the AO.
+// The function returns false and leaves the AO unchanged if the snapshot
+// is truncated, corrupted, or does not match the AO (the number of time
+// events), if the AO's queue or the event pools don't have room for the
+// captured events, or if QAsm::restoreExt() rejects the extended state.
+// All of that is checked before anything is changed, and the events are
+// allocated and posted with a margin, so restore() never asserts on a
+// full queue or an empty pool. Should the allocation still fail (other
+// threads using the pools at the same time), the events posted so far
+// are taken back from the AO's queue and recycled.
+//
+
+#endif // QACTIVE_SNAPSHOT
@@ -47,8 +47,10 @@ Q_DEFINE_THIS_MODULE("qf_time")
 
 namespace QP {
 
+#ifndef QF_TIMEEVT_WHEEL // see qf_twheel.cpp for the timing-wheel version
 //............................................................................
 std::array<QTimeEvt, QF_MAX_TICK_RATE> QTimeEvt_head_;
+#endif
 
 //............................................................................
 QTimeEvt::QTimeEvt(
@@ -62,6 +64,15 @@ QTimeEvt::QTimeEvt(
     m_interval(0U),   // not periodic
     m_tickRate(static_cast<std::uint8_t>(tickRate)), // associated tickRate
     m_flags(0U)       // not armed
+#ifdef QF_TIMEEVT_WHEEL
+  , m_prev(nullptr),  // not linked into the timing wheel
+    m_when(0U)        // no expiration
+#endif
+#ifdef QF_TIMEEVT_TICKLESS
+  , m_deadline(0U),   // no deadline
+    m_period(0U),     // not periodic
+    m_heapIdx(0U)     // not in the deadline heap
+#endif
 {
     QF_CRIT_STAT
     QF_CRIT_ENTRY();
@@ -76,13 +87,14 @@ QTimeEvt::QTimeEvt(
     refCtr_ = 0U; // adjust from the QEvt(sig) ctor
 }
 
+#ifndef QF_TIMEEVT_WHEEL
 //............................................................................
 void QTimeEvt::armX(
     std::uint32_t const nTicks,
     std::uint32_t const interval) noexcept
 {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_TIME_CRIT_ENTRY_(m_tickRate);
 
     // nTicks and interval parameters must fit in the configured dynamic range
 #if (QF_TIMEEVT_CTR_SIZE == 1U)
@@ -113,6 +125,9 @@ void QTimeEvt::armX(
 
     m_ctr = static_cast<QTimeEvtCtr>(nTicks);
     m_interval = static_cast<QTimeEvtCtr>(interval);
+#ifdef QF_TIMEEVT_TICKLESS
+    m_flags &= static_cast<std::uint8_t>(~QTE_FLAG_IS_DEADLINE);
+#endif
 
     // is the time event unlinked?
     // NOTE: For the duration of a single clock tick of the specified tick
@@ -141,13 +156,13 @@ void QTimeEvt::armX(
         QS_U8_PRE(tickRate);  // tick rate
     QS_END_PRE()
 
-    QF_CRIT_EXIT();
+    QF_TIME_CRIT_EXIT_(m_tickRate);
 }
 
 //............................................................................
 bool QTimeEvt::disarm() noexcept {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_TIME_CRIT_ENTRY_(m_tickRate);
 
     QTimeEvtCtr const ctr = m_ctr; // get member into temporary
 
@@ -182,7 +197,7 @@ bool QTimeEvt::disarm() noexcept {
         QS_END_PRE()
     }
 
-    QF_CRIT_EXIT();
+    QF_TIME_CRIT_EXIT_(m_tickRate);
 
     return wasArmed;
 }
@@ -190,7 +205,7 @@ bool QTimeEvt::disarm() noexcept {
 //............................................................................
 bool QTimeEvt::rearm(std::uint32_t const nTicks) noexcept {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_TIME_CRIT_ENTRY_(m_tickRate);
 
     // nTicks parameter must fit in the configured dynamic range
 #if (QF_TIMEEVT_CTR_SIZE == 1U)
@@ -219,6 +234,19 @@ bool QTimeEvt::rearm(std::uint32_t const nTicks) noexcept {
 
     // was the time evt not running?
     bool wasArmed = false;
+#ifdef QF_TIMEEVT_TICKLESS
+    // a running deadline time event is not linked into the list
+    if ((m_flags & QTE_FLAG_IS_DEADLINE) != 0U) {
+        m_flags &= static_cast<std::uint8_t>(~QTE_FLAG_IS_DEADLINE);
+        wasArmed = (ctr != 0U);
+        if ((m_flags & QTE_FLAG_IS_LINKED) == 0U) {
+            m_flags |= QTE_FLAG_IS_LINKED; // mark as linked
+            m_next = QTimeEvt_head_[tickRate].toTimeEvt();
+            QTimeEvt_head_[tickRate].m_act = this;
+        }
+    }
+    else
+#endif
     if (ctr == 0U) {
         // NOTE: For the duration of a single clock tick of the specified
         // tick rate a time event can be disarmed and yet still linked into
@@ -252,26 +280,28 @@ bool QTimeEvt::rearm(std::uint32_t const nTicks) noexcept {
         QS_2U8_PRE(tickRate, (wasArmed ? 1U : 0U));
     QS_END_PRE()
 
-    QF_CRIT_EXIT();
+    QF_TIME_CRIT_EXIT_(m_tickRate);
 
     return wasArmed;
 }
+#endif // ndef QF_TIMEEVT_WHEEL
 
 //............................................................................
 bool QTimeEvt::wasDisarmed() noexcept {
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_TIME_CRIT_ENTRY_(m_tickRate);
 
     // was this time-event disarmed automatically upon expiration?
     bool const wasDisarmed = (m_flags & QTE_FLAG_WAS_DISARMED) != 0U;
 
     m_flags |= QTE_FLAG_WAS_DISARMED; // mark as disarmed (SIDE EFFECT!)
 
-    QF_CRIT_EXIT();
+    QF_TIME_CRIT_EXIT_(m_tickRate);
 
     return wasDisarmed;
 }
 
+#ifndef QF_TIMEEVT_WHEEL
 //............................................................................
 void QTimeEvt::tick(
     std::uint_fast8_t const tickRate,
@@ -282,7 +312,7 @@ void QTimeEvt::tick(
 #endif
 
     QF_CRIT_STAT
-    QF_CRIT_ENTRY();
+    QF_TIME_CRIT_ENTRY_(tickRate);
 
     // the tick rate of this time event must be in range
     Q_REQUIRE_INCRIT(800, tickRate < QF_MAX_TICK_RATE);
@@ -313,6 +343,11 @@ void QTimeEvt::tick(
         }
 
         QTimeEvtCtr ctr = te->m_ctr; // get member into temporary
+#ifdef QF_TIMEEVT_TICKLESS
+        if ((te->m_flags & QTE_FLAG_IS_DEADLINE) != 0U) {
+            ctr = 0U; // re-armed as a deadline time event, remove from list
+        }
+#endif
 
         if (ctr == 0U) { // time event scheduled for removal?
             prev->m_next = te->m_next;
@@ -320,7 +355,7 @@ void QTimeEvt::tick(
             // mark time event 'te' as NOT linked
             te->m_flags &= static_cast<std::uint8_t>(~QTE_FLAG_IS_LINKED);
             // do NOT advance the prev pointer
-            QF_CRIT_EXIT(); // exit crit. section to reduce latency
+            QF_TIME_CRIT_EXIT_(tickRate); // exit crit. section to reduce latency
         }
         else if (ctr == 1U) { // is time event about to expire?
             QActive * const act = te->toActive();
@@ -329,16 +364,16 @@ void QTimeEvt::tick(
 #ifdef QXK_HPP_
             if (te->sig < Q_USER_SIG) {
                 QXThread::timeout_(act);
-                QF_CRIT_EXIT();
+                QF_TIME_CRIT_EXIT_(tickRate);
             }
             else {
-                QF_CRIT_EXIT(); // exit crit. section before posting
+                QF_TIME_CRIT_EXIT_(tickRate); // exit crit. section before posting
 
                 // act->POST() asserts if the queue overflows
                 act->POST(te, sender);
             }
 #else // not QXK
-            QF_CRIT_EXIT(); // exit crit. section before posting
+            QF_TIME_CRIT_EXIT_(tickRate); // exit crit. section before posting
 
             // act->POST() asserts if the queue overflows
             act->POST(te, sender);
@@ -349,11 +384,11 @@ void QTimeEvt::tick(
             te->m_ctr = ctr; // update the member original
 
             prev = te; // advance to this time event
-            QF_CRIT_EXIT(); // exit crit. section to reduce latency
+            QF_TIME_CRIT_EXIT_(tickRate); // exit crit. section to reduce latency
         }
-        QF_CRIT_ENTRY(); // re-enter crit. section to continue the loop
+        QF_TIME_CRIT_ENTRY_(tickRate); // re-enter crit. section to continue the loop
     }
-    QF_CRIT_EXIT();
+    QF_TIME_CRIT_EXIT_(tickRate);
 }
 
 //............................................................................
@@ -367,6 +402,7 @@ bool QTimeEvt::noActive(std::uint_fast8_t const tickRate) noexcept {
 
     return noActive;
 }
+#endif // ndef QF_TIMEEVT_WHEEL
 
 //............................................................................
 // private default ctor
@@ -378,8 +414,19 @@ QTimeEvt::QTimeEvt() noexcept
     m_interval(0U),    // no periodic operation
     m_tickRate(0U),    // default tick rate
     m_flags(0U)        // not armed
+#ifdef QF_TIMEEVT_WHEEL
+  , m_prev(nullptr),   // not linked into the timing wheel
+    m_when(0U)         // no expiration
+#endif
+#ifdef QF_TIMEEVT_TICKLESS
+  , m_deadline(0U),    // no deadline
+    m_period(0U),      // not periodic
+    m_heapIdx(0U)      // not in the deadline heap
+#endif
 {}
 
+#ifndef QF_TIMEEVT_WHEEL
+
 //............................................................................
 QTimeEvt *QTimeEvt::expire_(
     QTimeEvt * const prev_link,
@@ -422,6 +469,7 @@ QTimeEvt *QTimeEvt::expire_(
 
     return prev;
 }
+#endif // ndef QF_TIMEEVT_WHEEL
 
 } // namespace QP
 
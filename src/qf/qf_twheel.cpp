@@ -0,0 +1,444 @@
+//============================================================================
+// QP/C++ Real-Time Event Framework (RTEF)
+//
+// Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+//
+// This software is dual-licensed under the terms of the open-source GNU
+// General Public License (GPL) or under the terms of one of the closed-
+// source Quantum Leaps commercial licenses.
+//
+// Redistributions in source code must retain this top-level comment block.
+// Plagiarizing this software to sidestep the license obligations is illegal.
+//
+// NOTE:
+// The GPL does NOT permit the incorporation of this code into proprietary
+// programs. Please contact Quantum Leaps for commercial licensing options,
+// which expressly supersede the GPL and are designed explicitly for
+// closed-source distribution.
+//
+// Quantum Leaps contact information:
+// <www.state-machine.com/licensing>
+// <info@state-machine.com>
+//============================================================================
+#define QP_IMPL             // this is QP implementation
+#include "qp_port.hpp"      // QP port
+#include "qp_pkg.hpp"       // QP package-scope interface
+#include "qsafe.h"          // QP Functional Safety (FuSa) Subsystem
+#ifdef Q_SPY                // QS software tracing enabled?
+    #include "qs_port.hpp"  // QS port
+    #include "qs_pkg.hpp"   // QS facilities for pre-defined trace records
+#else
+    #include "qs_dummy.hpp" // disable the QS software tracing
+#endif // Q_SPY
+
+//============================================================================
+#if (QF_MAX_TICK_RATE > 0U) && defined(QF_TIMEEVT_WHEEL)
+
+// unnamed namespace for local definitions with internal linkage
+namespace {
+Q_DEFINE_THIS_MODULE("qf_twheel")
+} // unnamed namespace
+
+namespace QP {
+
+//............................................................................
+std::array<QTimeWheel, QF_MAX_TICK_RATE> QTimeWheel_;
+
+//............................................................................
+void QTimeEvt::armX(
+    std::uint32_t const nTicks,
+    std::uint32_t const interval) noexcept
+{
+    QF_CRIT_STAT
+    QF_TIME_CRIT_ENTRY_(m_tickRate);
+
+    // nTicks and interval parameters must fit in the configured dynamic range
+#if (QF_TIMEEVT_CTR_SIZE == 1U)
+    Q_REQUIRE_INCRIT(400, nTicks   < 0xFFU);
+    Q_REQUIRE_INCRIT(410, interval < 0xFFU);
+#elif (QF_TIMEEVT_CTR_SIZE == 2U)
+    Q_REQUIRE_INCRIT(400, nTicks   < 0xFFFFU);
+    Q_REQUIRE_INCRIT(410, interval < 0xFFFFU);
+#endif
+
+#ifndef Q_UNSAFE
+    QTimeEvtCtr const ctr = m_ctr;
+#endif
+
+    std::uint8_t const tickRate = m_tickRate;
+
+    // nTicks must be != 0 for arming a time event
+    Q_REQUIRE_INCRIT(440, nTicks != 0U);
+
+    // the time event must not be already armed
+    Q_REQUIRE_INCRIT(450, ctr == 0U);
+
+    // the AO associated with this time event must be valid
+    Q_REQUIRE_INCRIT(460, m_act != nullptr);
+
+    // the tick rate of this time event must be in range
+    Q_REQUIRE_INCRIT(470, tickRate < QF_MAX_TICK_RATE);
+
+    QTimeWheel &wheel = QTimeWheel_[tickRate];
+    m_ctr = static_cast<QTimeEvtCtr>(nTicks);
+    m_interval = static_cast<QTimeEvtCtr>(interval);
+#ifdef QF_TIMEEVT_TICKLESS
+    m_flags &= static_cast<std::uint8_t>(~QTE_FLAG_IS_DEADLINE);
+#endif
+    m_when = wheel.now + nTicks;
+    link_(wheel); // insert into the timing wheel, see NOTE1
+
+    QS_BEGIN_PRE(QS_QF_TIMEEVT_ARM,
+            static_cast<QActive const *>(m_act)->m_prio)
+        QS_TIME_PRE();        // timestamp
+        QS_OBJ_PRE(this);     // this time event object
+        QS_OBJ_PRE(m_act);    // the active object
+        QS_TEC_PRE(nTicks);   // the # ticks
+        QS_TEC_PRE(interval); // the interval
+        QS_U8_PRE(tickRate);  // tick rate
+    QS_END_PRE()
+
+    QF_TIME_CRIT_EXIT_(m_tickRate);
+}
+
+//............................................................................
+bool QTimeEvt::disarm() noexcept {
+    QF_CRIT_STAT
+    QF_TIME_CRIT_ENTRY_(m_tickRate);
+
+    QTimeEvtCtr const ctr = m_ctr; // get member into temporary
+
+#ifdef Q_SPY
+    std::uint_fast8_t const qsId = static_cast<QActive *>(m_act)->m_prio;
+#endif
+
+    // was the time event actually armed?
+    bool wasArmed = false;
+    if (ctr != 0U) {
+        wasArmed = true;
+        m_flags |= QTE_FLAG_WAS_DISARMED;
+        m_ctr = 0U;
+        if ((m_flags & QTE_FLAG_IS_LINKED) != 0U) { // not a deadline?
+            unlink_(QTimeWheel_[m_tickRate]); // remove from the wheel in O(1)
+        }
+
+        QS_BEGIN_PRE(QS_QF_TIMEEVT_DISARM, qsId)
+            QS_TIME_PRE();            // timestamp
+            QS_OBJ_PRE(this);         // this time event object
+            QS_OBJ_PRE(m_act);        // the target AO
+            QS_TEC_PRE(ctr);          // the # ticks
+            QS_TEC_PRE(m_interval);   // the interval
+            QS_U8_PRE(m_tickRate);    // tick rate
+        QS_END_PRE()
+    }
+    else { // the time event was already disarmed automatically
+        m_flags &= static_cast<std::uint8_t>(~QTE_FLAG_WAS_DISARMED);
+
+        QS_BEGIN_PRE(QS_QF_TIMEEVT_DISARM_ATTEMPT, qsId)
+            QS_TIME_PRE();            // timestamp
+            QS_OBJ_PRE(this);         // this time event object
+            QS_OBJ_PRE(m_act);        // the target AO
+            QS_U8_PRE(m_tickRate);    // tick rate
+        QS_END_PRE()
+    }
+
+    QF_TIME_CRIT_EXIT_(m_tickRate);
+
+    return wasArmed;
+}
+
+//............................................................................
+bool QTimeEvt::rearm(std::uint32_t const nTicks) noexcept {
+    QF_CRIT_STAT
+    QF_TIME_CRIT_ENTRY_(m_tickRate);
+
+    // nTicks parameter must fit in the configured dynamic range
+#if (QF_TIMEEVT_CTR_SIZE == 1U)
+    Q_REQUIRE_INCRIT(600, nTicks < 0xFFU);
+#elif (QF_TIMEEVT_CTR_SIZE == 2U)
+    Q_REQUIRE_INCRIT(600, nTicks < 0xFFFFU);
+#endif
+
+    std::uint8_t const tickRate = m_tickRate;
+    QTimeEvtCtr const ctr = m_ctr;
+
+    // nTicks must be != 0 for arming a time event
+    Q_REQUIRE_INCRIT(610, nTicks != 0U);
+
+    // the AO associated with this time event must be valid
+    Q_REQUIRE_INCRIT(620, m_act != nullptr);
+
+    // the tick rate of this time event must be in range
+    Q_REQUIRE_INCRIT(630, tickRate < QF_MAX_TICK_RATE);
+
+#ifdef Q_SPY
+    std::uint_fast8_t const qsId = static_cast<QActive *>(m_act)->m_prio;
+#endif
+
+    QTimeWheel &wheel = QTimeWheel_[tickRate];
+
+    // was the time evt running?
+    bool wasArmed = false;
+    if (ctr != 0U) {
+        wasArmed = true;
+        if ((m_flags & QTE_FLAG_IS_LINKED) != 0U) { // not a deadline?
+            unlink_(wheel); // remove from the old slot in O(1)
+        }
+    }
+#ifdef QF_TIMEEVT_TICKLESS
+    m_flags &= static_cast<std::uint8_t>(~QTE_FLAG_IS_DEADLINE);
+#endif
+    m_ctr = static_cast<QTimeEvtCtr>(nTicks);
+    m_when = wheel.now + nTicks;
+    link_(wheel); // insert into the new slot
+
+    QS_BEGIN_PRE(QS_QF_TIMEEVT_REARM, qsId)
+        QS_TIME_PRE();            // timestamp
+        QS_OBJ_PRE(this);         // this time event object
+        QS_OBJ_PRE(m_act);        // the target AO
+        QS_TEC_PRE(nTicks);       // the # ticks
+        QS_TEC_PRE(m_interval);   // the interval
+        QS_2U8_PRE(tickRate, (wasArmed ? 1U : 0U));
+    QS_END_PRE()
+
+    QF_TIME_CRIT_EXIT_(m_tickRate);
+
+    return wasArmed;
+}
+
+//............................................................................
+QTimeEvtCtr QTimeEvt::getCtr() const noexcept {
+    // NOTE: this function does NOT apply critical section, so it can
+    // be safely called from an already established critical section.
+    QTimeEvtCtr ctr = 0U;
+#ifdef QF_TIMEEVT_TICKLESS
+    if ((m_flags & QTE_FLAG_IS_DEADLINE) != 0U) { // not in the wheel?
+        ctr = m_ctr;
+    }
+    else
+#endif
+    if (m_ctr != 0U) { // armed?
+        std::uint32_t const left = m_when - QTimeWheel_[m_tickRate].now;
+        // a time event expiring in the current tick is still armed
+        ctr = (left != 0U) ? static_cast<QTimeEvtCtr>(left) : 1U;
+    }
+    return ctr;
+}
+
+//............................................................................
+void QTimeEvt::tick(
+    std::uint_fast8_t const tickRate,
+    void const * const sender) noexcept
+{
+#ifndef Q_SPY
+    Q_UNUSED_PAR(sender);
+#endif
+
+    QF_CRIT_STAT
+    QF_TIME_CRIT_ENTRY_(tickRate);
+
+    // the tick rate of this time event must be in range
+    Q_REQUIRE_INCRIT(800, tickRate < QF_MAX_TICK_RATE);
+
+    QTimeWheel &wheel = QTimeWheel_[tickRate];
+
+    // the previous tick must have been fully processed
+    Q_REQUIRE_INCRIT(810,
+        (wheel.cascade == nullptr) && (wheel.expiring == nullptr));
+
+    std::uint32_t const now = wheel.now + 1U;
+    wheel.now = now;
+
+    QS_BEGIN_PRE(QS_QF_TICK, 0U)
+        QS_TEC_PRE(now);      // tick ctr
+        QS_U8_PRE(tickRate);  // tick rate
+    QS_END_PRE()
+
+    // cascade the higher-level slots that the current tick has reached...
+    for (std::uint_fast8_t level = 1U; level < QTE_WHEEL_LEVELS; ++level) {
+        std::uint_fast8_t const shift =
+            static_cast<std::uint_fast8_t>(level * QTE_WHEEL_BITS);
+        if ((now & ((static_cast<std::uint32_t>(1U) << shift) - 1U)) != 0U) {
+            break; // the lower-level wheel did not wrap around
+        }
+
+        // detach the whole slot, see NOTE2
+        QTimeEvt *&slot =
+            wheel.slot[level][(now >> shift) & (QTE_WHEEL_SLOTS - 1U)];
+        wheel.cascade = slot;
+        slot = nullptr;
+        if (wheel.cascade != nullptr) {
+            wheel.cascade->m_prev = &wheel.cascade;
+        }
+
+        for (;;) {
+            QTimeEvt * const te = wheel.cascade;
+            if (te == nullptr) { // end of the list?
+                break;
+            }
+            // re-insert into the lower levels (never into the same slot)
+            te->unlink_(wheel);
+            te->link_(wheel);
+
+            QF_TIME_CRIT_EXIT_(tickRate); // exit crit. section to reduce latency
+            QF_TIME_CRIT_ENTRY_(tickRate); // re-enter crit. section to continue
+        }
+    }
+
+    // detach the slot of time events expiring in this tick, see NOTE2
+    QTimeEvt *&slot = wheel.slot[0][now & (QTE_WHEEL_SLOTS - 1U)];
+    wheel.expiring = slot;
+    slot = nullptr;
+    if (wheel.expiring != nullptr) {
+        wheel.expiring->m_prev = &wheel.expiring;
+    }
+
+    // post all the expiring time events...
+    for (;;) {
+        QTimeEvt * const te = wheel.expiring;
+        if (te == nullptr) { // end of the list?
+            break;
+        }
+        te->unlink_(wheel);
+
+        QActive * const act = te->toActive();
+        if (te->m_interval != 0U) { // periodic time evt?
+            te->m_ctr = te->m_interval; // rearm the time event
+            te->m_when = now + te->m_interval;
+            te->link_(wheel);
+        }
+        else { // one-shot time event: automatically disarm
+            te->m_ctr = 0U;
+
+            QS_BEGIN_PRE(QS_QF_TIMEEVT_AUTO_DISARM, act->m_prio)
+                QS_OBJ_PRE(te);       // this time event object
+                QS_OBJ_PRE(act);      // the target AO
+                QS_U8_PRE(tickRate);  // tick rate
+            QS_END_PRE()
+        }
+
+        QS_BEGIN_PRE(QS_QF_TIMEEVT_POST, act->m_prio)
+            QS_TIME_PRE();            // timestamp
+            QS_OBJ_PRE(te);           // the time event object
+            QS_SIG_PRE(te->sig);      // signal of this time event
+            QS_OBJ_PRE(act);          // the target AO
+            QS_U8_PRE(tickRate);      // tick rate
+        QS_END_PRE()
+
+#ifdef QXK_HPP_
+        if (te->sig < Q_USER_SIG) {
+            QXThread::timeout_(act);
+            QF_TIME_CRIT_EXIT_(tickRate);
+        }
+        else {
+            QF_TIME_CRIT_EXIT_(tickRate); // exit crit. section before posting
+
+            // act->POST() asserts if the queue overflows
+            act->POST(te, sender);
+        }
+#else // not QXK
+        QF_TIME_CRIT_EXIT_(tickRate); // exit crit. section before posting
+
+        // act->POST() asserts if the queue overflows
+        act->POST(te, sender);
+#endif
+        QF_TIME_CRIT_ENTRY_(tickRate); // re-enter crit. section to continue
+    }
+    QF_TIME_CRIT_EXIT_(tickRate);
+}
+
+//............................................................................
+bool QTimeEvt::noActive(std::uint_fast8_t const tickRate) noexcept {
+    // NOTE: this function must be called *inside* critical section
+    Q_REQUIRE_INCRIT(900, tickRate < QF_MAX_TICK_RATE);
+
+    return QTimeWheel_[tickRate].nLinked == 0U;
+}
+
+//............................................................................
+void QTimeEvt::link_(QTimeWheel &wheel) noexcept {
+    // NOTE: this helper function is called *inside* critical section
+
+    // find the lowest level that covers the remaining ticks
+    std::uint32_t const delta = m_when - wheel.now;
+    std::uint_fast8_t level = 0U;
+    while ((level < (QTE_WHEEL_LEVELS - 1U))
+           && ((delta >> ((level + 1U) * QTE_WHEEL_BITS)) != 0U))
+    {
+        ++level;
+    }
+
+    QTimeEvt **head = &wheel.slot[level][
+        (m_when >> (level * QTE_WHEEL_BITS)) & (QTE_WHEEL_SLOTS - 1U)];
+
+    // insert at the front of the slot list
+    m_next = *head;
+    if (m_next != nullptr) {
+        m_next->m_prev = &m_next;
+    }
+    m_prev = head;
+    *head = this;
+
+    m_flags |= QTE_FLAG_IS_LINKED; // mark as linked
+    ++wheel.nLinked;
+}
+
+//............................................................................
+void QTimeEvt::unlink_(QTimeWheel &wheel) noexcept {
+    // NOTE: this helper function is called *inside* critical section
+    Q_ASSERT_INCRIT(950, (m_flags & QTE_FLAG_IS_LINKED) != 0U);
+
+    *m_prev = m_next;
+    if (m_next != nullptr) {
+        m_next->m_prev = m_prev;
+    }
+    m_next = nullptr;
+    m_prev = nullptr;
+
+    // mark this time event as NOT linked
+    m_flags &= static_cast<std::uint8_t>(~QTE_FLAG_IS_LINKED);
+    --wheel.nLinked;
+}
+
+} // namespace QP
+
+#endif // (QF_MAX_TICK_RATE > 0U) && defined(QF_TIMEEVT_WHEEL)
+
+//============================================================================
+// NOTE1:
+// The hierarchical timing wheel (QF_TIMEEVT_WHEEL) replaces the linked list
+// of all armed time events, which QTimeEvt::tick() needs to walk in every
+// clock tick. Instead, every armed time event remembers the absolute tick
+// count of its expiration (m_when) and is linked into a doubly-linked list
+// of one of the wheel slots. The wheel has one level of QTE_WHEEL_SLOTS
+// slots per byte of the QTimeEvtCtr dynamic range. QTimeEvt::link_()
+// chooses the level by the size of the remaining delta (m_when - now): the
+// lowest level L for which the delta is below QTE_WHEEL_SLOTS^(L+1) ticks.
+// Within that level, the slot is selected by the byte L of m_when. When
+// the lower levels wrap around, QTimeEvt::tick() cascades the slot of the
+// higher level reached by the current tick count, i.e., re-links its time
+// events according to their (now smaller) remaining delta.
+// Arming, disarming and rearming are therefore O(1) and QTimeEvt::tick()
+// visits only the time events expiring in the given tick, plus the events
+// cascaded to the lower levels, each of which happens at most once per
+// level over the lifetime of the armed time event.
+//
+// Unlike the linked list, the time events are unlinked immediately when
+// they are disarmed, so the memory of a disarmed time event can be reused
+// right away. The QTimeEvt::wasDisarmed() semantics, periodic intervals
+// and the order of the QS trace records remain the same.
+//
+// NOTE2:
+// QTimeEvt::tick() exits the critical section between the individual time
+// events to reduce the latency, so the list of the time events being
+// processed is first detached from the wheel and is anchored in the
+// QTimeWheel object. This way, a concurrent QTimeEvt::disarm() or
+// QTimeEvt::rearm() can still unlink the time event in O(1), while freshly
+// armed time events go into the wheel and cannot be processed twice.
+//
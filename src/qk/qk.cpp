@@ -243,7 +243,7 @@ void QK::activate_() {
         QF_INT_ENABLE(); // unconditionally enable interrupts
 
         QEvt const * const e = a->get_(); // queue not empty
-        a->dispatch(e, p); // virtual call
+        a->dispatch_(&e, 1U); // virtual or static, NOTE2 in qf_qact.cpp
 #if (QF_MAX_EPOOL > 0U)
         QF::gc(e); // check if the event is garbage, and collect it if so
 #endif
@@ -87,7 +87,7 @@ int_t run() {
 #endif
 
 #if (defined QF_ON_CONTEXT_SW) || (defined Q_SPY)
-    std::uint_fast8_t pprev = 0U; // previous prio.
+    QPrio pprev = 0U; // previous prio.
 
 #ifdef QF_ON_CONTEXT_SW
     // officially switch to the idle cotext
@@ -104,7 +104,7 @@ int_t run() {
     for (;;) { // QV event-loop...
         if (QV::priv_.readySet.notEmpty()) { // any AOs ready to run?
             // find the maximum prio. AO ready to run
-            std::uint_fast8_t const p = QV::priv_.readySet.findMax();
+            QPrio const p = static_cast<QPrio>(QV::priv_.readySet.findMax());
             QActive * const a = QActive_registry_[p];
 
 #if (defined QF_ON_CONTEXT_SW) || (defined Q_SPY)
@@ -128,11 +128,21 @@ int_t run() {
 
             QF_INT_ENABLE();
 
+#ifndef QF_DISPATCH_QUOTA
             QEvt const * const e = a->get_(); // queue not empty
-            a->dispatch(e, p); // virtual call
+            a->dispatch_(&e, 1U); // virtual or static, NOTE2 in qf_qact.cpp
 #if (QF_MAX_EPOOL > 0U)
             QF::gc(e); // check if the event is garbage, and collect it if so
 #endif
+#else // drain up to QF_DISPATCH_QUOTA events (NOTE1 in qf_actq.cpp)
+            QEvt const *evts[QF_DISPATCH_QUOTA];
+            std::uint_fast16_t const n =
+                a->getBatch_(&evts[0], QF_DISPATCH_QUOTA); // queue not empty
+            a->dispatch_(&evts[0], n); // the whole batch
+#if (QF_MAX_EPOOL > 0U)
+            QF::gcBatch_(&evts[0], n); // collect the garbage events
+#endif
+#endif // QF_DISPATCH_QUOTA
             QF_INT_DISABLE();
 
             if (a->m_eQueue.isEmpty()) { // empty queue?
@@ -189,7 +199,7 @@ void QActive::start(
     Q_REQUIRE_INCRIT(310, stkSto == nullptr);
     QF_CRIT_EXIT();
 
-    m_prio  = static_cast<std::uint8_t>(prioSpec & 0xFFU); // QF-prio.
+    m_prio  = static_cast<QPrio>(prioSpec); // QF-prio. (low part of prioSpec)
     m_pthre = 0U; // not used
     register_(); // make QF aware of this AO
 
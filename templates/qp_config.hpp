@@ -65,6 +65,13 @@
 // <i>Default: 3
 #define QF_MAX_EPOOL 3U
 
+// <o>Size-class lookup table for event pools (QF_EPOOL_LUT_SIZE) <1-1024>
+// <i>Constant-time event-pool lookup for event sizes up to
+// <i>QF_EPOOL_LUT_SIZE*QF_EPOOL_LUT_GRANULE bytes (for many event pools).
+// <i>Undefined means linear search of the event pools.
+//#define QF_EPOOL_LUT_SIZE 64U
+//#define QF_EPOOL_LUT_GRANULE 4U
+
 // <o>Maximum # clock tick rates (QF_MAX_TICK_RATE)
 // <0=>0 no time events
 // <1=>1 (default) <2=>2 <3=>3 <4=>4 <5=>5
@@ -119,6 +126,57 @@
 //#define QEVT_PAR_INIT
 // </c>
 
+// <c1>Use atomic event reference counters (QEVT_REFCTR_ATOMIC)
+// <i>Lock-free reference counting of mutable events for multi-core ports
+// <i>NOTE: requires the C++11 std::atomic<> support for the target
+//#define QEVT_REFCTR_ATOMIC
+// </c>
+
+// <o>Events dispatched per scheduling decision (QF_DISPATCH_QUOTA) <1-255>
+// <i>Batch of events removed from the AO queue at once and dispatched
+// <i>back to back (QV kernel only). Undefined means one event at a time.
+//#define QF_DISPATCH_QUOTA 8U
+
+// <c1>Dispatch events to AOs without virtual calls (QACTIVE_STATIC_DISPATCH)
+// <i>Kernels call a per-AO dispatch handler, which is bound statically
+// <i>(and can be inlined) for AOs derived from QTActive<> or QActiveCRTP<>
+// <i>(the latter only for AOs that define their own inline dispatch())
+//#define QACTIVE_STATIC_DISPATCH
+// </c>
+
+// <c1>Use hierarchical timing wheel for time events (QF_TIMEEVT_WHEEL)
+// <i>O(1) arming/disarming and clock tick processing proportional
+// <i>only to the expiring time events (for many armed time events)
+// <i>NOTE: requires more RAM (256 pointers per byte of QTimeEvtCtr)
+//#define QF_TIMEEVT_WHEEL
+// </c>
+
+// <c1>Enable transition-path cache for QHsm (QHSM_TRAN_CACHE)
+// <i>QHsm subclasses can provide a per-instance QTranCache (tranCache())
+// <i>to avoid re-discovering the transition paths in deep hierarchies
+//#define QHSM_TRAN_CACHE
+// </c>
+
+// <o>Registry of per-state signal tables for QHsm (QHSM_SIG_TABLES) <2-1024>
+// <i>States registered with addSigTable() (per SM) handle events by direct
+// <i>table look-up and skip superstates not handling the signal
+// <i>Undefined means no signal tables.
+//#define QHSM_SIG_TABLES 32U
+
+// <c1>Cache the active state configuration (QASM_ACTIVE_CONFIG)
+// <i>isIn() and childState() look up the states active after the last
+// <i>transition instead of calling the state handlers (QHsm and QMsm)
+// <i>NOTE: only in SMs that override activeConfig() (7 words of RAM each)
+//#define QASM_ACTIVE_CONFIG
+// </c>
+
+// <c1>Snapshot and restore of active objects (QACTIVE_SNAPSHOT)
+// <i>QActive::snapshot() saves the state, the extended state, the queued
+// <i>events and the time events of an AO in a binary blob, which
+// <i>QActive::restore() applies after a restart of the same executable
+//#define QACTIVE_SNAPSHOT
+// </c>
+
 // <c1>Provide destructors for QP classes
 // <i>Presence of destructors pulls in the C++ delete() opeator
 // <i>NOTE: Not recommended